@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pager.h"
+#include "util.h"
+
+/*
+ * Micro-benchmark for buffer pool lookups.  Every page of the table file is
+ * resident, so each pin is a pure page table hit - latency should stay flat
+ * as the pool grows.
+ *
+ * The scan benchmark reads a file much larger than the pool with read-only pins,
+ * comparing pread into frame buffers against mmap views.
+ */
+
+#define VDB_BENCH_PINS 4000000
+#define VDB_BENCH_SCAN_PAGES 65536
+#define VDB_BENCH_SCAN_POOL 1024
+#define VDB_BENCH_SCAN_PASSES 4
+
+static double vdbbench_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint32_t vdbbench_xorshift(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static double vdbbench_pin_latency(uint32_t pool_pages) {
+    FILE* tmp = tmpfile();
+    if (!tmp)
+        err_quit("tmpfile failed");
+    int fd = fileno_w(tmp);
+
+    struct VdbPager* pager = vdbpager_init((uint64_t)pool_pages * VDB_DEFAULT_PAGE_SIZE, VDBEP_CLOCK, false, VDB_DEFAULT_DIRTY_WATERMARK);
+    vdbpager_create_file(pager, fd, VDB_DEFAULT_PAGE_SIZE);
+    if (ftruncate(fd, (off_t)pool_pages * VDB_DEFAULT_PAGE_SIZE) == -1)
+        err_quit("ftruncate failed");
+
+    //warm up pool so every page is resident
+    for (uint32_t i = 0; i < pool_pages; i++) {
+        vdbpager_unpin_page(pager, vdbpager_pin_page(pager, fd, i), false);
+    }
+
+    uint32_t state = 2463534242u;
+    double start = vdbbench_now_ns();
+    for (uint32_t i = 0; i < VDB_BENCH_PINS; i++) {
+        uint32_t idx = vdbbench_xorshift(&state) % pool_pages;
+        struct VdbPage* page = vdbpager_pin_page(pager, fd, idx);
+        vdbpager_unpin_page(pager, page, false);
+    }
+    double elapsed = vdbbench_now_ns() - start;
+
+    vdbpager_close_file(pager, fd);
+    vdbpager_free(pager);
+    fclose_w(tmp);
+
+    return elapsed / VDB_BENCH_PINS;
+}
+
+static double vdbbench_scan_latency(bool mmap_reads) {
+    FILE* tmp = tmpfile();
+    if (!tmp)
+        err_quit("tmpfile failed");
+    int fd = fileno_w(tmp);
+
+    struct VdbPager* pager = vdbpager_init((uint64_t)VDB_BENCH_SCAN_POOL * VDB_DEFAULT_PAGE_SIZE, VDBEP_CLOCK, mmap_reads, VDB_DEFAULT_DIRTY_WATERMARK);
+    vdbpager_create_file(pager, fd, VDB_DEFAULT_PAGE_SIZE);
+    if (ftruncate(fd, (off_t)VDB_BENCH_SCAN_PAGES * VDB_DEFAULT_PAGE_SIZE) == -1)
+        err_quit("ftruncate failed");
+
+    uint64_t sum = 0;
+    double start = vdbbench_now_ns();
+    for (uint32_t pass = 0; pass < VDB_BENCH_SCAN_PASSES; pass++) {
+        for (uint32_t i = 1; i < VDB_BENCH_SCAN_PAGES; i++) {
+            struct VdbPage* page = vdbpager_pin_page_readonly(pager, fd, i);
+            sum += page->buf[i % VDB_DEFAULT_PAGE_SIZE];
+            vdbpager_unpin_page(pager, page, false);
+        }
+    }
+    double elapsed = vdbbench_now_ns() - start;
+
+    vdbpager_close_file(pager, fd);
+    vdbpager_free(pager);
+    fclose_w(tmp);
+
+    if (sum != 0)
+        err_quit("unexpected page contents");
+
+    return elapsed / ((double)VDB_BENCH_SCAN_PASSES * (VDB_BENCH_SCAN_PAGES - 1));
+}
+
+int main() {
+    uint32_t sizes[] = { 8, 64, 1024, 16384, 65536, 262144 };
+
+    printf("%-12s %-12s\n", "pool pages", "ns/pin");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(uint32_t); i++) {
+        printf("%-12u %-12.1f\n", sizes[i], vdbbench_pin_latency(sizes[i]));
+    }
+
+    printf("\n%-12s %-12s\n", "scan", "ns/page");
+    printf("%-12s %-12.1f\n", "pread", vdbbench_scan_latency(false));
+    printf("%-12s %-12.1f\n", "mmap", vdbbench_scan_latency(true));
+
+    return 0;
+}
@@ -0,0 +1,293 @@
+#include <assert.h>
+#include <string.h>
+
+#include "batch.h"
+
+#define VDB_CMP_LESS 1
+#define VDB_CMP_EQUAL 2
+#define VDB_CMP_GREATER 4
+
+
+static struct VdbPredicate* vdbpredicate_init(enum VdbPredicateType type) {
+    struct VdbPredicate* p = malloc_w(sizeof(struct VdbPredicate));
+    p->type = type;
+    p->left = NULL;
+    p->right = NULL;
+    p->col = 0;
+    p->op = VDBT_EQUALS;
+    p->value.type = VDBT_TYPE_NULL;
+    return p;
+}
+
+void vdbpredicate_free(struct VdbPredicate* p) {
+    if (p->left) vdbpredicate_free(p->left);
+    if (p->right) vdbpredicate_free(p->right);
+    free_w(p, sizeof(struct VdbPredicate));
+}
+
+//int, float and bool literals, including negated numbers
+static bool vdbpredicate_constant(struct VdbExpr* expr, struct VdbValue* value) {
+    if (expr->type == VDBET_UNARY && expr->as.unary.op.type == VDBT_MINUS) {
+        if (!vdbpredicate_constant(expr->as.unary.right, value))
+            return false;
+
+        if (value->type == VDBT_TYPE_INT8) {
+            value->as.Int = -value->as.Int;
+            return true;
+        } else if (value->type == VDBT_TYPE_FLOAT8) {
+            value->as.Float = -value->as.Float;
+            return true;
+        }
+        return false;
+    }
+
+    if (expr->type != VDBET_LITERAL)
+        return false;
+
+    switch (expr->as.literal.token.type) {
+        case VDBT_INT:
+        case VDBT_FLOAT:
+        case VDBT_TRUE:
+        case VDBT_FALSE:
+            *value = vdbexpr_eval_literal(expr->as.literal.token);
+            return true;
+        default:
+            return false;
+    }
+}
+
+//same comparison with the sides swapped
+static enum VdbTokenType vdbpredicate_flip(enum VdbTokenType op) {
+    switch (op) {
+        case VDBT_LESS: return VDBT_GREATER;
+        case VDBT_LESS_EQUALS: return VDBT_GREATER_EQUALS;
+        case VDBT_GREATER: return VDBT_LESS;
+        case VDBT_GREATER_EQUALS: return VDBT_LESS_EQUALS;
+        default: return op;
+    }
+}
+
+static struct VdbPredicate* vdbpredicate_compile_compare(struct VdbExpr* expr, struct VdbSchema* schema) {
+    struct VdbExpr* left = expr->as.binary.left;
+    struct VdbExpr* right = expr->as.binary.right;
+    enum VdbTokenType op = expr->as.binary.op.type;
+
+    if (left->type != VDBET_IDENTIFIER) {
+        struct VdbExpr* tmp = left;
+        left = right;
+        right = tmp;
+        op = vdbpredicate_flip(op);
+    }
+
+    if (left->type != VDBET_IDENTIFIER)
+        return NULL;
+
+    uint32_t col = vdbexpr_identifier_col(left->as.identifier.token, schema);
+    struct VdbValue value;
+    if (col >= schema->count || !vdbpredicate_constant(right, &value))
+        return NULL;
+
+    //a different type is an error when evaluated a record at a time, and bools are only checked for equality
+    if (value.type != schema->types[col])
+        return NULL;
+    if (value.type == VDBT_TYPE_BOOL && op != VDBT_EQUALS && op != VDBT_NOT_EQUALS)
+        return NULL;
+
+    struct VdbPredicate* p = vdbpredicate_init(VDBPT_COMPARE);
+    p->col = col;
+    p->op = op;
+    p->value = value;
+    return p;
+}
+
+//predicate that gives the same records as the expression, or NULL if it can't be filtered in batches
+struct VdbPredicate* vdbpredicate_compile(struct VdbExpr* expr, struct VdbSchema* schema) {
+    switch (expr->type) {
+        case VDBET_BINARY: {
+            switch (expr->as.binary.op.type) {
+                //nulls fail a 'where' clause the same as false, and without 'not' they can't turn true again
+                case VDBT_AND:
+                case VDBT_OR: {
+                    struct VdbPredicate* left = vdbpredicate_compile(expr->as.binary.left, schema);
+                    if (!left)
+                        return NULL;
+
+                    struct VdbPredicate* right = vdbpredicate_compile(expr->as.binary.right, schema);
+                    if (!right) {
+                        vdbpredicate_free(left);
+                        return NULL;
+                    }
+
+                    struct VdbPredicate* p = vdbpredicate_init(expr->as.binary.op.type == VDBT_AND ? VDBPT_AND : VDBPT_OR);
+                    p->left = left;
+                    p->right = right;
+                    return p;
+                }
+                case VDBT_EQUALS:
+                case VDBT_NOT_EQUALS:
+                case VDBT_LESS:
+                case VDBT_LESS_EQUALS:
+                case VDBT_GREATER:
+                case VDBT_GREATER_EQUALS:
+                    return vdbpredicate_compile_compare(expr, schema);
+                default:
+                    return NULL;
+            }
+        }
+        case VDBET_IS_NULL:
+        case VDBET_IS_NOT_NULL: {
+            struct VdbExpr* left = expr->type == VDBET_IS_NULL ? expr->as.is_null.left : expr->as.is_not_null.left;
+            if (left->type != VDBET_IDENTIFIER)
+                return NULL;
+
+            uint32_t col = vdbexpr_identifier_col(left->as.identifier.token, schema);
+            if (col >= schema->count)
+                return NULL;
+
+            struct VdbPredicate* p = vdbpredicate_init(expr->type == VDBET_IS_NULL ? VDBPT_IS_NULL : VDBPT_IS_NOT_NULL);
+            p->col = col;
+            return p;
+        }
+        default:
+            return NULL;
+    }
+}
+
+//columns a batch needs to read, which are always the leading ones
+uint32_t vdbpredicate_col_count(struct VdbPredicate* p) {
+    switch (p->type) {
+        case VDBPT_AND:
+        case VDBPT_OR: {
+            uint32_t left = vdbpredicate_col_count(p->left);
+            uint32_t right = vdbpredicate_col_count(p->right);
+            return left > right ? left : right;
+        }
+        default:
+            return p->col + 1;
+    }
+}
+
+//comparison results that pass an operator
+static uint8_t vdbpredicate_accepts(enum VdbTokenType op) {
+    switch (op) {
+        case VDBT_EQUALS: return VDB_CMP_EQUAL;
+        case VDBT_NOT_EQUALS: return VDB_CMP_LESS | VDB_CMP_GREATER;
+        case VDBT_LESS: return VDB_CMP_LESS;
+        case VDBT_LESS_EQUALS: return VDB_CMP_LESS | VDB_CMP_EQUAL;
+        case VDBT_GREATER: return VDB_CMP_GREATER;
+        case VDBT_GREATER_EQUALS: return VDB_CMP_GREATER | VDB_CMP_EQUAL;
+        default: assert(false && "invalid comparison operator"); return 0;
+    }
+}
+
+//copies a column out of the batch so the comparisons below are simple loops the compiler can vectorize
+static void vdbpredicate_eval_compare(struct VdbPredicate* p, struct VdbBatch* batch, uint8_t* out) {
+    uint32_t count = batch->count;
+    uint32_t stride = batch->col_count;
+    struct VdbValue* values = batch->values + p->col;
+
+    uint8_t accepts = vdbpredicate_accepts(p->op);
+    uint8_t lt = (accepts & VDB_CMP_LESS) != 0;
+    uint8_t eq = (accepts & VDB_CMP_EQUAL) != 0;
+    uint8_t gt = (accepts & VDB_CMP_GREATER) != 0;
+
+    uint8_t valid[VDB_BATCH_SIZE];
+    for (uint32_t i = 0; i < count; i++) {
+        valid[i] = values[i * stride].type != VDBT_TYPE_NULL;
+    }
+
+    switch (p->value.type) {
+        case VDBT_TYPE_INT8: {
+            int64_t col[VDB_BATCH_SIZE];
+            for (uint32_t i = 0; i < count; i++) {
+                col[i] = valid[i] ? values[i * stride].as.Int : 0;
+            }
+
+            int64_t k = p->value.as.Int;
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = valid[i] & ((lt & (col[i] < k)) | (eq & (col[i] == k)) | (gt & (col[i] > k)));
+            }
+            break;
+        }
+        case VDBT_TYPE_FLOAT8: {
+            double col[VDB_BATCH_SIZE];
+            for (uint32_t i = 0; i < count; i++) {
+                col[i] = valid[i] ? values[i * stride].as.Float : 0.0;
+            }
+
+            double k = p->value.as.Float;
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = valid[i] & ((lt & (col[i] < k)) | (eq & (col[i] == k)) | (gt & (col[i] > k)));
+            }
+            break;
+        }
+        case VDBT_TYPE_BOOL: {
+            uint8_t col[VDB_BATCH_SIZE];
+            for (uint32_t i = 0; i < count; i++) {
+                col[i] = valid[i] ? values[i * stride].as.Bool : 0;
+            }
+
+            uint8_t k = p->value.as.Bool;
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = valid[i] & ((eq & (col[i] == k)) | ((lt | gt) & (col[i] != k)));
+            }
+            break;
+        }
+        default:
+            assert(false && "invalid predicate type");
+            break;
+    }
+}
+
+//sets out[i] to 1 for the records in the batch that pass, and 0 for the rest
+void vdbpredicate_eval(struct VdbPredicate* p, struct VdbBatch* batch, uint8_t* out) {
+    uint32_t count = batch->count;
+
+    switch (p->type) {
+        case VDBPT_AND:
+        case VDBPT_OR: {
+            uint8_t right[VDB_BATCH_SIZE];
+            vdbpredicate_eval(p->left, batch, out);
+            vdbpredicate_eval(p->right, batch, right);
+            if (p->type == VDBPT_AND) {
+                for (uint32_t i = 0; i < count; i++) {
+                    out[i] &= right[i];
+                }
+            } else {
+                for (uint32_t i = 0; i < count; i++) {
+                    out[i] |= right[i];
+                }
+            }
+            break;
+        }
+        case VDBPT_COMPARE:
+            vdbpredicate_eval_compare(p, batch, out);
+            break;
+        case VDBPT_IS_NULL:
+        case VDBPT_IS_NOT_NULL: {
+            struct VdbValue* values = batch->values + p->col;
+            uint8_t want_null = p->type == VDBPT_IS_NULL;
+            for (uint32_t i = 0; i < count; i++) {
+                out[i] = (values[i * batch->col_count].type == VDBT_TYPE_NULL) == want_null;
+            }
+            break;
+        }
+        default:
+            assert(false && "invalid predicate type");
+            break;
+    }
+}
+
+struct VdbBatch* vdbbatch_init(uint32_t col_count) {
+    struct VdbBatch* batch = malloc_w(sizeof(struct VdbBatch));
+    batch->col_count = col_count;
+    batch->count = 0;
+    batch->next = 0;
+    batch->values = malloc_w(sizeof(struct VdbValue) * col_count * VDB_BATCH_SIZE);
+    return batch;
+}
+
+void vdbbatch_free(struct VdbBatch* batch) {
+    free_w(batch->values, sizeof(struct VdbValue) * batch->col_count * VDB_BATCH_SIZE);
+    free_w(batch, sizeof(struct VdbBatch));
+}
@@ -0,0 +1,55 @@
+#ifndef VDB_BATCH_H
+#define VDB_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "parser.h"
+#include "schema.h"
+
+#define VDB_BATCH_SIZE 1024 //records a batch scan reads and filters together
+
+/*
+ * Batch filtering - a scan reads the columns a 'where' clause uses for up to VDB_BATCH_SIZE records
+ * at a time, and each comparison runs as one typed loop over a column of them.  Only records that
+ * pass are built.  Clauses comparing int, float or bool columns with literals, joined by 'and' and
+ * 'or', can be filtered this way - anything else is evaluated one record at a time
+ */
+
+enum VdbPredicateType {
+    VDBPT_AND,
+    VDBPT_OR,
+    VDBPT_COMPARE,
+    VDBPT_IS_NULL,
+    VDBPT_IS_NOT_NULL
+};
+
+struct VdbPredicate {
+    enum VdbPredicateType type;
+    struct VdbPredicate* left;
+    struct VdbPredicate* right;
+    uint32_t col;
+    enum VdbTokenType op; //comparison with the column on the left
+    struct VdbValue value;
+};
+
+//positions of records read by a batch scan, and the values of their first col_count columns
+struct VdbBatch {
+    uint32_t col_count;
+    uint32_t count;
+    uint32_t next; //next record handed out
+    uint32_t leaf_idxs[VDB_BATCH_SIZE];
+    uint32_t rec_idxs[VDB_BATCH_SIZE];
+    uint8_t selected[VDB_BATCH_SIZE];
+    struct VdbValue* values; //col_count values for each record
+};
+
+struct VdbPredicate* vdbpredicate_compile(struct VdbExpr* expr, struct VdbSchema* schema);
+void vdbpredicate_free(struct VdbPredicate* p);
+uint32_t vdbpredicate_col_count(struct VdbPredicate* p);
+void vdbpredicate_eval(struct VdbPredicate* p, struct VdbBatch* batch, uint8_t* out);
+
+struct VdbBatch* vdbbatch_init(uint32_t col_count);
+void vdbbatch_free(struct VdbBatch* batch);
+
+#endif //VDB_BATCH_H
@@ -10,53 +10,162 @@ struct VdbCursor* vdbcursor_init(struct VdbTree* tree) {
     struct VdbCursor* cursor = malloc_w(sizeof(struct VdbCursor));
 
     cursor->tree = tree;
-
-    struct VdbPage* meta_page = vdbpager_pin_page(tree->pager, tree->f, 0);
+    cursor->scan = false;
 
     cursor->cur_rec_idx = 0;
-    uint32_t root = *vdbmeta_root_ptr(meta_page->buf);
-    cursor->cur_node_idx = vdbtree_traverse_to_first_leaf(tree, root);
+    cursor->cur_node_idx = vdbtree_traverse_to_first_leaf(tree, tree->root_idx);
 
     while (cursor->cur_node_idx != 0 && vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx) == 0) {
         cursor->cur_node_idx = vdbtree_leaf_read_next_leaf(tree, cursor->cur_node_idx);
     }
 
-    vdbpager_unpin_page(meta_page, true);
-
     return cursor;
 }
 
 void vdbcursor_seek(struct VdbCursor* cursor, struct VdbValue key) {
     struct VdbTree* tree = cursor->tree;
-    struct VdbPage* meta_page = vdbpager_pin_page(tree->pager, tree->f, 0);
 
-    //get leaf
+    //keys past the largest one go straight to the rightmost leaf
     uint32_t leaf_idx;
-    if (*vdbmeta_last_leaf(meta_page->buf) != 0) { //not the first record being inserted
-        struct VdbValue largest_key;
-        vdbtree_deserialize_value(tree, &largest_key, vdbmeta_largest_key(meta_page->buf));
+    if (tree->has_largest_key && tree->last_leaf != 0 && vdbvalue_compare(key, tree->largest_key) > 0) {
+        leaf_idx = tree->last_leaf;
+    } else {
+        leaf_idx = vdb_tree_traverse_to(tree, tree->root_idx, key);
+    }
+
+    cursor->cur_rec_idx = 0;
+    cursor->cur_node_idx = leaf_idx;
+}
 
-        //right append
-        if (vdbvalue_compare(key, largest_key) > 0) {
-            leaf_idx = *vdbmeta_last_leaf(meta_page->buf);
+//position of the first record in the leaf with a key not less than key
+static uint32_t vdbcursor_leaf_lower_bound(struct VdbTree* tree, uint32_t leaf_idx, struct VdbValue key) {
+    uint32_t left = 0;
+    uint32_t right = vdbtree_leaf_read_record_count(tree, leaf_idx);
+    while (left < right) {
+        uint32_t mid = (right - left) / 2 + left;
+        struct VdbValue k = vdbtree_leaf_read_record_key(tree, leaf_idx, mid);
+        int result = vdbvalue_compare(k, key);
+        vdbvalue_free(k);
+
+        if (result < 0) {
+            left = mid + 1;
         } else {
-            leaf_idx = vdb_tree_traverse_to(tree, vdbtree_meta_read_root(tree), key);
+            right = mid;
         }
-    } else { //first record being inserted
-        leaf_idx = vdb_tree_traverse_to(tree, vdbtree_meta_read_root(tree), key);
     }
 
-    cursor->cur_rec_idx = 0;
-    cursor->cur_node_idx = leaf_idx;
+    return left;
+}
+
+//moves the cursor to the first record with a key not less than key, or to the end
+void vdbcursor_seek_lower_bound(struct VdbCursor* cursor, struct VdbValue key) {
+    struct VdbTree* tree = cursor->tree;
+    vdbcursor_seek(cursor, key);
+    cursor->cur_rec_idx = vdbcursor_leaf_lower_bound(tree, cursor->cur_node_idx, key);
+
+    while (!vdbcursor_at_end(cursor) && cursor->cur_rec_idx >= vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx)) {
+        cursor->cur_rec_idx = 0;
+        cursor->cur_node_idx = vdbtree_leaf_read_next_leaf(tree, cursor->cur_node_idx);
+    }
+}
+
+//moves the cursor to the record with the given key, and returns false if there isn't one
+bool vdbcursor_seek_record(struct VdbCursor* cursor, struct VdbValue key) {
+    vdbcursor_seek_lower_bound(cursor, key);
+    if (vdbcursor_at_end(cursor))
+        return false;
+
+    struct VdbValue k = vdbtree_leaf_read_record_key(cursor->tree, cursor->cur_node_idx, cursor->cur_rec_idx);
+    bool found = vdbvalue_compare(k, key) == 0;
+    vdbvalue_free(k);
+
+    return found;
+}
+
+//moves the cursor to the first record the range may hold and starts scanning from there.  A
+//record equal to an exclusive lower bound is left for the selection to skip
+void vdbcursor_begin_range_scan(struct VdbCursor* cursor, struct VdbKeyRange* range) {
+    if (range->has_lower) {
+        vdbcursor_seek_lower_bound(cursor, range->lower);
+    }
+
+    vdbcursor_begin_scan(cursor);
+}
+
+//true once the cursor has passed the last record the range may hold
+bool vdbcursor_range_done(struct VdbCursor* cursor, struct VdbKeyRange* range) {
+    if (vdbcursor_at_end(cursor))
+        return true;
+
+    if (!range->has_upper)
+        return false;
+
+    struct VdbValue key = vdbtree_leaf_read_record_key(cursor->tree, cursor->cur_node_idx, cursor->cur_rec_idx);
+    int result = vdbvalue_compare(key, range->upper);
+    vdbvalue_free(key);
 
-    vdbpager_unpin_page(meta_page, false);
+    return result > 0 || (result == 0 && !range->upper_inclusive);
 }
 
 bool vdbcursor_at_end(struct VdbCursor* cursor) {
     return cursor->cur_node_idx == 0;
 }
 
+//hints the pager with pages the scan needs next: the following leaf, and the data blocks
+//holding the current leaf's records so their reads are issued together rather than one by one
+static void vdbcursor_readahead(struct VdbCursor* cursor) {
+    if (!cursor->scan || vdbcursor_at_end(cursor))
+        return;
+
+    struct VdbTree* tree = cursor->tree;
+    uint32_t idxs[VDB_READAHEAD_PAGES];
+    uint32_t count = 0;
+
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, cursor->cur_node_idx);
+    if (*vdbnode_next(page->buf) != 0) {
+        idxs[count++] = *vdbnode_next(page->buf);
+    }
+
+    //records in clustered tables are already in the leaf
+    uint32_t rec_count = tree->clustered ? 0 : *vdbnode_idxcell_count(page->buf);
+    for (uint32_t i = cursor->cur_rec_idx; i < rec_count && count < VDB_READAHEAD_PAGES; i++) {
+        //record pointer cells start with the data block index
+        uint32_t block_idx = *((uint32_t*)vdbnode_datacell(page->buf, i));
+
+        bool seen = false;
+        for (uint32_t j = 0; j < count; j++) {
+            if (idxs[j] == block_idx) {
+                seen = true;
+                break;
+            }
+        }
+
+        if (!seen) {
+            idxs[count++] = block_idx;
+        }
+    }
+    vdbpager_unpin_page(tree->pager, page, false);
+
+    vdbpager_prefetch(tree->pager, tree->fd, idxs, count);
+}
+
+static void vdbcursor_next_leaf(struct VdbCursor* cursor) {
+    cursor->cur_rec_idx = 0;
+    cursor->cur_node_idx = vdbtree_leaf_read_next_leaf(cursor->tree, cursor->cur_node_idx);
+    vdbcursor_readahead(cursor);
+}
+
+//marks the cursor as walking the whole table, so the pager can read ahead of it
+void vdbcursor_begin_scan(struct VdbCursor* cursor) {
+    cursor->scan = true;
+    vdbpager_begin_scan(cursor->tree->pager, cursor->tree->fd);
+    vdbcursor_readahead(cursor);
+}
+
 void vdbcursor_free(struct VdbCursor* cursor) {
+    if (cursor->scan) {
+        vdbpager_end_scan(cursor->tree->pager, cursor->tree->fd);
+    }
     free_w(cursor, sizeof(struct VdbCursor));
 }
 
@@ -67,13 +176,66 @@ struct VdbRecord* vdbcursor_fetch_record(struct VdbCursor* cursor) {
     cursor->cur_rec_idx++;
 
     while (cursor->cur_node_idx != 0 && cursor->cur_rec_idx >= vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx)) {
-        cursor->cur_rec_idx = 0;
-        cursor->cur_node_idx = vdbtree_leaf_read_next_leaf(tree, cursor->cur_node_idx);
+        vdbcursor_next_leaf(cursor);
     }
 
     return rec;
 }
 
+//reads the positions and leading columns of the next records in a range into the batch.  Returns false
+//once the range is done
+bool vdbcursor_fetch_batch(struct VdbCursor* cursor, struct VdbKeyRange* range, struct VdbBatch* batch) {
+    struct VdbTree* tree = cursor->tree;
+    uint32_t key_idx = tree->schema->key_idx;
+    batch->count = 0;
+    batch->next = 0;
+
+    //keys that are not read with the batch (or are text) are checked against the upper bound one record at a time
+    bool check_each = range->has_upper && (key_idx >= batch->col_count || tree->schema->types[key_idx] == VDBT_TYPE_TEXT);
+
+    while (batch->count < VDB_BATCH_SIZE) {
+        if (check_each ? vdbcursor_range_done(cursor, range) : vdbcursor_at_end(cursor))
+            return false;
+
+        uint32_t leaf_count = vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx);
+        uint32_t n = check_each ? 1 : leaf_count - cursor->cur_rec_idx;
+        if (n > VDB_BATCH_SIZE - batch->count) {
+            n = VDB_BATCH_SIZE - batch->count;
+        }
+
+        struct VdbValue* values = batch->values + batch->count * batch->col_count;
+        vdbtree_leaf_read_values(tree, cursor->cur_node_idx, cursor->cur_rec_idx, n, batch->col_count, values);
+
+        bool done = false;
+        if (range->has_upper && !check_each) {
+            for (uint32_t i = 0; i < n; i++) {
+                int result = vdbvalue_compare(values[i * batch->col_count + key_idx], range->upper);
+                if (result > 0 || (result == 0 && !range->upper_inclusive)) {
+                    n = i;
+                    done = true;
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            batch->leaf_idxs[batch->count] = cursor->cur_node_idx;
+            batch->rec_idxs[batch->count] = cursor->cur_rec_idx + i;
+            batch->count++;
+        }
+
+        if (done)
+            return false;
+
+        cursor->cur_rec_idx += n;
+        while (cursor->cur_node_idx != 0 && cursor->cur_rec_idx >= vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx)) {
+            vdbcursor_next_leaf(cursor);
+        }
+    }
+
+    return true;
+}
+
 uint32_t vdbtree_leaf_find_insertion_idx(struct VdbTree* tree, uint32_t leaf_idx, struct VdbValue* key) {
     uint32_t i = 0;
     uint32_t left = 0;
@@ -84,6 +246,7 @@ uint32_t vdbtree_leaf_find_insertion_idx(struct VdbTree* tree, uint32_t leaf_idx
 
         //record key is smaller than key at i
         int result = vdbvalue_compare(*key, k);
+        vdbvalue_free(k);
         if (result < 0) {
             if (right - left <= 1) {
                 break;
@@ -108,39 +271,188 @@ void vdbcursor_insert_record(struct VdbCursor* cursor, struct VdbRecord* rec) {
     struct VdbTree* tree = cursor->tree;
     struct VdbValue rec_key = rec->data[tree->schema->key_idx];
 
-    struct VdbPage* cur_page = vdbpager_pin_page(tree->pager, tree->f, cursor->cur_node_idx);
-    bool can_fit_rec = vdbnode_can_fit(cur_page->buf, vdbrecord_fixedlen_size(rec));
-    vdbpager_unpin_page(cur_page, false);
-
-    if (!can_fit_rec) {
+    if (!vdbtree_leaf_can_fit_record(tree, cursor->cur_node_idx, rec)) {
         cursor->cur_node_idx = vdbtree_leaf_split(tree, cursor->cur_node_idx, rec_key);
     }
 
-    struct VdbPage* meta_page = vdbpager_pin_page(tree->pager, tree->f, 0);
-    //sets largest key in meta block if necessary
-    if (*vdbmeta_last_leaf(meta_page->buf) != 0) { //not the first record being inserted
-        struct VdbValue largest_key;
-        vdbtree_deserialize_value(tree, &largest_key, vdbmeta_largest_key(meta_page->buf));
+    vdbtree_meta_update_largest_key(tree, rec_key);
+
+    uint32_t i = vdbtree_leaf_find_insertion_idx(tree, cursor->cur_node_idx, &rec_key);
+    vdbtree_leaf_insert_record(tree, cursor->cur_node_idx, i, rec);
+}
+
+static void vdbcursor_merge_sort_records(struct VdbRecord** recs, struct VdbRecord** tmp, uint32_t count, uint32_t key_idx) {
+    if (count < 2)
+        return;
+
+    uint32_t mid = count / 2;
+    vdbcursor_merge_sort_records(recs, tmp, mid, key_idx);
+    vdbcursor_merge_sort_records(recs + mid, tmp, count - mid, key_idx);
 
-        //right append
-        if (vdbvalue_compare(rec_key, largest_key) > 0) {
-            vdbtree_serialize_value(tree, vdbmeta_largest_key(meta_page->buf), &rec_key);
+    uint32_t l = 0;
+    uint32_t r = mid;
+    for (uint32_t i = 0; i < count; i++) {
+        if (r >= count || (l < mid && vdbvalue_compare(recs[l]->data[key_idx], recs[r]->data[key_idx]) <= 0)) {
+            tmp[i] = recs[l++];
+        } else {
+            tmp[i] = recs[r++];
         }
-    } else { //first record being inserted
-        vdbtree_serialize_value(tree, vdbmeta_largest_key(meta_page->buf), &rec_key);
     }
 
-    *vdbmeta_last_leaf(meta_page->buf) = cursor->cur_node_idx;
-    vdbpager_unpin_page(meta_page, true);
+    memcpy(recs, tmp, sizeof(struct VdbRecord*) * count);
+}
 
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, cursor->cur_node_idx);
-    uint32_t i = vdbtree_leaf_find_insertion_idx(tree, cursor->cur_node_idx, &rec_key);
+//adds the entries of table records to an index
+void vdbcursor_insert_index_entries(struct VdbIndex* index, struct VdbSchema* schema, struct VdbRecord** recs, uint32_t count) {
+    if (index->type == VDBIT_HASH) {
+        for (uint32_t i = 0; i < count; i++) {
+            vdbhashindex_insert(index->hash, vdbindex_hash(index, recs[i]), recs[i]->data[schema->key_idx]);
+        }
+        return;
+    }
+
+    struct VdbRecord** entries = malloc_w(sizeof(struct VdbRecord*) * count);
+    for (uint32_t i = 0; i < count; i++) {
+        entries[i] = vdbindex_entry(index, schema, recs[i]);
+    }
+
+    struct VdbCursor* cursor = vdbcursor_init(index->tree);
+    vdbcursor_insert_records(cursor, entries, count);
+    vdbcursor_free(cursor);
+
+    for (uint32_t i = 0; i < count; i++) {
+        vdbrecord_free(entries[i]);
+    }
+    free_w(entries, sizeof(struct VdbRecord*) * count);
+}
+
+static void vdbcursor_remove_index_entry(struct VdbIndex* index, struct VdbSchema* schema, struct VdbRecord* rec) {
+    if (index->type == VDBIT_HASH) {
+        if (!vdbhashindex_delete(index->hash, vdbindex_hash(index, rec), rec->data[schema->key_idx]))
+            assert(false && "index entry not found");
+        return;
+    }
+
+    struct VdbValue key = vdbindex_key(index, schema, rec);
+    struct VdbCursor* cursor = vdbcursor_init(index->tree);
+    if (vdbcursor_seek_record(cursor, key)) {
+        vdbcursor_delete_record(cursor);
+    } else {
+        assert(false && "index entry not found");
+    }
+    vdbcursor_free(cursor);
+    vdbvalue_free(key);
+}
+
+//sorts records by key before inserting them.  Records with keys past the largest key in the
+//table are appended leaf by leaf, and only the rest seek to their leaf one at a time
+void vdbcursor_insert_records(struct VdbCursor* cursor, struct VdbRecord** recs, uint32_t count) {
+    struct VdbTree* tree = cursor->tree;
+    uint32_t key_idx = tree->schema->key_idx;
+
+    if (count == 0)
+        return;
+
+    struct VdbRecord** tmp = malloc_w(sizeof(struct VdbRecord*) * count);
+    vdbcursor_merge_sort_records(recs, tmp, count, key_idx);
+    free_w(tmp, sizeof(struct VdbRecord*) * count);
+
+    uint32_t i = 0;
+    while (i < count) {
+        struct VdbValue key = recs[i]->data[key_idx];
+        if (tree->has_largest_key && tree->last_leaf != 0 && vdbvalue_compare(key, tree->largest_key) > 0)
+            break;
+
+        vdbcursor_seek(cursor, key);
+        vdbcursor_insert_record(cursor, recs[i]);
+        i++;
+    }
+
+    vdbtree_append_records(tree, recs + i, count - i);
+
+    for (int j = 0; j < tree->indexes->count; j++) {
+        vdbcursor_insert_index_entries(tree->indexes->indexes[j], tree->schema, recs, count);
+    }
+}
+
+struct VdbIndexCursor* vdbindexcursor_init(struct VdbIndex* index, struct VdbIndexRange* range) {
+    struct VdbIndexCursor* ic = malloc_w(sizeof(struct VdbIndexCursor));
+    ic->index = index;
+    ic->range = range;
+    ic->entries = NULL;
+
+    if (index->type == VDBIT_HASH) {
+        vdbhashindex_find(index->hash, range->hash, &ic->iter);
+        return ic;
+    }
+
+    //moves to the first entry the range may hold
+    ic->entries = vdbcursor_init(index->tree);
+    if (range->lower) {
+        struct VdbValue key = vdbstring((char*)range->lower->values, range->lower->count);
+        vdbcursor_seek_lower_bound(ic->entries, key);
+        vdbvalue_free(key);
+    }
+
+    return ic;
+}
 
-    struct VdbRecPtr p = vdbtree_append_record_to_datablock(tree, rec);
-    vdbnode_insert_idxcell(page->buf, i, sizeof(uint32_t) * 2 + vdbvalue_serialized_size(p.key));
-    vdbtree_serialize_recptr(tree, vdbnode_datacell(page->buf, i), &p);
+static struct VdbRecord* vdbindexcursor_read_table_record(struct VdbCursor* table_cursor, struct VdbValue key) {
+    bool found = vdbcursor_seek_record(table_cursor, key);
+    assert(found && "index entry points to missing record");
 
-    vdbpager_unpin_page(page, true);
+    return vdbtree_leaf_read_record(table_cursor->tree, table_cursor->cur_node_idx, table_cursor->cur_rec_idx);
+}
+
+//reads the table record of the next index entry in the range, or returns NULL once the range is
+//done.  Hash entries only match on the hash, so the caller still checks records against the selection
+struct VdbRecord* vdbindexcursor_fetch_record(struct VdbIndexCursor* ic, struct VdbCursor* table_cursor) {
+    if (ic->index->type == VDBIT_HASH) {
+        struct VdbValue key;
+        if (!vdbhashindex_next(ic->index->hash, &ic->iter, &key))
+            return NULL;
+
+        struct VdbRecord* rec = vdbindexcursor_read_table_record(table_cursor, key);
+        vdbvalue_free(key);
+        return rec;
+    }
+
+    while (!vdbcursor_at_end(ic->entries)) {
+        struct VdbRecord* entry = vdbcursor_fetch_record(ic->entries);
+        struct VdbValue key = entry->data[0];
+
+        if (ic->range->lower) {
+            int result = vdbindex_compare_bound(key, ic->range->lower);
+            if (result < 0 || (result == 0 && !ic->range->lower_inclusive)) {
+                vdbrecord_free(entry);
+                continue;
+            }
+        }
+
+        if (ic->range->upper) {
+            int result = vdbindex_compare_bound(key, ic->range->upper);
+            if (result > 0 || (result == 0 && !ic->range->upper_inclusive)) {
+                //entries are in key order, so the rest are past the range too
+                vdbrecord_free(entry);
+                ic->entries->cur_node_idx = 0;
+                return NULL;
+            }
+        }
+
+        struct VdbRecord* rec = vdbindexcursor_read_table_record(table_cursor, vdbindex_entry_primary_key(entry));
+        vdbrecord_free(entry);
+
+        return rec;
+    }
+
+    return NULL;
+}
+
+void vdbindexcursor_free(struct VdbIndexCursor* ic) {
+    if (ic->entries) {
+        vdbcursor_free(ic->entries);
+    }
+    free_w(ic, sizeof(struct VdbIndexCursor));
 }
 
 bool vdbcursor_record_passes_selection(struct VdbCursor* cursor, struct VdbExpr* selection) {
@@ -166,34 +478,30 @@ bool vdbcursor_record_passes_selection(struct VdbCursor* cursor, struct VdbExpr*
 
 void vdbcursor_delete_record(struct VdbCursor* cursor) {
     struct VdbTree* tree = cursor->tree;
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, cursor->cur_node_idx);
 
-    struct VdbRecord* rec = vdbtree_leaf_read_record(cursor->tree, cursor->cur_node_idx, cursor->cur_rec_idx);
-
-    //free any string cells in record before freeing record cell
-    for (int i = 0; i < rec->count; i++) {
-        struct VdbValue v = rec->data[i];
-        if (v.type == VDBT_TYPE_TEXT) {
-            vdbtree_free_datablock_string(tree, &v);
+    if (tree->indexes->count > 0) {
+        struct VdbRecord* rec = vdbtree_leaf_read_record(tree, cursor->cur_node_idx, cursor->cur_rec_idx);
+        for (int i = 0; i < tree->indexes->count; i++) {
+            vdbcursor_remove_index_entry(tree->indexes->indexes[i], tree->schema, rec);
         }
+        vdbrecord_free(rec);
     }
 
-    vdbnode_free_cell_and_defrag_node(page->buf, cursor->cur_rec_idx);
+    vdbtree_leaf_delete_record(tree, cursor->cur_node_idx, cursor->cur_rec_idx);
 
-    vdbpager_unpin_page(page, true);
+    //the leaf may be merged into a sibling, so the cursor follows the record after the deleted one
+    cursor->cur_node_idx = vdbtree_leaf_rebalance(tree, cursor->cur_node_idx, &cursor->cur_rec_idx);
 
-    if (cursor->cur_rec_idx >= vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx)) {
-        cursor->cur_rec_idx = 0;
-        cursor->cur_node_idx = vdbtree_leaf_read_next_leaf(tree, cursor->cur_node_idx);
+    while (!vdbcursor_at_end(cursor) && cursor->cur_rec_idx >= vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx)) {
+        vdbcursor_next_leaf(cursor);
     }
-
 }
 
 void vdbcursor_update_record(struct VdbCursor* cursor, struct VdbTokenList* attrs, struct VdbExprList* values) {
     struct VdbTree* tree = cursor->tree;
     struct VdbValueList* vl = vdbvaluelist_init();
 
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, cursor->cur_node_idx);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, cursor->cur_node_idx);
 
     struct VdbRecord* rec = vdbtree_leaf_read_record(tree, cursor->cur_node_idx, cursor->cur_rec_idx);
     struct VdbRecordSet* rs = vdbrecordset_init(NULL);
@@ -204,6 +512,12 @@ void vdbcursor_update_record(struct VdbCursor* cursor, struct VdbTokenList* attr
         vdbvaluelist_append_value(vl, v);
     }
 
+    //index entries are only moved if the update changes their key
+    struct VdbRecord* old = NULL;
+    if (tree->indexes->count > 0) {
+        old = vdbtree_leaf_read_record(tree, cursor->cur_node_idx, cursor->cur_rec_idx);
+    }
+
     //free all strings in datablocks - will just rewrite entire record for the time being
     //could optimize this by not freeing unchanged strings
     for (int i = 0; i < rec->count; i++) {
@@ -223,16 +537,31 @@ void vdbcursor_update_record(struct VdbCursor* cursor, struct VdbTokenList* attr
         }
     }
 
-    vdbtree_write_record_to_datablock(tree, rec, cursor->cur_node_idx, cursor->cur_rec_idx);
+    vdbtree_leaf_write_record(tree, cursor->cur_node_idx, cursor->cur_rec_idx, rec);
+    vdbpager_unpin_page(tree->pager, page, false);
+
+    for (int i = 0; i < tree->indexes->count; i++) {
+        struct VdbIndex* index = tree->indexes->indexes[i];
+        struct VdbValue old_key = vdbindex_key(index, tree->schema, old);
+        struct VdbValue key = vdbindex_key(index, tree->schema, rec);
+        if (vdbvalue_compare(key, old_key) != 0) {
+            vdbcursor_remove_index_entry(index, tree->schema, old);
+            vdbcursor_insert_index_entries(index, tree->schema, &rec, 1);
+        }
+        vdbvalue_free(old_key);
+        vdbvalue_free(key);
+    }
+
+    if (old) {
+        vdbrecord_free(old);
+    }
 
     vdbrecordset_free(rs); //record is freed by recordset
-    vdbpager_unpin_page(page, false);
     vdbvaluelist_free(vl);
 
     cursor->cur_rec_idx++;
     if (cursor->cur_rec_idx >= vdbtree_leaf_read_record_count(tree, cursor->cur_node_idx)) {
-        cursor->cur_rec_idx = 0;
-        cursor->cur_node_idx = vdbtree_leaf_read_next_leaf(tree, cursor->cur_node_idx);
+        vdbcursor_next_leaf(cursor);
     }
 }
 
@@ -251,9 +580,9 @@ bool vdbcursor_apply_selection(struct VdbCursor* cursor, struct VdbRecordSet* rs
     return result;
 }
 
-struct VdbRecordSet* vdbcursor_apply_projection(struct VdbCursor* cursor, struct VdbRecordSet* head, struct VdbExprList* projection, bool aggregate) {
+//starts the result of a select with a record of column names
+struct VdbRecordSet* vdbcursor_projection_header(struct VdbCursor* cursor, struct VdbExprList* projection) {
     struct VdbRecordSet* final = vdbrecordset_init(NULL);
-    struct VdbRecordSet* cur = head;
 
     //add column names to tuple
     struct VdbExpr* first_expr = projection->exprs[0];
@@ -278,28 +607,23 @@ struct VdbRecordSet* vdbcursor_apply_projection(struct VdbCursor* cursor, struct
         vdbrecordset_append_record(final, r);
     }
 
-    while (cur) {
-        uint32_t max = aggregate ? 1 : cur->count; //if group_by is used, compresses entire recordset into a single tuple
-        for (uint32_t i = 0; i < max; i++) {
-            struct VdbRecord* rec = cur->records[i];
-            struct VdbExpr* expr = projection->exprs[0];
-            if (expr->type != VDBET_WILDCARD) { //Skip if projection is *
-                struct VdbValue* data = malloc_w(sizeof(struct VdbValue) * projection->count);
-                for (int i = 0; i < projection->count; i++) {
-                    data[i] = vdbexpr_eval(projection->exprs[i], cur, cursor->tree->schema);
-                }
+    return final;
+}
 
-                free_w(rec->data, sizeof(struct VdbValue) * rec->count);
-                rec->data = data;
-                rec->count = projection->count;
-            }
-            vdbrecordset_append_record(final, rec);
-        }
+//replaces the values of a record with its projection.  Expressions are evaluated on rs, which holds
+//the record or, with 'group by', the group it stands in for
+void vdbcursor_project_record(struct VdbCursor* cursor, struct VdbRecordSet* rs, struct VdbRecord* rec, struct VdbExprList* projection) {
+    if (projection->exprs[0]->type == VDBET_WILDCARD) //Skip if projection is *
+        return;
 
-        cur = cur->next;
+    struct VdbValue* data = malloc_w(sizeof(struct VdbValue) * projection->count);
+    for (int i = 0; i < projection->count; i++) {
+        data[i] = vdbexpr_eval(projection->exprs[i], rs, cursor->tree->schema);
     }
 
-    return final;
+    free_w(rec->data, sizeof(struct VdbValue) * rec->count);
+    rec->data = data;
+    rec->count = projection->count;
 }
 
 bool vdbcursor_apply_having(struct VdbCursor* cursor, struct VdbRecordSet* rs, struct VdbExpr* expr) {
@@ -371,15 +695,6 @@ void vdbrsptrlist_enqueue(struct VdbRsPtrList* pl, struct VdbRecordSet* rs) {
     pl->count++;
 }
 
-struct VdbRecordSet* vdbrsptrlist_dequeue(struct VdbRsPtrList* pl) {
-    struct VdbRecordSet* result = pl->ps[0];
-
-    memmove(pl->ps, pl->ps + 1, sizeof(struct VdbRecordSet*) * (pl->count - 1));
-    pl->count--;
-
-    return result;
-}
-
 int vdb_compare_cols(struct VdbCursor* cursor, struct VdbRecordSet* left, struct VdbRecordSet* right, struct VdbExprList* ordering_cols) {
     struct VdbTree* tree = cursor->tree;
 
@@ -387,6 +702,8 @@ int vdb_compare_cols(struct VdbCursor* cursor, struct VdbRecordSet* left, struct
         struct VdbValue lv = vdbexpr_eval(ordering_cols->exprs[i], left, tree->schema);
         struct VdbValue rv = vdbexpr_eval(ordering_cols->exprs[i], right, tree->schema);
         int result = vdbvalue_compare(lv, rv);
+        vdbvalue_free(lv);
+        vdbvalue_free(rv);
         if (result != 0)
             return result;
     }
@@ -395,8 +712,49 @@ int vdb_compare_cols(struct VdbCursor* cursor, struct VdbRecordSet* left, struct
     return vdbvalue_compare(left->records[0]->data[tree->schema->key_idx], right->records[0]->data[tree->schema->key_idx]);
 }
 
-//TODO: external merge sort is recommended in literature since the entire tuple set may not fit into memory
-//Assuming entire tuple set fits into memory for now.  Should switch to external merge sort when needed
+static struct VdbRecordSet* vdbcursor_merge_lists(struct VdbCursor* cursor, struct VdbRecordSet* left, struct VdbRecordSet* right, struct VdbExprList* ordering_cols, bool order_desc) {
+    struct VdbRecordSet* merged = NULL;
+    struct VdbRecordSet** tail = &merged;
+    struct VdbRecordSet* cur_l = left;
+    struct VdbRecordSet* cur_r = right;
+
+    while (true) {
+        if (!cur_l) {
+            *tail = cur_r;
+            break;
+        }
+        if (!cur_r) {
+            *tail = cur_l;
+            break;
+        }
+
+        int result = vdb_compare_cols(cursor, cur_l, cur_r, ordering_cols);
+        if (order_desc) {
+            if (result >= 0) {
+                *tail = cur_l;
+                cur_l = cur_l->next;
+            } else {
+                *tail = cur_r;
+                cur_r = cur_r->next;
+            }
+        } else {
+            if (result <= 0) {
+                *tail = cur_l;
+                cur_l = cur_l->next;
+            } else {
+                *tail = cur_r;
+                cur_r = cur_r->next;
+            }
+        }
+
+        tail = &(*tail)->next;
+    }
+
+    return merged;
+}
+
+//sorts groups, which are kept in memory.  Plain selects are sorted by a VdbSorter instead, which
+//spills to temp files once the records outgrow its memory budget
 void vdbcursor_sort_linked_list(struct VdbCursor* cursor, struct VdbRecordSet** head, struct VdbExprList* ordering_cols, bool order_desc) {
     if (!(*head))
         return;
@@ -411,53 +769,121 @@ void vdbcursor_sort_linked_list(struct VdbCursor* cursor, struct VdbRecordSet**
         vdbrsptrlist_enqueue(pl, p);
     }
 
+    //merges neighbouring lists in passes, halving the number of lists each pass
     while (pl->count > 1) {
-        struct VdbRecordSet* left = vdbrsptrlist_dequeue(pl);
-        struct VdbRecordSet* right = vdbrsptrlist_dequeue(pl);
+        int merged_count = 0;
+        for (int i = 0; i + 1 < pl->count; i += 2) {
+            pl->ps[merged_count++] = vdbcursor_merge_lists(cursor, pl->ps[i], pl->ps[i + 1], ordering_cols, order_desc);
+        }
 
-        struct VdbRecordSet* merged = NULL;
-        struct VdbRecordSet** tail = &merged;
-        struct VdbRecordSet* cur_l = left;
-        struct VdbRecordSet* cur_r = right;
+        if (pl->count % 2 == 1) {
+            pl->ps[merged_count++] = pl->ps[pl->count - 1];
+        }
 
-        while (true) {
-            if (!cur_l) {
-                *tail = cur_r;
-                break;
-            }
-            if (!cur_r) {
-                *tail = cur_l;
-                break;
-            }
+        pl->count = merged_count;
+    }
 
-            int result = vdb_compare_cols(cursor, cur_l, cur_r, ordering_cols);
-            if (order_desc) {
-                if (result >= 0) {
-                    *tail = cur_l;
-                    cur_l = cur_l->next;
-                } else {
-                    *tail = cur_r;
-                    cur_r = cur_r->next;
-                }
-            } else {
-                if (result <= 0) {
-                    *tail = cur_l;
-                    cur_l = cur_l->next;
-                } else {
-                    *tail = cur_r;
-                    cur_r = cur_r->next;
-                }
-            }
+    *head = pl->ps[0];
+
+    vdbrsptrlist_free(pl);
+}
+
+/*
+ * Top-N - keeps the first n recordsets in the ordering as they are scanned, so 'order by' with
+ * 'limit' never holds more than n of them.  The heap root is the one that comes last
+ */
+
+struct VdbTopN* vdbtopn_init(struct VdbCursor* cursor, struct VdbExprList* ordering_cols, bool order_desc, uint32_t limit) {
+    struct VdbTopN* t = malloc_w(sizeof(struct VdbTopN));
+    t->cursor = cursor;
+    t->ordering_cols = ordering_cols;
+    t->order_desc = order_desc;
+    t->limit = limit;
+    t->count = 0;
+    t->capacity = 8; //grown as needed since the limit can be far more than the records
+    t->heap = malloc_w(sizeof(struct VdbRecordSet*) * t->capacity);
+
+    return t;
+}
+
+//true if left comes before right in the output
+static bool vdbtopn_before(struct VdbTopN* t, struct VdbRecordSet* left, struct VdbRecordSet* right) {
+    int result = vdb_compare_cols(t->cursor, left, right, t->ordering_cols);
+    return t->order_desc ? result > 0 : result < 0;
+}
 
-            tail = &(*tail)->next;
+static void vdbtopn_swap(struct VdbTopN* t, uint32_t a, uint32_t b) {
+    struct VdbRecordSet* tmp = t->heap[a];
+    t->heap[a] = t->heap[b];
+    t->heap[b] = tmp;
+}
+
+static void vdbtopn_sift_up(struct VdbTopN* t, uint32_t i) {
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (!vdbtopn_before(t, t->heap[parent], t->heap[i]))
+            break;
+
+        vdbtopn_swap(t, parent, i);
+        i = parent;
+    }
+}
+
+static void vdbtopn_sift_down(struct VdbTopN* t, uint32_t i) {
+    while (true) {
+        uint32_t last = i;
+        uint32_t left = 2 * i + 1;
+        uint32_t right = 2 * i + 2;
+        if (left < t->count && vdbtopn_before(t, t->heap[last], t->heap[left])) {
+            last = left;
+        }
+        if (right < t->count && vdbtopn_before(t, t->heap[last], t->heap[right])) {
+            last = right;
         }
 
-        vdbrsptrlist_enqueue(pl, merged);
+        if (last == i)
+            return;
+
+        vdbtopn_swap(t, last, i);
+        i = last;
     }
+}
 
-    *head = pl->ps[0];
+//takes ownership of rs, and frees it or the recordset it pushes out if the heap is full
+void vdbtopn_insert(struct VdbTopN* t, struct VdbRecordSet* rs) {
+    if (t->count < t->limit) {
+        if (t->count == t->capacity) {
+            uint32_t old_cap = t->capacity;
+            t->capacity *= 2;
+            t->heap = realloc_w(t->heap, sizeof(struct VdbRecordSet*) * t->capacity, sizeof(struct VdbRecordSet*) * old_cap);
+        }
 
-    vdbrsptrlist_free(pl);
+        t->heap[t->count] = rs;
+        vdbtopn_sift_up(t, t->count);
+        t->count++;
+        return;
+    }
+
+    if (t->count == 0 || !vdbtopn_before(t, rs, t->heap[0])) {
+        vdbrecordset_free(rs);
+        return;
+    }
+
+    vdbrecordset_free(t->heap[0]);
+    t->heap[0] = rs;
+    vdbtopn_sift_down(t, 0);
 }
 
+//frees the heap and returns the recordsets it kept as an unsorted linked list
+struct VdbRecordSet* vdbtopn_finish(struct VdbTopN* t) {
+    struct VdbRecordSet* head = NULL;
+    for (uint32_t i = 0; i < t->count; i++) {
+        t->heap[i]->next = head;
+        head = t->heap[i];
+    }
+
+    free_w(t->heap, sizeof(struct VdbRecordSet*) * t->capacity);
+    free_w(t, sizeof(struct VdbTopN));
 
+    return head;
+}
@@ -6,29 +6,70 @@
 #include "tree.h"
 #include "parser.h"
 #include "util.h"
+#include "index.h"
+#include "batch.h"
+
+#define VDB_READAHEAD_PAGES 32 //max pages hinted to the pager each time a scan enters a leaf
 
 struct VdbCursor {
     struct VdbTree* tree;
     uint32_t cur_node_idx;
     uint32_t cur_rec_idx;
+    bool scan;
+};
+
+//walks the entries of an index in a range, and reads the table records they point to
+struct VdbIndexCursor {
+    struct VdbIndex* index;
+    struct VdbIndexRange* range;
+    struct VdbCursor* entries; //btree indexes
+    struct VdbHashIter iter; //hash indexes
+};
+
+//first recordsets in an ordering, for 'order by' with 'limit'
+struct VdbTopN {
+    struct VdbCursor* cursor;
+    struct VdbExprList* ordering_cols;
+    bool order_desc;
+    uint32_t limit;
+    struct VdbRecordSet** heap;
+    uint32_t count;
+    uint32_t capacity;
 };
 
 struct VdbCursor* vdbcursor_init(struct VdbTree* tree);
 void vdbcursor_seek(struct VdbCursor* cursor, struct VdbValue key);
+void vdbcursor_seek_lower_bound(struct VdbCursor* cursor, struct VdbValue key);
+bool vdbcursor_seek_record(struct VdbCursor* cursor, struct VdbValue key);
 bool vdbcursor_at_end(struct VdbCursor* cursor);
+void vdbcursor_begin_scan(struct VdbCursor* cursor);
+void vdbcursor_begin_range_scan(struct VdbCursor* cursor, struct VdbKeyRange* range);
+bool vdbcursor_range_done(struct VdbCursor* cursor, struct VdbKeyRange* range);
 void vdbcursor_free(struct VdbCursor* cursor);
 struct VdbRecord* vdbcursor_fetch_record(struct VdbCursor* cursor);
+bool vdbcursor_fetch_batch(struct VdbCursor* cursor, struct VdbKeyRange* range, struct VdbBatch* batch);
 void vdbcursor_insert_record(struct VdbCursor* cursor, struct VdbRecord* rec);
+void vdbcursor_insert_records(struct VdbCursor* cursor, struct VdbRecord** recs, uint32_t count);
 void vdbcursor_delete_record(struct VdbCursor* cursor);
 void vdbcursor_update_record(struct VdbCursor* cursor, struct VdbTokenList* attributes, struct VdbExprList* values);
+void vdbcursor_insert_index_entries(struct VdbIndex* index, struct VdbSchema* schema, struct VdbRecord** recs, uint32_t count);
+
+struct VdbIndexCursor* vdbindexcursor_init(struct VdbIndex* index, struct VdbIndexRange* range);
+struct VdbRecord* vdbindexcursor_fetch_record(struct VdbIndexCursor* ic, struct VdbCursor* table_cursor);
+void vdbindexcursor_free(struct VdbIndexCursor* ic);
 
 bool vdbcursor_apply_selection(struct VdbCursor* cursor, struct VdbRecordSet* rs, struct VdbExpr* selection);
 bool vdbcursor_record_passes_selection(struct VdbCursor* cursor, struct VdbExpr* selection);
-struct VdbRecordSet* vdbcursor_apply_projection(struct VdbCursor* cursor, struct VdbRecordSet* head, struct VdbExprList* projection, bool aggregate);
+struct VdbRecordSet* vdbcursor_projection_header(struct VdbCursor* cursor, struct VdbExprList* projection);
+void vdbcursor_project_record(struct VdbCursor* cursor, struct VdbRecordSet* rs, struct VdbRecord* rec, struct VdbExprList* projection);
 bool vdbcursor_apply_having(struct VdbCursor* cursor, struct VdbRecordSet* rs, struct VdbExpr* expr);
 void vdbcursor_apply_limit(struct VdbCursor* cursor, struct VdbRecordSet* rs, struct VdbExpr* expr);
 struct VdbByteList* vdbcursor_key_from_cols(struct VdbCursor* cursor, struct VdbRecordSet* rs, struct VdbExprList* cols);
 void vdbcursor_sort_linked_list(struct VdbCursor* cursor, struct VdbRecordSet** head, struct VdbExprList* ordering_cols, bool order_desc);
 
+struct VdbTopN* vdbtopn_init(struct VdbCursor* cursor, struct VdbExprList* ordering_cols, bool order_desc, uint32_t limit);
+void vdbtopn_insert(struct VdbTopN* t, struct VdbRecordSet* rs);
+struct VdbRecordSet* vdbtopn_finish(struct VdbTopN* t);
+
 
 #endif //VDB_CURSOR_H
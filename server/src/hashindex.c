@@ -0,0 +1,386 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "util.h"
+#include "hashindex.h"
+
+//primary keys are stored serialized in the bucket, so they must have a fixed size
+bool vdbhashindex_supports_key(enum VdbTokenType type) {
+    return type == VDBT_TYPE_INT8 || type == VDBT_TYPE_FLOAT8 || type == VDBT_TYPE_BOOL;
+}
+
+static uint32_t vdbhashindex_entry_size(enum VdbTokenType key_type) {
+    struct VdbValue v;
+    v.type = key_type;
+    return sizeof(uint32_t) + vdbvalue_serialized_size(v);
+}
+
+//FNV-1a
+uint32_t vdbhashindex_hash(uint8_t* buf, uint32_t len) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < len; i++) {
+        hash ^= buf[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+ * Meta node and page allocation
+ */
+
+static void vdbhashindex_meta_write(struct VdbHashIndex* h) {
+    struct VdbPage* page = vdbpager_pin_page(h->pager, h->fd, h->meta_idx);
+    assert(*vdbnode_type(page->buf) == VDBN_HASH_META);
+
+    *vdbhashmeta_level_ptr(page->buf) = h->level;
+    *vdbhashmeta_split_ptr(page->buf) = h->split;
+    *vdbhashmeta_entry_count_ptr(page->buf) = h->entry_count;
+    *vdbhashmeta_freelist_ptr(page->buf) = h->freelist;
+
+    vdbpager_unpin_page(h->pager, page, true);
+}
+
+//reuses a page from the free list if there is one, otherwise grows the file
+static uint32_t vdbhashindex_alloc_page(struct VdbHashIndex* h, enum VdbNodeType type) {
+    uint32_t idx = h->freelist;
+    struct VdbPage* page;
+    if (idx == 0) {
+        idx = vdbpager_fresh_page(h->pager, h->fd);
+        page = vdbpager_pin_page(h->pager, h->fd, idx);
+    } else {
+        page = vdbpager_pin_page(h->pager, h->fd, idx);
+        assert(*vdbnode_type(page->buf) == VDBN_FREE && "page on free list is in use");
+        h->freelist = *vdbnode_next(page->buf);
+    }
+    memset(page->buf, 0, h->page_size);
+    *vdbnode_type(page->buf) = type;
+    vdbpager_unpin_page(h->pager, page, true);
+
+    vdbhashindex_meta_write(h);
+
+    return idx;
+}
+
+static void vdbhashindex_free_page(struct VdbHashIndex* h, uint32_t idx) {
+    struct VdbPage* page = vdbpager_pin_page(h->pager, h->fd, idx);
+    memset(page->buf, 0, h->page_size);
+    *vdbnode_type(page->buf) = VDBN_FREE;
+    *vdbnode_next(page->buf) = h->freelist;
+    vdbpager_unpin_page(h->pager, page, true);
+
+    h->freelist = idx;
+    vdbhashindex_meta_write(h);
+}
+
+/*
+ * Buckets
+ */
+
+//bucket count is only ever grown, so it is limited by the directory nodes the meta node can hold
+static uint32_t vdbhashindex_max_buckets(struct VdbHashIndex* h) {
+    struct VdbPage* page = vdbpager_pin_page_readonly(h->pager, h->fd, h->meta_idx);
+    uint32_t max = vdbhashmeta_dir_capacity(page->buf) * vdbhashdir_capacity(h->page_size);
+    vdbpager_unpin_page(h->pager, page, false);
+
+    return max;
+}
+
+//adds an empty bucket after the last one
+static void vdbhashindex_append_bucket(struct VdbHashIndex* h) {
+    uint32_t bucket = h->bucket_count;
+    uint32_t per_dir = vdbhashdir_capacity(h->page_size);
+    uint32_t page_idx = vdbhashindex_alloc_page(h, VDBN_BUCKET);
+
+    if (bucket % per_dir == 0) {
+        uint32_t dir_idx = vdbhashindex_alloc_page(h, VDBN_HASH_DIR);
+        struct VdbPage* meta = vdbpager_pin_page(h->pager, h->fd, h->meta_idx);
+        vdbhashmeta_dirs(meta->buf)[(*vdbhashmeta_dir_count_ptr(meta->buf))++] = dir_idx;
+        vdbpager_unpin_page(h->pager, meta, true);
+    }
+
+    struct VdbPage* meta = vdbpager_pin_page_readonly(h->pager, h->fd, h->meta_idx);
+    uint32_t dir_idx = vdbhashmeta_dirs(meta->buf)[bucket / per_dir];
+    vdbpager_unpin_page(h->pager, meta, false);
+
+    struct VdbPage* dir = vdbpager_pin_page(h->pager, h->fd, dir_idx);
+    vdbhashdir_buckets(dir->buf)[bucket % per_dir] = page_idx;
+    vdbpager_unpin_page(h->pager, dir, true);
+
+    if (h->bucket_count == h->bucket_capacity) {
+        uint32_t old_cap = h->bucket_capacity;
+        h->bucket_capacity *= 2;
+        h->buckets = realloc_w(h->buckets, sizeof(uint32_t) * h->bucket_capacity, sizeof(uint32_t) * old_cap);
+    }
+
+    h->buckets[h->bucket_count++] = page_idx;
+}
+
+//buckets before the split pointer have already been split in this level
+static uint32_t vdbhashindex_bucket(struct VdbHashIndex* h, uint32_t hash) {
+    uint32_t count = VDB_HASH_INITIAL_BUCKETS << h->level;
+    uint32_t bucket = hash % count;
+    if (bucket < h->split) {
+        bucket = hash % (count * 2);
+    }
+
+    return bucket;
+}
+
+//puts the entry in the first page of the bucket with room, adding an overflow page if none has
+static void vdbhashindex_bucket_append(struct VdbHashIndex* h, uint32_t bucket, uint8_t* entry) {
+    uint32_t idx = h->buckets[bucket];
+    while (true) {
+        struct VdbPage* page = vdbpager_pin_page(h->pager, h->fd, idx);
+        if (vdbnode_can_fit(page->buf, h->page_size, h->entry_size)) {
+            uint32_t cell_idx = vdbnode_new_idxcell(page->buf, h->page_size, h->entry_size);
+            memcpy(vdbnode_datacell(page->buf, cell_idx), entry, h->entry_size);
+            vdbpager_unpin_page(h->pager, page, true);
+            return;
+        }
+
+        uint32_t next = *vdbnode_next(page->buf);
+        if (next == 0) {
+            next = vdbhashindex_alloc_page(h, VDBN_BUCKET);
+            *vdbnode_next(page->buf) = next;
+            vdbpager_unpin_page(h->pager, page, true);
+        } else {
+            vdbpager_unpin_page(h->pager, page, false);
+        }
+
+        idx = next;
+    }
+}
+
+//splits the bucket at the split pointer, moving the entries that hash to the new bucket there
+static void vdbhashindex_split(struct VdbHashIndex* h) {
+    if (h->bucket_count == vdbhashindex_max_buckets(h))
+        return;
+
+    uint32_t old = h->split;
+    uint32_t count = VDB_HASH_INITIAL_BUCKETS << h->level;
+    vdbhashindex_append_bucket(h);
+
+    //empty the bucket, keeping its first page and freeing the overflow pages
+    struct VdbByteList* entries = vdbbytelist_init();
+    uint32_t idx = h->buckets[old];
+    while (idx != 0) {
+        struct VdbPage* page = vdbpager_pin_page(h->pager, h->fd, idx);
+        uint32_t cell_count = *vdbnode_idxcell_count(page->buf);
+        for (uint32_t i = 0; i < cell_count; i++) {
+            vdbbytelist_append_bytes(entries, vdbnode_datacell(page->buf, i), h->entry_size);
+        }
+
+        uint32_t next = *vdbnode_next(page->buf);
+        if (idx == h->buckets[old]) {
+            memset(page->buf, 0, h->page_size);
+            *vdbnode_type(page->buf) = VDBN_BUCKET;
+            vdbpager_unpin_page(h->pager, page, true);
+        } else {
+            vdbpager_unpin_page(h->pager, page, false);
+            vdbhashindex_free_page(h, idx);
+        }
+
+        idx = next;
+    }
+
+    h->split++;
+    if (h->split == count) {
+        h->level++;
+        h->split = 0;
+    }
+
+    for (uint32_t off = 0; off < (uint32_t)entries->count; off += h->entry_size) {
+        uint32_t hash = *((uint32_t*)(entries->values + off));
+        vdbhashindex_bucket_append(h, vdbhashindex_bucket(h, hash), entries->values + off);
+    }
+
+    vdbbytelist_free(entries);
+}
+
+/*
+ * Hash index
+ */
+
+struct VdbHashIndex* vdbhashindex_init(struct VdbSchema* schema, struct VdbPager* pager, int fd, uint32_t page_size) {
+    struct VdbHashIndex* h = malloc_w(sizeof(struct VdbHashIndex));
+    h->fd = fd;
+    h->pager = pager;
+    h->page_size = page_size;
+    h->schema = vdb_schema_copy(schema);
+    h->entry_size = vdbhashindex_entry_size(schema->types[schema->key_idx]);
+    h->level = 0;
+    h->split = 0;
+    h->entry_count = 0;
+    h->freelist = 0;
+    h->bucket_count = 0;
+    h->bucket_capacity = VDB_HASH_INITIAL_BUCKETS;
+    h->buckets = malloc_w(sizeof(uint32_t) * h->bucket_capacity);
+
+    vdbpager_create_file(pager, fd, page_size);
+
+    h->meta_idx = vdbpager_fresh_page(pager, fd);
+    struct VdbPage* page = vdbpager_pin_page(pager, fd, h->meta_idx);
+    memset(page->buf, 0, page_size);
+    *vdbnode_type(page->buf) = VDBN_HASH_META;
+    vdbmeta_allocate_schema_ptr(page->buf, page_size, vdbschema_serialized_size(schema));
+    vdbschema_serialize(vdbmeta_schema_ptr(page->buf), schema);
+    vdbpager_unpin_page(pager, page, true);
+
+    vdbhashindex_meta_write(h);
+
+    for (uint32_t i = 0; i < VDB_HASH_INITIAL_BUCKETS; i++) {
+        vdbhashindex_append_bucket(h);
+    }
+
+    return h;
+}
+
+//returns NULL if the file isn't a hash index
+struct VdbHashIndex* vdbhashindex_open(int fd, struct VdbPager* pager) {
+    uint32_t page_size = vdbpager_open_file(pager, fd);
+    if (page_size == 0)
+        return NULL;
+
+    uint32_t meta_idx = 1; //page 0 is the file header
+    struct VdbPage* page = vdbpager_pin_page_readonly(pager, fd, meta_idx);
+    if (*vdbnode_type(page->buf) != VDBN_HASH_META) {
+        vdbpager_unpin_page(pager, page, false);
+        vdbpager_close_file(pager, fd);
+        return NULL;
+    }
+
+    struct VdbHashIndex* h = malloc_w(sizeof(struct VdbHashIndex));
+    h->fd = fd;
+    h->pager = pager;
+    h->page_size = page_size;
+    h->meta_idx = meta_idx;
+    h->schema = vdbschema_deserialize(vdbmeta_schema_ptr(page->buf));
+    h->entry_size = vdbhashindex_entry_size(h->schema->types[h->schema->key_idx]);
+    h->level = *vdbhashmeta_level_ptr(page->buf);
+    h->split = *vdbhashmeta_split_ptr(page->buf);
+    h->entry_count = *vdbhashmeta_entry_count_ptr(page->buf);
+    h->freelist = *vdbhashmeta_freelist_ptr(page->buf);
+
+    h->bucket_count = (VDB_HASH_INITIAL_BUCKETS << h->level) + h->split;
+    h->bucket_capacity = h->bucket_count * 2;
+    h->buckets = malloc_w(sizeof(uint32_t) * h->bucket_capacity);
+
+    uint32_t per_dir = vdbhashdir_capacity(page_size);
+    for (uint32_t i = 0; i < *vdbhashmeta_dir_count_ptr(page->buf); i++) {
+        struct VdbPage* dir = vdbpager_pin_page_readonly(pager, fd, vdbhashmeta_dirs(page->buf)[i]);
+        for (uint32_t j = 0; j < per_dir && i * per_dir + j < h->bucket_count; j++) {
+            h->buckets[i * per_dir + j] = vdbhashdir_buckets(dir->buf)[j];
+        }
+        vdbpager_unpin_page(pager, dir, false);
+    }
+
+    vdbpager_unpin_page(pager, page, false);
+
+    return h;
+}
+
+//drops the index from the pager and frees it, but leaves its file open
+void vdbhashindex_release(struct VdbHashIndex* h) {
+    vdbpager_close_file(h->pager, h->fd);
+    vdb_schema_free(h->schema);
+    free_w(h->buckets, sizeof(uint32_t) * h->bucket_capacity);
+    free_w(h, sizeof(struct VdbHashIndex));
+}
+
+void vdbhashindex_close(struct VdbHashIndex* h) {
+    int fd = h->fd;
+    vdbhashindex_release(h);
+    close_w(fd);
+}
+
+//hash is computed by the caller from the indexed columns, and key is the primary key of the record
+void vdbhashindex_insert(struct VdbHashIndex* h, uint32_t hash, struct VdbValue key) {
+    uint8_t entry[h->entry_size];
+    *((uint32_t*)entry) = hash;
+    vdbvalue_serialize(entry + sizeof(uint32_t), key);
+
+    vdbhashindex_bucket_append(h, vdbhashindex_bucket(h, hash), entry);
+    h->entry_count++;
+
+    //cells also take an index cell and the datacell next and size fields
+    uint32_t per_page = (h->page_size - VDB_PAGE_HDR_SIZE) / (h->entry_size + sizeof(uint32_t) * 3);
+    if ((uint64_t)h->entry_count * 100 > (uint64_t)h->bucket_count * per_page * VDB_HASH_FILL_PERCENT) {
+        vdbhashindex_split(h);
+    }
+
+    vdbhashindex_meta_write(h);
+}
+
+//returns false if there is no entry for the key.  Overflow pages left empty are freed
+bool vdbhashindex_delete(struct VdbHashIndex* h, uint32_t hash, struct VdbValue key) {
+    uint8_t entry[h->entry_size];
+    *((uint32_t*)entry) = hash;
+    vdbvalue_serialize(entry + sizeof(uint32_t), key);
+
+    uint32_t prev = 0;
+    uint32_t idx = h->buckets[vdbhashindex_bucket(h, hash)];
+    while (idx != 0) {
+        struct VdbPage* page = vdbpager_pin_page(h->pager, h->fd, idx);
+        uint32_t next = *vdbnode_next(page->buf);
+        uint32_t cell_count = *vdbnode_idxcell_count(page->buf);
+
+        for (uint32_t i = 0; i < cell_count; i++) {
+            if (memcmp(vdbnode_datacell(page->buf, i), entry, h->entry_size) != 0)
+                continue;
+
+            vdbnode_free_cell_and_defrag_node(page->buf, i);
+            bool empty = *vdbnode_idxcell_count(page->buf) == 0;
+            vdbpager_unpin_page(h->pager, page, true);
+
+            if (empty && prev != 0) {
+                struct VdbPage* prev_page = vdbpager_pin_page(h->pager, h->fd, prev);
+                *vdbnode_next(prev_page->buf) = next;
+                vdbpager_unpin_page(h->pager, prev_page, true);
+                vdbhashindex_free_page(h, idx);
+            }
+
+            h->entry_count--;
+            vdbhashindex_meta_write(h);
+            return true;
+        }
+
+        vdbpager_unpin_page(h->pager, page, false);
+        prev = idx;
+        idx = next;
+    }
+
+    return false;
+}
+
+void vdbhashindex_find(struct VdbHashIndex* h, uint32_t hash, struct VdbHashIter* iter) {
+    iter->hash = hash;
+    iter->page_idx = h->buckets[vdbhashindex_bucket(h, hash)];
+    iter->cell_idx = 0;
+}
+
+//reads the primary key of the next entry with the iterator's hash.  Different column values
+//may share a hash, so records found this way must still be checked
+bool vdbhashindex_next(struct VdbHashIndex* h, struct VdbHashIter* iter, struct VdbValue* key) {
+    while (iter->page_idx != 0) {
+        struct VdbPage* page = vdbpager_pin_page_readonly(h->pager, h->fd, iter->page_idx);
+        uint32_t cell_count = *vdbnode_idxcell_count(page->buf);
+
+        while (iter->cell_idx < cell_count) {
+            uint8_t* entry = vdbnode_datacell(page->buf, iter->cell_idx++);
+            if (*((uint32_t*)entry) == iter->hash) {
+                vdbvalue_deserialize(key, entry + sizeof(uint32_t));
+                vdbpager_unpin_page(h->pager, page, false);
+                return true;
+            }
+        }
+
+        iter->page_idx = *vdbnode_next(page->buf);
+        iter->cell_idx = 0;
+        vdbpager_unpin_page(h->pager, page, false);
+    }
+
+    return false;
+}
@@ -0,0 +1,59 @@
+#ifndef VDB_HASHINDEX_H
+#define VDB_HASHINDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "schema.h"
+#include "node.h"
+#include "pager.h"
+
+#define VDB_HASH_INITIAL_BUCKETS 4
+#define VDB_HASH_FILL_PERCENT 75 //a bucket is split once entries average this full a page
+
+/*
+ * Linear hash index - buckets are chains of pages, and the bucket count grows by one split
+ * at a time once the buckets fill up.  Each entry is the hash of the indexed columns and the
+ * primary key of the record, so a lookup reads one bucket and finds the records by key
+ */
+
+struct VdbHashIndex {
+    int fd;
+    struct VdbPager* pager;
+    uint32_t page_size;
+    uint32_t meta_idx;
+    struct VdbSchema* schema; //indexed columns followed by the primary key
+    uint32_t entry_size;
+
+    //copy of the meta node fields - reads never touch the meta page, and changes are written through
+    uint32_t level;
+    uint32_t split;
+    uint32_t entry_count;
+    uint32_t freelist;
+
+    //first page of each bucket, copied from the directory nodes
+    uint32_t* buckets;
+    uint32_t bucket_count;
+    uint32_t bucket_capacity;
+};
+
+//position in the bucket of a hash
+struct VdbHashIter {
+    uint32_t hash;
+    uint32_t page_idx;
+    uint32_t cell_idx;
+};
+
+bool vdbhashindex_supports_key(enum VdbTokenType type);
+struct VdbHashIndex* vdbhashindex_init(struct VdbSchema* schema, struct VdbPager* pager, int fd, uint32_t page_size);
+struct VdbHashIndex* vdbhashindex_open(int fd, struct VdbPager* pager);
+void vdbhashindex_release(struct VdbHashIndex* h);
+void vdbhashindex_close(struct VdbHashIndex* h);
+
+uint32_t vdbhashindex_hash(uint8_t* buf, uint32_t len);
+void vdbhashindex_insert(struct VdbHashIndex* h, uint32_t hash, struct VdbValue key);
+bool vdbhashindex_delete(struct VdbHashIndex* h, uint32_t hash, struct VdbValue key);
+void vdbhashindex_find(struct VdbHashIndex* h, uint32_t hash, struct VdbHashIter* iter);
+bool vdbhashindex_next(struct VdbHashIndex* h, struct VdbHashIter* iter, struct VdbValue* key);
+
+#endif //VDB_HASHINDEX_H
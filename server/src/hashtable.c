@@ -6,61 +6,125 @@
 
 struct VdbHashTable* vdbhashtable_init() {
     struct VdbHashTable* ht = malloc_w(sizeof(struct VdbHashTable));
-    memset(ht->entries, 0, sizeof(struct VdbRecordSet*) * VDB_MAX_BUCKETS);
+    ht->count = 0;
+    ht->capacity = VDB_HASHTABLE_INITIAL_CAPACITY;
+    ht->entries = malloc_w(sizeof(struct VdbHashEntry) * ht->capacity);
+    memset(ht->entries, 0, sizeof(struct VdbHashEntry) * ht->capacity);
     return ht;
 }
 
+//recordsets in the table are not freed - they are taken out with vdbhashtable_next_entry first
 void vdbhashtable_free(struct VdbHashTable* ht) {
-    //TODO: who is reponsible for freeing ht->idxs and all the records/recordsets?
+    free_w(ht->entries, sizeof(struct VdbHashEntry) * ht->capacity);
     free_w(ht, sizeof(struct VdbHashTable));
 }
 
-//Simple hash algorithm used in key/value store in W. Richard Steven's excellent book
-//'Advanced Programming in the Unix Environment'.  Should replace with some
-//other algorithm if not sufficient in the future
+//MurmurHash64A by Austin Appleby
 static uint64_t vdbhashtable_hash(struct VdbByteList* bl) {
-    uint32_t hash = 0;
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    uint32_t len = (uint32_t)bl->count;
+    uint64_t h = 0x9747b28cULL ^ (len * m);
+
+    uint32_t blocks = len / 8;
+    for (uint32_t i = 0; i < blocks; i++) {
+        uint64_t k;
+        memcpy(&k, bl->values + i * 8, sizeof(uint64_t));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
 
-    for (int i = 0; i < bl->count; i++) {
-        hash += (i + 1) * bl->values[i];
+    uint8_t* tail = bl->values + blocks * 8;
+    uint32_t rem = len & 7;
+    if (rem > 0) {
+        for (uint32_t i = 0; i < rem; i++) {
+            h ^= (uint64_t)tail[i] << (8 * i);
+        }
+        h *= m;
     }
 
-    return hash;
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+
+    return h;
 }
 
-bool vdbhashtable_contains_key(struct VdbHashTable* ht, struct VdbByteList* key) {
-    uint64_t hash = vdbhashtable_hash(key);
-    uint64_t bucket = hash % VDB_MAX_BUCKETS;
-    struct VdbRecordSet* cur = ht->entries[bucket];
+//slot holding the key, or the empty slot where it would go
+static uint32_t vdbhashtable_probe(struct VdbHashTable* ht, struct VdbByteList* key, uint64_t hash) {
+    uint32_t mask = ht->capacity - 1;
+    uint32_t i = (uint32_t)hash & mask;
 
-    while (cur) {
-        if (memcmp(cur->key->values, key->values, sizeof(uint8_t) * key->count) == 0) {
-            return true;
-        }
+    while (true) {
+        struct VdbHashEntry* e = &ht->entries[i];
+        if (!e->rs)
+            return i;
 
-        cur = cur->next;
-    }
+        struct VdbByteList* k = e->rs->key;
+        if (e->hash == hash && k->count == key->count && memcmp(k->values, key->values, sizeof(uint8_t) * key->count) == 0)
+            return i;
 
-    return false;
+        i = (i + 1) & mask;
+    }
 }
 
-void vdbhashtable_insert_entry(struct VdbHashTable* ht, struct VdbByteList* key, struct VdbRecord* rec) {
-    uint64_t hash = vdbhashtable_hash(key);
-    uint64_t bucket = hash % VDB_MAX_BUCKETS;
-    struct VdbRecordSet* cur = ht->entries[bucket];
+static void vdbhashtable_grow(struct VdbHashTable* ht) {
+    struct VdbHashEntry* old_entries = ht->entries;
+    uint32_t old_cap = ht->capacity;
+
+    ht->capacity *= 2;
+    ht->entries = malloc_w(sizeof(struct VdbHashEntry) * ht->capacity);
+    memset(ht->entries, 0, sizeof(struct VdbHashEntry) * ht->capacity);
 
-    while (cur) {
-        if (memcmp(cur->key->values, key->values, sizeof(uint8_t) * key->count) == 0) {
-            vdbrecordset_append_record(cur, rec);
-            return;
+    uint32_t mask = ht->capacity - 1;
+    for (uint32_t i = 0; i < old_cap; i++) {
+        if (!old_entries[i].rs)
+            continue;
+
+        uint32_t j = (uint32_t)old_entries[i].hash & mask;
+        while (ht->entries[j].rs) {
+            j = (j + 1) & mask;
         }
+        ht->entries[j] = old_entries[i];
+    }
 
-        cur = cur->next;
+    free_w(old_entries, sizeof(struct VdbHashEntry) * old_cap);
+}
+
+struct VdbRecordSet* vdbhashtable_find_entry(struct VdbHashTable* ht, struct VdbByteList* key) {
+    uint64_t hash = vdbhashtable_hash(key);
+    return ht->entries[vdbhashtable_probe(ht, key, hash)].rs;
+}
+
+//adds a key that is not yet in the table, and returns its recordset.  The recordset takes the key
+struct VdbRecordSet* vdbhashtable_insert_entry(struct VdbHashTable* ht, struct VdbByteList* key, struct VdbRecord* rec) {
+    if ((uint64_t)(ht->count + 1) * 100 > (uint64_t)ht->capacity * VDB_HASHTABLE_FILL_PERCENT) {
+        vdbhashtable_grow(ht);
     }
 
-    struct VdbRecordSet* head = ht->entries[bucket];
-    ht->entries[bucket] = vdbrecordset_init(key);
-    ht->entries[bucket]->next = head;
-    vdbrecordset_append_record(ht->entries[bucket], rec);
+    uint64_t hash = vdbhashtable_hash(key);
+    uint32_t i = vdbhashtable_probe(ht, key, hash);
+    assert(!ht->entries[i].rs && "key already in hash table");
+
+    struct VdbRecordSet* rs = vdbrecordset_init(key);
+    vdbrecordset_append_record(rs, rec);
+    ht->entries[i].hash = hash;
+    ht->entries[i].rs = rs;
+    ht->count++;
+
+    return rs;
 }
 
+//recordset in the first occupied slot at or after idx, and moves idx past it.  NULL once all are read
+struct VdbRecordSet* vdbhashtable_next_entry(struct VdbHashTable* ht, uint32_t* idx) {
+    while (*idx < ht->capacity) {
+        struct VdbRecordSet* rs = ht->entries[(*idx)++].rs;
+        if (rs)
+            return rs;
+    }
+
+    return NULL;
+}
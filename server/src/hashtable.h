@@ -4,16 +4,30 @@
 #include "record.h"
 #include "binarytree.h"
 
-#define VDB_MAX_BUCKETS 137
+#define VDB_HASHTABLE_INITIAL_CAPACITY 16 //must be a power of two
+#define VDB_HASHTABLE_FILL_PERCENT 75 //table doubles once this full
+
+/*
+ * Open addressing hash table with linear probing - each slot holds the hash of its key so most
+ * probes that miss never compare keys.  Keys are owned by the recordsets in the slots
+ */
+
+struct VdbHashEntry {
+    uint64_t hash;
+    struct VdbRecordSet* rs; //NULL if slot is empty
+};
 
 struct VdbHashTable {
-    struct VdbRecordSet* entries[VDB_MAX_BUCKETS];
+    struct VdbHashEntry* entries;
+    uint32_t count;
+    uint32_t capacity;
 };
 
 
 struct VdbHashTable* vdbhashtable_init();
 void vdbhashtable_free(struct VdbHashTable* ht);
-bool vdbhashtable_contains_key(struct VdbHashTable* ht, struct VdbByteList* key);
-void vdbhashtable_insert_entry(struct VdbHashTable* ht, struct VdbByteList* key, struct VdbRecord* rec);
+struct VdbRecordSet* vdbhashtable_find_entry(struct VdbHashTable* ht, struct VdbByteList* key);
+struct VdbRecordSet* vdbhashtable_insert_entry(struct VdbHashTable* ht, struct VdbByteList* key, struct VdbRecord* rec);
+struct VdbRecordSet* vdbhashtable_next_entry(struct VdbHashTable* ht, uint32_t* idx);
 
 #endif //VDB_HASHTABLE_H
@@ -0,0 +1,597 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "index.h"
+
+//a comparison between a column and a constant in a where clause
+struct VdbIndexBound {
+    uint32_t col;
+    enum VdbTokenType op;
+    struct VdbValue value;
+};
+
+//schema of the index file: the encoded key (btree indexes only), the indexed columns and the
+//primary key
+static struct VdbSchema* vdbindex_schema(enum VdbIndexType type, struct VdbSchema* schema, uint32_t* cols, uint32_t count) {
+    uint32_t first = type == VDBIT_BTREE ? 1 : 0;
+
+    struct VdbSchema* s = malloc_w(sizeof(struct VdbSchema));
+    s->count = first + count + 1;
+    s->key_idx = type == VDBIT_BTREE ? 0 : s->count - 1;
+    s->types = malloc_w(sizeof(enum VdbTokenType) * s->count);
+    s->names = malloc_w(sizeof(char*) * s->count);
+
+    if (type == VDBIT_BTREE) {
+        s->types[0] = VDBT_TYPE_TEXT;
+        s->names[0] = strdup_w("key");
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        s->types[first + i] = schema->types[cols[i]];
+        s->names[first + i] = strdup_w(schema->names[cols[i]]);
+    }
+
+    s->types[s->count - 1] = schema->types[schema->key_idx];
+    s->names[s->count - 1] = strdup_w(schema->names[schema->key_idx]);
+
+    return s;
+}
+
+struct VdbIndex* vdbindex_init(const char* name, enum VdbIndexType type, struct VdbSchema* schema, uint32_t* cols, uint32_t count, struct VdbPager* pager, int fd, uint32_t page_size) {
+    struct VdbIndex* index = malloc_w(sizeof(struct VdbIndex));
+    index->name = strdup_w(name);
+    index->type = type;
+    index->tree = NULL;
+    index->hash = NULL;
+    index->count = count;
+    index->cols = malloc_w(sizeof(uint32_t) * count);
+    memcpy(index->cols, cols, sizeof(uint32_t) * count);
+
+    struct VdbSchema* s = vdbindex_schema(type, schema, cols, count);
+    if (type == VDBIT_BTREE) {
+        index->tree = vdb_tree_init(name, s, pager, fd, page_size, true);
+    } else {
+        index->hash = vdbhashindex_init(s, pager, fd, page_size);
+    }
+    vdb_schema_free(s);
+
+    return index;
+}
+
+static void vdbindex_close_file(struct VdbIndex* index) {
+    if (index->tree) {
+        vdb_tree_close(index->tree);
+    }
+
+    if (index->hash) {
+        vdbhashindex_close(index->hash);
+    }
+}
+
+//finds the indexed columns in the table schema by name.  Returns NULL if the file isn't an index or
+//the table no longer has one of its columns, and the caller closes fd like it does for tables
+struct VdbIndex* vdbindex_open(const char* name, struct VdbSchema* schema, struct VdbPager* pager, int fd) {
+    struct VdbIndex* index = malloc_w(sizeof(struct VdbIndex));
+    index->name = strdup_w(name);
+    index->tree = NULL;
+    index->hash = vdbhashindex_open(fd, pager);
+
+    struct VdbSchema* s;
+    uint32_t first; //position of the first indexed column in the index schema
+    bool valid;
+    if (index->hash) {
+        index->type = VDBIT_HASH;
+        s = index->hash->schema;
+        first = 0;
+        valid = s->count >= 2 && s->key_idx == s->count - 1;
+    } else if ((index->tree = vdb_tree_open(name, fd, pager))) {
+        index->type = VDBIT_BTREE;
+        s = index->tree->schema;
+        first = 1;
+        valid = index->tree->clustered && s->count >= 3 && s->key_idx == 0 && s->types[0] == VDBT_TYPE_TEXT;
+    } else {
+        free_w(index->name, sizeof(char) * (strlen(index->name) + 1));
+        free_w(index, sizeof(struct VdbIndex));
+        return NULL;
+    }
+
+    valid = valid && strcmp(s->names[s->count - 1], schema->names[schema->key_idx]) == 0;
+    valid = valid && s->types[s->count - 1] == schema->types[schema->key_idx];
+
+    uint32_t count = valid ? s->count - first - 1 : 0;
+    uint32_t cols[count + 1];
+    for (uint32_t i = 0; i < count && valid; i++) {
+        cols[i] = schema->count;
+        for (uint32_t j = 0; j < schema->count; j++) {
+            if (strcmp(s->names[first + i], schema->names[j]) == 0 && s->types[first + i] == schema->types[j]) {
+                cols[i] = j;
+                break;
+            }
+        }
+        valid = cols[i] < schema->count;
+    }
+
+    if (!valid) {
+        if (index->tree) {
+            vdb_tree_release(index->tree);
+        }
+        if (index->hash) {
+            vdbhashindex_release(index->hash);
+        }
+        free_w(index->name, sizeof(char) * (strlen(index->name) + 1));
+        free_w(index, sizeof(struct VdbIndex));
+        return NULL;
+    }
+
+    index->count = count;
+    index->cols = malloc_w(sizeof(uint32_t) * count);
+    memcpy(index->cols, cols, sizeof(uint32_t) * count);
+
+    return index;
+}
+
+void vdbindex_close(struct VdbIndex* index) {
+    vdbindex_close_file(index);
+    free_w(index->cols, sizeof(uint32_t) * index->count);
+    free_w(index->name, sizeof(char) * (strlen(index->name) + 1));
+    free_w(index, sizeof(struct VdbIndex));
+}
+
+/*
+ * Key encoding
+ *
+ * Keys are compared as strings, so each value is written so that its bytes sort in the same
+ * order as the value.  A tag byte puts nulls first, numbers are big endian with the sign flipped
+ * (and the other bits too for negative floats), and strings end with [0|0] with 0 bytes inside
+ * them written as [0|255].  No encoding is a prefix of another, so keys are ordered by their
+ * first column, then their second, and so on
+ */
+
+static void vdbindex_encode_value(struct VdbByteList* bl, struct VdbValue* v) {
+    if (v->type == VDBT_TYPE_NULL) {
+        vdbbytelist_append_byte(bl, 0);
+        return;
+    }
+
+    vdbbytelist_append_byte(bl, 1);
+
+    uint64_t bits;
+    switch (v->type) {
+        case VDBT_TYPE_INT8:
+            bits = (uint64_t)v->as.Int ^ ((uint64_t)1 << 63);
+            break;
+        case VDBT_TYPE_FLOAT8: {
+            double d = v->as.Float == 0.0 ? 0.0 : v->as.Float; //-0.0 equals 0.0
+            memcpy(&bits, &d, sizeof(uint64_t));
+            bits = (bits >> 63) ? ~bits : bits ^ ((uint64_t)1 << 63);
+            break;
+        }
+        case VDBT_TYPE_BOOL:
+            vdbbytelist_append_byte(bl, v->as.Bool ? 1 : 0);
+            return;
+        case VDBT_TYPE_TEXT:
+            for (uint32_t i = 0; i < v->as.Str.len; i++) {
+                uint8_t c = (uint8_t)v->as.Str.start[i];
+                vdbbytelist_append_byte(bl, c);
+                if (c == 0) {
+                    vdbbytelist_append_byte(bl, 255);
+                }
+            }
+            vdbbytelist_append_byte(bl, 0);
+            vdbbytelist_append_byte(bl, 0);
+            return;
+        default:
+            assert(false && "invalid data type");
+            return;
+    }
+
+    for (int i = 7; i >= 0; i--) {
+        vdbbytelist_append_byte(bl, (uint8_t)(bits >> (i * 8)));
+    }
+}
+
+//key of the entry for a table record - the indexed columns followed by the primary key
+struct VdbValue vdbindex_key(struct VdbIndex* index, struct VdbSchema* schema, struct VdbRecord* rec) {
+    struct VdbByteList* bl = vdbbytelist_init();
+
+    for (uint32_t i = 0; i < index->count; i++) {
+        vdbindex_encode_value(bl, &rec->data[index->cols[i]]);
+    }
+    vdbindex_encode_value(bl, &rec->data[schema->key_idx]);
+
+    struct VdbValue key = vdbstring((char*)bl->values, bl->count);
+    vdbbytelist_free(bl);
+
+    return key;
+}
+
+//hash of the indexed columns, without the primary key
+uint32_t vdbindex_hash(struct VdbIndex* index, struct VdbRecord* rec) {
+    struct VdbByteList* bl = vdbbytelist_init();
+    for (uint32_t i = 0; i < index->count; i++) {
+        vdbindex_encode_value(bl, &rec->data[index->cols[i]]);
+    }
+
+    uint32_t hash = vdbhashindex_hash(bl->values, bl->count);
+    vdbbytelist_free(bl);
+
+    return hash;
+}
+
+struct VdbRecord* vdbindex_entry(struct VdbIndex* index, struct VdbSchema* schema, struct VdbRecord* rec) {
+    uint32_t count = index->count + 2;
+    struct VdbValue data[count];
+
+    data[0] = vdbindex_key(index, schema, rec);
+    for (uint32_t i = 0; i < index->count; i++) {
+        data[i + 1] = vdbvalue_copy(rec->data[index->cols[i]]);
+    }
+    data[count - 1] = vdbvalue_copy(rec->data[schema->key_idx]);
+
+    return vdbrecord_init(count, data);
+}
+
+struct VdbValue vdbindex_entry_primary_key(struct VdbRecord* entry) {
+    return entry->data[entry->count - 1];
+}
+
+//0 if the key starts with the bound, otherwise the order of the key and the bound
+int vdbindex_compare_bound(struct VdbValue key, struct VdbByteList* bound) {
+    uint32_t bound_len = bound->count;
+    uint32_t len = key.as.Str.len < bound_len ? key.as.Str.len : bound_len;
+
+    int result = memcmp(key.as.Str.start, bound->values, len);
+    if (result != 0)
+        return result;
+
+    return key.as.Str.len < bound_len ? -1 : 0;
+}
+
+/*
+ * Index selection
+ */
+
+static bool vdbindex_expr_is_constant(struct VdbExpr* expr) {
+    switch (expr->type) {
+        case VDBET_LITERAL:
+            return true;
+        case VDBET_UNARY:
+            return expr->as.unary.op.type == VDBT_MINUS && vdbindex_expr_is_constant(expr->as.unary.right);
+        default:
+            return false;
+    }
+}
+
+//position of the column an identifier names, or the schema count if expr isn't one
+static uint32_t vdbindex_expr_column(struct VdbExpr* expr, struct VdbSchema* schema) {
+    if (expr->type != VDBET_IDENTIFIER)
+        return schema->count;
+
+    struct VdbToken t = expr->as.identifier.token;
+    for (uint32_t i = 0; i < schema->count; i++) {
+        if (strlen(schema->names[i]) == (size_t)t.len && strncmp(schema->names[i], t.lexeme, t.len) == 0)
+            return i;
+    }
+
+    return schema->count;
+}
+
+//collects the comparisons between a column and a constant that are joined by 'and' at the top
+//of the where clause.  Anything else, such as an 'or', only narrows the result further and is
+//left for the selection to check on each record
+static void vdbindex_collect_bounds(struct VdbExpr* expr, struct VdbSchema* schema, struct VdbIndexBound* bounds, uint32_t* count) {
+    if (expr->type != VDBET_BINARY || *count == VDB_INDEX_MAX_BOUNDS)
+        return;
+
+    enum VdbTokenType op = expr->as.binary.op.type;
+    if (op == VDBT_AND) {
+        vdbindex_collect_bounds(expr->as.binary.left, schema, bounds, count);
+        vdbindex_collect_bounds(expr->as.binary.right, schema, bounds, count);
+        return;
+    }
+
+    if (op != VDBT_EQUALS && op != VDBT_LESS && op != VDBT_LESS_EQUALS && op != VDBT_GREATER && op != VDBT_GREATER_EQUALS)
+        return;
+
+    struct VdbExpr* constant = expr->as.binary.right;
+    uint32_t col = vdbindex_expr_column(expr->as.binary.left, schema);
+
+    //constant on the left side flips the comparison
+    if (col == schema->count) {
+        constant = expr->as.binary.left;
+        col = vdbindex_expr_column(expr->as.binary.right, schema);
+        switch (op) {
+            case VDBT_LESS: op = VDBT_GREATER; break;
+            case VDBT_LESS_EQUALS: op = VDBT_GREATER_EQUALS; break;
+            case VDBT_GREATER: op = VDBT_LESS; break;
+            case VDBT_GREATER_EQUALS: op = VDBT_LESS_EQUALS; break;
+            default: break;
+        }
+    }
+
+    if (col == schema->count || !vdbindex_expr_is_constant(constant))
+        return;
+
+    struct VdbValue v = vdbexpr_eval(constant, NULL, NULL);
+    if (v.type != schema->types[col]) {
+        vdbvalue_free(v);
+        return;
+    }
+
+    bounds[*count].col = col;
+    bounds[*count].op = op;
+    bounds[*count].value = v;
+    (*count)++;
+}
+
+//picks the bounds on a column that leave the fewest values.  Either may be set to NULL
+static void vdbindex_tightest_bounds(struct VdbIndexBound* bounds, uint32_t count, uint32_t col, struct VdbIndexBound** lower, struct VdbIndexBound** upper) {
+    *lower = NULL;
+    *upper = NULL;
+    for (uint32_t j = 0; j < count; j++) {
+        struct VdbIndexBound* b = &bounds[j];
+        if (b->col != col)
+            continue;
+
+        if (b->op == VDBT_GREATER || b->op == VDBT_GREATER_EQUALS) {
+            int result = *lower ? vdbvalue_compare(b->value, (*lower)->value) : 1;
+            if (result > 0 || (result == 0 && b->op == VDBT_GREATER)) {
+                *lower = b;
+            }
+        } else if (b->op == VDBT_LESS || b->op == VDBT_LESS_EQUALS) {
+            int result = *upper ? vdbvalue_compare(b->value, (*upper)->value) : -1;
+            if (result < 0 || (result == 0 && b->op == VDBT_LESS)) {
+                *upper = b;
+            }
+        }
+    }
+}
+
+static struct VdbByteList* vdbindex_bound(struct VdbByteList* prefix, struct VdbValue* v) {
+    struct VdbByteList* bl = vdbbytelist_init();
+    vdbbytelist_append_bytes(bl, prefix->values, prefix->count);
+    if (v) {
+        vdbindex_encode_value(bl, v);
+    }
+
+    return bl;
+}
+
+//builds the range of entries matching equalities on the leading indexed columns, and the
+//tightest bounds on the column after them.  Returns 0 if no bound uses the index, and otherwise
+//a score that is higher for ranges expected to hold fewer entries
+static uint32_t vdbindex_build_range(struct VdbIndex* index, struct VdbIndexBound* bounds, uint32_t count, struct VdbIndexRange* range) {
+    struct VdbByteList* prefix = vdbbytelist_init();
+    uint32_t score = 0;
+
+    uint32_t i = 0;
+    for (; i < index->count; i++) {
+        struct VdbIndexBound* eq = NULL;
+        for (uint32_t j = 0; j < count; j++) {
+            if (bounds[j].col == index->cols[i] && bounds[j].op == VDBT_EQUALS) {
+                eq = &bounds[j];
+                break;
+            }
+        }
+
+        if (!eq)
+            break;
+
+        vdbindex_encode_value(prefix, &eq->value);
+        score += 2;
+    }
+
+    struct VdbIndexBound* lower = NULL;
+    struct VdbIndexBound* upper = NULL;
+    if (i < index->count) {
+        vdbindex_tightest_bounds(bounds, count, index->cols[i], &lower, &upper);
+    }
+
+    if (lower || upper) {
+        score++;
+    }
+
+    //hash indexes find entries in a single bucket, so every column needs a value.  They beat a
+    //btree index on the same columns
+    if (index->type == VDBIT_HASH) {
+        score = i == index->count ? score + 1 : 0;
+    }
+
+    range->lower = NULL;
+    range->upper = NULL;
+    range->lower_inclusive = true;
+    range->upper_inclusive = true;
+    range->hash = 0;
+
+    if (score == 0) {
+        vdbbytelist_free(prefix);
+        return 0;
+    }
+
+    if (lower) {
+        range->lower = vdbindex_bound(prefix, &lower->value);
+        range->lower_inclusive = lower->op == VDBT_GREATER_EQUALS;
+    } else {
+        range->lower = vdbindex_bound(prefix, NULL);
+        //nulls sort first, and never pass a comparison
+        if (upper) {
+            vdbbytelist_append_byte(range->lower, 1);
+        }
+    }
+
+    if (upper) {
+        range->upper = vdbindex_bound(prefix, &upper->value);
+        range->upper_inclusive = upper->op == VDBT_LESS_EQUALS;
+    } else if (prefix->count > 0) {
+        range->upper = vdbindex_bound(prefix, NULL);
+    }
+
+    if (index->type == VDBIT_HASH) {
+        range->hash = vdbhashindex_hash(prefix->values, prefix->count);
+    }
+
+    vdbbytelist_free(prefix);
+
+    return score;
+}
+
+//bounds on the primary key for scanning the table.  Returns 0 if the selection doesn't bound the
+//key, and otherwise a score comparable to the ones of index ranges
+uint32_t vdbindex_plan_key_range(struct VdbSchema* schema, struct VdbExpr* selection, struct VdbKeyRange* range) {
+    struct VdbIndexBound bounds[VDB_INDEX_MAX_BOUNDS];
+    uint32_t count = 0;
+    if (selection) {
+        vdbindex_collect_bounds(selection, schema, bounds, &count);
+    }
+
+    range->has_lower = false;
+    range->has_upper = false;
+    range->lower_inclusive = true;
+    range->upper_inclusive = true;
+
+    struct VdbIndexBound* eq = NULL;
+    for (uint32_t i = 0; i < count; i++) {
+        if (bounds[i].col == schema->key_idx && bounds[i].op == VDBT_EQUALS) {
+            eq = &bounds[i];
+            break;
+        }
+    }
+
+    struct VdbIndexBound* lower = eq;
+    struct VdbIndexBound* upper = eq;
+    if (!eq) {
+        vdbindex_tightest_bounds(bounds, count, schema->key_idx, &lower, &upper);
+    }
+
+    if (lower) {
+        range->has_lower = true;
+        range->lower = vdbvalue_copy(lower->value);
+        range->lower_inclusive = lower->op != VDBT_GREATER;
+    }
+
+    if (upper) {
+        range->has_upper = true;
+        range->upper = vdbvalue_copy(upper->value);
+        range->upper_inclusive = upper->op != VDBT_LESS;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        vdbvalue_free(bounds[i].value);
+    }
+
+    //a single record beats any index, and a range reads records without a lookup per entry so
+    //it wins ties with index ranges
+    if (eq)
+        return UINT32_MAX;
+
+    return lower || upper ? 1 : 0;
+}
+
+//picks the index whose range holds the fewest entries that may pass the selection, or returns
+//NULL if no index helps.  Indexes must score above min_score, which is the score of scanning
+//the table by key.  Every record found through the range must still pass the selection
+struct VdbIndex* vdbindex_plan(struct VdbIndexList* il, struct VdbSchema* schema, struct VdbExpr* selection, uint32_t min_score, struct VdbIndexRange* range) {
+    struct VdbIndexBound bounds[VDB_INDEX_MAX_BOUNDS];
+    uint32_t count = 0;
+    if (selection) {
+        vdbindex_collect_bounds(selection, schema, bounds, &count);
+    }
+
+    struct VdbIndex* best = NULL;
+    uint32_t best_score = min_score;
+
+    for (int i = 0; i < il->count; i++) {
+        struct VdbIndexRange r;
+        uint32_t score = vdbindex_build_range(il->indexes[i], bounds, count, &r);
+        if (score > best_score) {
+            if (best) {
+                vdbindexrange_free(range);
+            }
+            *range = r;
+            best = il->indexes[i];
+            best_score = score;
+        } else {
+            vdbindexrange_free(&r);
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        vdbvalue_free(bounds[i].value);
+    }
+
+    return best;
+}
+
+void vdbindexrange_free(struct VdbIndexRange* range) {
+    if (range->lower) {
+        vdbbytelist_free(range->lower);
+    }
+
+    if (range->upper) {
+        vdbbytelist_free(range->upper);
+    }
+}
+
+void vdbkeyrange_free(struct VdbKeyRange* range) {
+    if (range->has_lower) {
+        vdbvalue_free(range->lower);
+    }
+
+    if (range->has_upper) {
+        vdbvalue_free(range->upper);
+    }
+}
+
+/*
+ * Index list
+ */
+
+struct VdbIndexList* vdbindexlist_init() {
+    struct VdbIndexList* il = malloc_w(sizeof(struct VdbIndexList));
+    il->count = 0;
+    il->capacity = 8;
+    il->indexes = malloc_w(sizeof(struct VdbIndex*) * il->capacity);
+
+    return il;
+}
+
+void vdbindexlist_free(struct VdbIndexList* il) {
+    for (int i = 0; i < il->count; i++) {
+        vdbindex_close(il->indexes[i]);
+    }
+
+    free_w(il->indexes, sizeof(struct VdbIndex*) * il->capacity);
+    free_w(il, sizeof(struct VdbIndexList));
+}
+
+void vdbindexlist_append_index(struct VdbIndexList* il, struct VdbIndex* index) {
+    if (il->count == il->capacity) {
+        uint32_t old_cap = il->capacity;
+        il->capacity *= 2;
+        il->indexes = realloc_w(il->indexes, sizeof(struct VdbIndex*) * il->capacity, sizeof(struct VdbIndex*) * old_cap);
+    }
+
+    il->indexes[il->count++] = index;
+}
+
+struct VdbIndex* vdbindexlist_get_index(struct VdbIndexList* il, const char* name) {
+    for (int i = 0; i < il->count; i++) {
+        if (strcmp(il->indexes[i]->name, name) == 0)
+            return il->indexes[i];
+    }
+
+    return NULL;
+}
+
+struct VdbIndex* vdbindexlist_remove_index(struct VdbIndexList* il, const char* name) {
+    for (int i = 0; i < il->count; i++) {
+        struct VdbIndex* index = il->indexes[i];
+        if (strcmp(index->name, name) == 0) {
+            il->indexes[i] = il->indexes[--il->count];
+            return index;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,84 @@
+#ifndef VDB_INDEX_H
+#define VDB_INDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "tree.h"
+#include "hashindex.h"
+#include "parser.h"
+#include "util.h"
+
+#define VDB_INDEX_MAX_BOUNDS 32 //comparisons in a where clause considered when picking an index
+
+/*
+ * Secondary index - a file holding one entry per table record.  Btree indexes are clustered
+ * trees with entries [encoded key|indexed columns...|primary key], and answer equality and
+ * range lookups.  Hash indexes only answer equality lookups on all their columns
+ *
+ * The key encodes the indexed columns followed by the primary key so that comparing keys as
+ * strings orders entries by column values, and two records never share a key
+ */
+
+enum VdbIndexType {
+    VDBIT_BTREE,
+    VDBIT_HASH
+};
+
+struct VdbIndex {
+    char* name;
+    enum VdbIndexType type;
+    struct VdbTree* tree; //entries of btree indexes
+    struct VdbHashIndex* hash; //entries of hash indexes
+    uint32_t* cols; //positions of the indexed columns in the table schema
+    uint32_t count;
+};
+
+struct VdbIndexList {
+    struct VdbIndex** indexes;
+    int count;
+    int capacity;
+};
+
+//entries an index scan visits.  Bounds are whole encoded columns, so keys of entries whose
+//leading columns equal a bound start with it.  Either bound may be NULL
+struct VdbIndexRange {
+    struct VdbByteList* lower;
+    struct VdbByteList* upper;
+    bool lower_inclusive;
+    bool upper_inclusive;
+    uint32_t hash; //of the encoded columns, for hash indexes
+};
+
+//records of a table scan by primary key.  A missing bound leaves that end of the table open
+struct VdbKeyRange {
+    struct VdbValue lower;
+    struct VdbValue upper;
+    bool has_lower;
+    bool has_upper;
+    bool lower_inclusive;
+    bool upper_inclusive;
+};
+
+struct VdbIndex* vdbindex_init(const char* name, enum VdbIndexType type, struct VdbSchema* schema, uint32_t* cols, uint32_t count, struct VdbPager* pager, int fd, uint32_t page_size);
+struct VdbIndex* vdbindex_open(const char* name, struct VdbSchema* schema, struct VdbPager* pager, int fd);
+void vdbindex_close(struct VdbIndex* index);
+
+struct VdbValue vdbindex_key(struct VdbIndex* index, struct VdbSchema* schema, struct VdbRecord* rec);
+uint32_t vdbindex_hash(struct VdbIndex* index, struct VdbRecord* rec);
+struct VdbRecord* vdbindex_entry(struct VdbIndex* index, struct VdbSchema* schema, struct VdbRecord* rec);
+struct VdbValue vdbindex_entry_primary_key(struct VdbRecord* entry);
+int vdbindex_compare_bound(struct VdbValue key, struct VdbByteList* bound);
+
+uint32_t vdbindex_plan_key_range(struct VdbSchema* schema, struct VdbExpr* selection, struct VdbKeyRange* range);
+struct VdbIndex* vdbindex_plan(struct VdbIndexList* il, struct VdbSchema* schema, struct VdbExpr* selection, uint32_t min_score, struct VdbIndexRange* range);
+void vdbindexrange_free(struct VdbIndexRange* range);
+void vdbkeyrange_free(struct VdbKeyRange* range);
+
+struct VdbIndexList* vdbindexlist_init();
+void vdbindexlist_free(struct VdbIndexList* il);
+void vdbindexlist_append_index(struct VdbIndexList* il, struct VdbIndex* index);
+struct VdbIndex* vdbindexlist_get_index(struct VdbIndexList* il, const char* name);
+struct VdbIndex* vdbindexlist_remove_index(struct VdbIndexList* il, const char* name);
+
+#endif //VDB_INDEX_H
@@ -1,5 +1,8 @@
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "interp.h"
 #include "util.h"
@@ -7,28 +10,47 @@
 #include "binarytree.h"
 #include "hashtable.h"
 #include "cursor.h"
+#include "sort.h"
+#include "operator.h"
 
 #define MAX_TAR_SIZE 256
 #define MAX_BUF_SIZE 1024
+#define VDB_DB_HDR_FILE "database.hdr"
+#define VDB_LOAD_BATCH 4096 //rows copy and vacuum read before inserting them together
 
 struct VdbServer server;
 
 
 enum VdbReturnCode vdbvm_drop_table(VDBHANDLE h, const char* name);
 
+//index files are named <table>.<index>.vix so they can be attached to their table when opened
+static void vdbvm_index_path(char* path, const char* db_name, const char* table_name, const char* index_name) {
+    path[0] = '\0';
+    strcat(path, db_name);
+    strcat(path, ".vdb/");
+    strcat(path, table_name);
+    strcat(path, ".");
+    strcat(path, index_name);
+    strcat(path, ".vix");
+}
+
 struct VdbDatabase* vdbdb_init(const char* name_without_ext) {
     struct VdbDatabase* db = malloc_w(sizeof(struct VdbDatabase));
 
     db->pager = server.pager;
     db->trees = vdb_treelist_init();
     db->name = strdup_w(name_without_ext);
-    mtx_init(&db->lock, mtx_plain);
+    db->page_size = VDB_DEFAULT_PAGE_SIZE;
+    vdbrwlock_init(&db->lock);
+    mtx_init(&db->write_lock, mtx_plain);
+    db->handles = 0;
 
     return db;
 }
 
 void vdbdb_free(struct VdbDatabase* db) {
-    mtx_destroy(&db->lock);
+    mtx_destroy(&db->write_lock);
+    vdbrwlock_destroy(&db->lock);
     vdb_treelist_free(db->trees);
     free_w(db->name, sizeof(char) * (strlen(db->name) + 1)); //include null terminator
     free_w(db, sizeof(struct VdbDatabase));
@@ -50,6 +72,18 @@ struct VdbDatabase* vdbvm_open_db(const char* dirname) {
         return NULL;
     }
 
+    //page size for new tables
+    char hdr_path[FILENAME_MAX];
+    snprintf(hdr_path, FILENAME_MAX, "%s/%s", dirname, VDB_DB_HDR_FILE);
+    int hdr = open(hdr_path, O_RDONLY);
+    if (hdr != -1) {
+        if (!vdbpager_read_file_hdr(hdr, &db->page_size)) {
+            printf("database %s has an invalid header - using default page size\n", db->name);
+            db->page_size = VDB_DEFAULT_PAGE_SIZE;
+        }
+        close_w(hdr);
+    }
+
     //open all table files
     struct dirent* ent;
     while ((ent = readdir(d)) != NULL) {
@@ -68,24 +102,78 @@ struct VdbDatabase* vdbvm_open_db(const char* dirname) {
         strcat(path, dirname);
         strcat(path, "/");
         strcat(path, ent->d_name);
-        FILE* f = fopen_w(path, "r+");
-        setbuf(f, NULL);
+        int fd = open_w(path, O_RDWR, 0);
 
         char* s = malloc_w(sizeof(char) * (entry_len - 3));
         memcpy(s, ent->d_name, entry_len - 4);
-        s[entry_len - 3] = '\0';
-        struct VdbTree* tree = vdb_tree_open(s, f, db->pager);
+        s[entry_len - 4] = '\0';
+        struct VdbTree* tree = vdb_tree_open(s, fd, db->pager);
+        if (!tree) {
+            printf("skipping table %s: not a vaquita table file or unsupported format version\n", path);
+            close_w(fd);
+            continue;
+        }
         vdb_treelist_append_tree(db->trees, tree);
     }
 
+    //open index files after all tables so they can be attached
+    rewinddir(d);
+    while ((ent = readdir(d)) != NULL) {
+        int entry_len = strlen(ent->d_name);
+        const char* ext = ".vix";
+        int ext_len = strlen(ext);
+
+        if (entry_len <= ext_len)
+            continue;
+
+        if (strncmp(ent->d_name + entry_len - ext_len, ext, ext_len) != 0)
+            continue;
+
+        char path[FILENAME_MAX];
+        path[0] = '\0';
+        strcat(path, dirname);
+        strcat(path, "/");
+        strcat(path, ent->d_name);
+
+        char* dot = strchr(ent->d_name, '.');
+        int table_len = dot - ent->d_name;
+        int index_len = entry_len - ext_len - table_len - 1;
+        if (table_len <= 0 || index_len <= 0) {
+            printf("skipping index %s: not named after a table and an index\n", path);
+            continue;
+        }
+
+        char table_name[MAX_TAR_SIZE];
+        char index_name[MAX_TAR_SIZE];
+        snprintf(table_name, MAX_TAR_SIZE, "%.*s", table_len, ent->d_name);
+        snprintf(index_name, MAX_TAR_SIZE, "%.*s", index_len, dot + 1);
+
+        struct VdbTree* tree = vdb_treelist_get_tree(db->trees, table_name);
+        if (!tree) {
+            printf("skipping index %s: table %s does not exist\n", path, table_name);
+            continue;
+        }
+
+        int fd = open_w(path, O_RDWR, 0);
+        struct VdbIndex* index = vdbindex_open(index_name, tree->schema, db->pager, fd);
+        if (!index) {
+            printf("skipping index %s: not a vaquita index file or its columns are missing from %s\n", path, table_name);
+            close_w(fd);
+            continue;
+        }
+        vdbindexlist_append_index(tree->indexes, index);
+    }
+
     closedir_w(d);
 
     return db;
 }
 
-void vdbserver_init() {
-    server.pager = vdbpager_init();
+void vdbserver_init(uint64_t pool_size, enum VdbEvictPolicy policy, bool mmap_reads, uint32_t dirty_watermark, uint64_t sort_budget) {
+    server.pager = vdbpager_init(pool_size, policy, mmap_reads, dirty_watermark);
+    server.sort_budget = sort_budget;
     server.dbs = vdbdblist_init();
+    mtx_init(&server.lock, mtx_plain);
    
     //open current directory
     char dirname[FILENAME_MAX];
@@ -118,6 +206,7 @@ void vdbserver_init() {
 
 void vdbserver_free() {
     vdbdblist_free(server.dbs);
+    mtx_destroy(&server.lock);
     vdbpager_free(server.pager);
 }
 
@@ -164,16 +253,28 @@ struct VdbDatabase* vdbdblist_remove_db(struct VdbDatabaseList* l, const char* n
 }
 
 VDBHANDLE vdbvm_return_db(const char* name) {
+    mtx_lock(&server.lock);
     for (int i = 0; i < server.dbs->count; i++) {
         struct VdbDatabase* db = server.dbs->dbs[i];
         if (!strncmp(name, db->name, strlen(name))) {
+            db->handles++;
+            mtx_unlock(&server.lock);
             return (VDBHANDLE)db; 
         }
     }
+    mtx_unlock(&server.lock);
 
     return NULL;
 }
 
+void vdbvm_release_db(VDBHANDLE h) {
+    struct VdbDatabase* db = (struct VdbDatabase*)h;
+    mtx_lock(&server.lock);
+    assert(db->handles > 0 && "database released more times than it was opened");
+    db->handles--;
+    mtx_unlock(&server.lock);
+}
+
 void vdbvm_output_string(struct VdbByteList* bl, const char* buf, size_t size) {
     uint8_t is_tuple = 0;
     vdbbytelist_append_byte(bl, is_tuple);
@@ -267,11 +368,24 @@ static bool vdbvm_db_exists(const char* db_name) {
 
 
 enum VdbReturnCode vdbvm_drop_db(const char* name) {
+    //databases open in any connection are not dropped, so once it leaves the list nothing else can reach it
+    mtx_lock(&server.lock);
+    struct VdbDatabase* db = NULL;
+    for (int i = 0; i < server.dbs->count; i++) {
+        if (!strncmp(name, server.dbs->dbs[i]->name, strlen(name))) {
+            db = server.dbs->dbs[i];
+            break;
+        }
+    }
 
-    struct VdbDatabase* db = vdbdblist_remove_db(server.dbs, name);
-    for (int i = 0; i < db->trees->count; i++) {
-        struct VdbTree* t = db->trees->trees[i];
-        vdbvm_drop_table((VDBHANDLE)db, t->name);
+    if (!db || db->handles > 0) {
+        mtx_unlock(&server.lock);
+        return VDBRC_ERROR;
+    }
+
+    vdbdblist_remove_db(server.dbs, name);
+    while (db->trees->count > 0) {
+        vdbvm_drop_table((VDBHANDLE)db, db->trees->trees[0]->name);
     }
     vdbdb_free(db);
 
@@ -282,6 +396,7 @@ enum VdbReturnCode vdbvm_drop_db(const char* name) {
 
     DIR* d;
     if (!(d = opendir(dirname))) {
+        mtx_unlock(&server.lock);
         return VDBRC_ERROR;
     }
 
@@ -302,6 +417,7 @@ enum VdbReturnCode vdbvm_drop_db(const char* name) {
     closedir_w(d);
 
     rmdir_w(dirname);
+    mtx_unlock(&server.lock);
 
     return VDBRC_SUCCESS;
 }
@@ -317,8 +433,17 @@ enum VdbReturnCode vdbvm_drop_table(VDBHANDLE h, const char* name) {
         strcat(path, ".vdb/");
         strcat(path, tree->name);
         strcat(path, ".vtb");
+
+        //indexes are dropped with their table
+        while (tree->indexes->count > 0) {
+            struct VdbIndex* index = tree->indexes->indexes[0];
+            char index_path[FILENAME_MAX];
+            vdbvm_index_path(index_path, db->name, tree->name, index->name);
+            vdbindexlist_remove_index(tree->indexes, index->name);
+            vdbindex_close(index);
+            remove_w(index_path);
+        }
         
-        vdbpager_evict_pages(db->pager, tree->f);
         vdb_tree_close(tree);
 
         remove_w(path);
@@ -388,24 +513,46 @@ static void vdbvm_show_tabs_executor(struct VdbByteList* output, VDBHANDLE* h) {
 
 }
 
-static void vdbvm_create_db_executor(struct VdbByteList* output, struct VdbToken target) {
+static void vdbvm_create_db_executor(struct VdbByteList* output, struct VdbToken target, bool has_page_size, uint64_t requested_size) {
     char db_name[MAX_TAR_SIZE];
     vdbtoken_serialize_lexeme(db_name, target);
 
     char buf[MAX_BUF_SIZE];
 
+    uint32_t page_size = VDB_DEFAULT_PAGE_SIZE;
+    if (has_page_size) {
+        //range checked before narrowing, so sizes past 32 bits can't wrap into a valid one
+        if (requested_size > VDB_MAX_PAGE_SIZE || !vdbpager_valid_page_size((uint32_t)requested_size)) {
+            snprintf(buf, MAX_BUF_SIZE, "failed to create database %s: page size must be a power of two between %d and %d",
+                     db_name, VDB_MIN_PAGE_SIZE, VDB_MAX_PAGE_SIZE);
+            vdbvm_output_string(output, buf, strlen(buf));
+            return;
+        }
+        page_size = (uint32_t)requested_size;
+    }
+
     char dirname[FILENAME_MAX];
     dirname[0] = '\0';
     strcat(dirname, db_name);
     strcat(dirname, ".vdb");
 
+    mtx_lock(&server.lock);
     DIR* d;
     if (!(d = opendir(dirname))) {
         mkdir_w(dirname, 0777);
+
+        char hdr_path[FILENAME_MAX];
+        snprintf(hdr_path, FILENAME_MAX, "%s/%s", dirname, VDB_DB_HDR_FILE);
+        int hdr = open_w(hdr_path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+        vdbpager_write_file_hdr(hdr, page_size);
+        close_w(hdr);
+
         struct VdbDatabase* db = vdbvm_open_db(dirname);
         vdbdblist_append_db(server.dbs, db);
+        mtx_unlock(&server.lock);
     } else {
         closedir_w(d);
+        mtx_unlock(&server.lock);
         snprintf(buf, MAX_BUF_SIZE, "failed to create database %s", db_name);
         vdbvm_output_string(output, buf, strlen(buf));
         return;
@@ -420,7 +567,8 @@ static void vdbvm_create_tab_executor(struct VdbByteList* output,
                                       struct VdbToken target, 
                                       struct VdbTokenList* attrs, 
                                       struct VdbTokenList* types, 
-                                      int key_idx) {
+                                      int key_idx,
+                                      bool clustered) {
     struct VdbDatabase* db = (struct VdbDatabase*)(*h);
 
     char table_name[MAX_TAR_SIZE];
@@ -446,8 +594,8 @@ static void vdbvm_create_tab_executor(struct VdbByteList* output,
                                                types, 
                                                key_idx);
 
-    FILE* f = fopen_w(path, "w+");
-    struct VdbTree* tree = vdb_tree_init(table_name, schema, db->pager, f);
+    int fd = open_w(path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    struct VdbTree* tree = vdb_tree_init(table_name, schema, db->pager, fd, db->page_size, clustered);
     vdb_treelist_append_tree(db->trees, tree);
 
     snprintf(buf, MAX_BUF_SIZE, "created table %s", table_name);
@@ -521,7 +669,11 @@ static void vdbvm_return_db_executor(struct VdbByteList* output, VDBHANDLE* h, s
     char buf[MAX_BUF_SIZE];
 
     if (vdbvm_db_exists(db_name)) {
-        if ((*h = vdbvm_return_db(db_name))) {
+        VDBHANDLE opened;
+        if ((opened = vdbvm_return_db(db_name))) {
+            if (*h)
+                vdbvm_release_db(*h);
+            *h = opened;
             snprintf(buf, MAX_BUF_SIZE, "opened database %s", db_name);
             vdbvm_output_string(output, buf, strlen(buf));
         } else {
@@ -543,6 +695,8 @@ static void vdbvm_close_db_executor(struct VdbByteList* output, VDBHANDLE* h, st
     snprintf(buf, MAX_BUF_SIZE, "closed database %s", db_name);
     vdbvm_output_string(output, buf, strlen(buf));
 
+    if (*h)
+        vdbvm_release_db(*h);
     *h = NULL;
 }
 
@@ -572,7 +726,7 @@ static void vdbvm_describe_tab_executor(struct VdbByteList* output, VDBHANDLE* h
                 break;
             case VDBT_TYPE_TEXT:
                 type = "text";
-                len = 6;
+                len = 4;
                 break;
             case VDBT_TYPE_FLOAT8:
                 type = "float8";
@@ -606,6 +760,28 @@ static void vdbvm_describe_tab_executor(struct VdbByteList* output, VDBHANDLE* h
     vdbrecordset_free(final);
 }
 
+//frees a record built for inserting, including the dummy strings of null text columns
+static void vdbvm_free_insert_record(struct VdbSchema* schema, struct VdbRecord* rec) {
+    for (int j = 0; j < rec->count; j++) {
+        struct VdbValue* d = &rec->data[j];
+        if (d->type == VDBT_TYPE_NULL && schema->types[j] == VDBT_TYPE_TEXT) {
+            free_w(d->as.Str.start, sizeof(char) * d->as.Str.len);
+        }
+    }
+    vdbrecord_free(rec);
+}
+
+//inserts a batch of records and frees them
+static void vdbvm_insert_records(struct VdbTree* tree, struct VdbRecord** recs, uint32_t count) {
+    struct VdbCursor* cursor = vdbcursor_init(tree);
+    vdbcursor_insert_records(cursor, recs, count);
+    vdbcursor_free(cursor);
+
+    for (uint32_t i = 0; i < count; i++) {
+        vdbvm_free_insert_record(tree->schema, recs[i]);
+    }
+}
+
 static void vdbvm_insert_executor(struct VdbByteList* output, 
                                   VDBHANDLE* h, 
                                   struct VdbToken target, 
@@ -619,6 +795,7 @@ static void vdbvm_insert_executor(struct VdbByteList* output,
     struct VdbTree* tree = vdb_treelist_get_tree(db->trees, table_name);
 
     struct VdbExprList* el = vdbexprlist_init();
+    struct VdbRecord** recs = malloc_w(sizeof(struct VdbRecord*) * rec_count);
 
     for (int i = 0; i < rec_count; i++) {
         //make record
@@ -630,28 +807,16 @@ static void vdbvm_insert_executor(struct VdbByteList* output,
 
         struct VdbValue data[tree->schema->count];
         vdbvm_assign_column_values(data, tree->schema, attrs, el);
-
-        struct VdbRecord rec;
-        rec.count = tree->schema->count;
-        rec.data = data;
-     
-        struct VdbCursor* cursor = vdbcursor_init(tree);
-        vdbcursor_seek(cursor, rec.data[tree->schema->key_idx]);
-        vdbcursor_insert_record(cursor, &rec);
-        vdbcursor_free(cursor);
-
-        //free record
-        for (int i = 0; i < rec.count; i++) {
-            struct VdbValue* d = &rec.data[i];
-            if (d->type == VDBT_TYPE_TEXT) {
-                free_w(d->as.Str.start, sizeof(char) * d->as.Str.len);
-            }
-        }
+        recs[i] = vdbrecord_init(tree->schema->count, data);
 
         //reuse expression list
         el->count = 0;
     }
 
+    //all rows go in together so they can be sorted and appended in key order
+    vdbvm_insert_records(tree, recs, rec_count);
+    free_w(recs, sizeof(struct VdbRecord*) * rec_count);
+
     //not calling vdbexprlist_free(el) since the expressions will be freed when stmt is freed
     free_w(el->exprs, sizeof(struct VdbExpr*) * el->capacity);
     free_w(el, sizeof(struct VdbExprList));
@@ -661,6 +826,441 @@ static void vdbvm_insert_executor(struct VdbByteList* output,
     vdbvm_output_string(output, buf, strlen(buf));
 }
 
+//frees the strings of the first count columns parsed from a csv line
+static void vdbvm_copy_free_values(struct VdbValue* data, struct VdbSchema* schema, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (schema->types[i] == VDBT_TYPE_TEXT) {
+            free_w(data[i].as.Str.start, sizeof(char) * data[i].as.Str.len);
+        }
+    }
+}
+
+//splits a csv line into one value per schema column.  Quoted fields may contain commas and
+//doubled quotes, and empty fields are null.  Fields are unescaped in place
+static bool vdbvm_copy_parse_row(char* line, struct VdbSchema* schema, struct VdbValue* data) {
+    char* c = line;
+
+    for (uint32_t i = 0; i < schema->count; i++) {
+        if (i > 0 && *(c++) != ',') {
+            vdbvm_copy_free_values(data, schema, i);
+            return false;
+        }
+
+        char* field = c;
+        int len = 0;
+        bool quoted = *c == '"';
+        bool valid = true;
+        if (quoted) {
+            c++;
+            while (*c != '\0' && !(*c == '"' && *(c + 1) != '"')) {
+                if (*c == '"')
+                    c++;
+                field[len++] = *c++;
+            }
+            if (*c == '"') {
+                c++;
+            } else {
+                valid = false;
+            }
+        } else {
+            while (*c != ',' && *c != '\n' && *c != '\r' && *c != '\0') {
+                c++;
+                len++;
+            }
+        }
+
+        //terminate the field for the conversions below, restoring the delimiter afterwards
+        char delim = *c;
+        field[len] = '\0';
+        char* end = field + len;
+
+        if (!valid) {
+            //unterminated quote
+        } else if (len == 0 && !quoted) {
+            data[i].type = VDBT_TYPE_NULL;
+            if (schema->types[i] == VDBT_TYPE_TEXT) {
+                data[i] = vdbstring("0", 1); //same dummy string the insert statement uses
+                data[i].type = VDBT_TYPE_NULL;
+            }
+        } else {
+            switch (schema->types[i]) {
+                case VDBT_TYPE_INT8:
+                    data[i] = vdbint(strtoll(field, &end, 10));
+                    break;
+                case VDBT_TYPE_FLOAT8:
+                    data[i] = vdbfloat(strtod(field, &end));
+                    break;
+                case VDBT_TYPE_BOOL:
+                    valid = strcmp(field, "true") == 0 || strcmp(field, "false") == 0;
+                    data[i] = vdbbool(field[0] == 't');
+                    break;
+                case VDBT_TYPE_TEXT:
+                    data[i] = vdbstring(field, len);
+                    break;
+                default:
+                    assert(false && "invalid schema data type");
+                    break;
+            }
+            valid = valid && len > 0 && *end == '\0';
+            valid = valid || schema->types[i] == VDBT_TYPE_TEXT;
+        }
+
+        *c = delim;
+
+        if (!valid) {
+            vdbvm_copy_free_values(data, schema, i);
+            return false;
+        }
+    }
+
+    //more fields than columns
+    if (*c != '\n' && *c != '\r' && *c != '\0') {
+        vdbvm_copy_free_values(data, schema, schema->count);
+        return false;
+    }
+
+    return true;
+}
+
+//a copied row's key can't be null, already be in the table or repeat an earlier row's key.  Earlier
+//batches are in the table, and keys in this batch are only hashed once they stop arriving in order
+static bool vdbvm_copy_key_valid(struct VdbTree* tree, 
+                                 struct VdbCursor* cursor, 
+                                 struct VdbDistinct* batch_keys, 
+                                 bool* ascending, 
+                                 struct VdbRecord** recs, 
+                                 uint32_t batch_count, 
+                                 struct VdbRecord* rec) {
+    uint32_t key_idx = tree->schema->key_idx;
+    struct VdbValue key = rec->data[key_idx];
+    if (key.type == VDBT_TYPE_NULL)
+        return false;
+
+    bool past_largest = tree->has_largest_key && vdbvalue_compare(key, tree->largest_key) > 0;
+    if (!past_largest && vdbcursor_seek_record(cursor, key))
+        return false;
+
+    if (*ascending && batch_count > 0 && vdbvalue_compare(key, recs[batch_count - 1]->data[key_idx]) <= 0) {
+        *ascending = false;
+        for (uint32_t i = 0; i < batch_count; i++) {
+            vdbdistinct_first_seen_key(batch_keys, recs[i], key_idx);
+        }
+    }
+
+    return *ascending || vdbdistinct_first_seen_key(batch_keys, rec, key_idx);
+}
+
+static void vdbvm_copy_executor(struct VdbByteList* output, VDBHANDLE* h, struct VdbToken target, struct VdbToken path) {
+    struct VdbDatabase *db = (struct VdbDatabase*)(*h);
+    char table_name[MAX_TAR_SIZE];
+    vdbtoken_serialize_lexeme(table_name, target);
+    char buf[MAX_BUF_SIZE];
+
+    struct VdbTree* tree = vdb_treelist_get_tree(db->trees, table_name);
+    if (!tree) {
+        snprintf(buf, MAX_BUF_SIZE, "table %s does not exist", table_name);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    char filename[FILENAME_MAX];
+    snprintf(filename, FILENAME_MAX, "%.*s", path.len, path.lexeme);
+    FILE* f = fopen(filename, "r");
+    if (!f) {
+        snprintf(buf, MAX_BUF_SIZE, "failed to open file %.*s", path.len, path.lexeme);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    struct VdbRecord** recs = malloc_w(sizeof(struct VdbRecord*) * VDB_LOAD_BATCH);
+    struct VdbCursor* cursor = vdbcursor_init(tree);
+    struct VdbDistinct* batch_keys = vdbdistinct_init(); //keys in recs, once they stop arriving in order
+    bool ascending = true;
+    uint32_t batch_count = 0;
+    int copied = 0;
+    int line_num = 0;
+    bool failed = false;
+    char* line = NULL;
+    size_t line_cap = 0;
+
+    while (getline(&line, &line_cap, f) != -1) {
+        line_num++;
+        if (line[0] == '\n' || line[0] == '\r')
+            continue;
+
+        struct VdbValue data[tree->schema->count];
+        if (!vdbvm_copy_parse_row(line, tree->schema, data)) {
+            failed = true;
+            break;
+        }
+
+        struct VdbRecord* rec = vdbrecord_init(tree->schema->count, data);
+        if (!vdbvm_copy_key_valid(tree, cursor, batch_keys, &ascending, recs, batch_count, rec)) {
+            vdbvm_free_insert_record(tree->schema, rec);
+            failed = true;
+            break;
+        }
+
+        recs[batch_count++] = rec;
+        if (batch_count == VDB_LOAD_BATCH) {
+            vdbvm_insert_records(tree, recs, batch_count);
+            copied += batch_count;
+            batch_count = 0;
+            vdbdistinct_free(batch_keys);
+            batch_keys = vdbdistinct_init();
+            ascending = true;
+        }
+    }
+
+    //rows before a bad line are kept
+    vdbvm_insert_records(tree, recs, batch_count);
+    copied += batch_count;
+
+    free(line); //allocated by getline
+    vdbdistinct_free(batch_keys);
+    vdbcursor_free(cursor);
+    free_w(recs, sizeof(struct VdbRecord*) * VDB_LOAD_BATCH);
+    fclose(f);
+
+    if (failed) {
+        snprintf(buf, MAX_BUF_SIZE, "invalid row on line %d of %.*s - copied %d record(s) into %s", line_num, path.len, path.lexeme, copied, table_name);
+    } else {
+        snprintf(buf, MAX_BUF_SIZE, "copied %d record(s) into %s", copied, table_name);
+    }
+    vdbvm_output_string(output, buf, strlen(buf));
+}
+
+//rebuilds a table densely in a new file while selects keep reading the old one, then swaps
+//the new file in.  Statements that change tables are kept out until the swap is done
+static void vdbvm_vacuum_executor(struct VdbByteList* output, VDBHANDLE* h, struct VdbToken target) {
+    struct VdbDatabase *db = (struct VdbDatabase*)(*h);
+    char table_name[MAX_TAR_SIZE];
+    vdbtoken_serialize_lexeme(table_name, target);
+    char buf[MAX_BUF_SIZE];
+
+    struct VdbTree* old = vdb_treelist_get_tree(db->trees, table_name);
+    if (!old) {
+        snprintf(buf, MAX_BUF_SIZE, "table %s does not exist", table_name);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    char dirname[FILENAME_MAX];
+    char path[FILENAME_MAX];
+    char tmp_path[FILENAME_MAX];
+    dirname[0] = '\0';
+    strcat(dirname, db->name);
+    strcat(dirname, ".vdb");
+
+    path[0] = '\0';
+    strcat(path, dirname);
+    strcat(path, "/");
+    strcat(path, table_name);
+    strcat(path, ".vtb");
+
+    tmp_path[0] = '\0';
+    strcat(tmp_path, path);
+    strcat(tmp_path, ".tmp"); //not picked up as a table if the server stops before the rename
+
+    vdbrwlock_read_lock(&db->lock);
+
+    int fd = open_w(tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    struct VdbTree* tree = vdb_tree_init(table_name, old->schema, db->pager, fd, old->page_size, old->clustered);
+
+    //records come out of the scan in key order, so every batch is appended to the new tree
+    struct VdbCursor* src = vdbcursor_init(old);
+    vdbcursor_begin_scan(src);
+    struct VdbCursor* dst = vdbcursor_init(tree);
+    struct VdbRecord** recs = malloc_w(sizeof(struct VdbRecord*) * VDB_LOAD_BATCH);
+    uint32_t batch_count = 0;
+
+    while (!vdbcursor_at_end(src) || batch_count > 0) {
+        if (!vdbcursor_at_end(src)) {
+            recs[batch_count++] = vdbcursor_fetch_record(src);
+            if (batch_count < VDB_LOAD_BATCH && !vdbcursor_at_end(src))
+                continue;
+        }
+
+        vdbcursor_insert_records(dst, recs, batch_count);
+        for (uint32_t i = 0; i < batch_count; i++) {
+            vdbrecord_free(recs[i]);
+        }
+        batch_count = 0;
+    }
+
+    free_w(recs, sizeof(struct VdbRecord*) * VDB_LOAD_BATCH);
+    vdbcursor_free(dst);
+    vdbcursor_free(src);
+
+    //closing writes back every page of the new file, which must be on disk before the rename
+    vdb_tree_close(tree);
+    fd = open_w(tmp_path, O_RDWR, 0);
+    if (fsync(fd) == -1) {
+        vdbrwlock_read_unlock(&db->lock);
+        close_w(fd);
+        remove_w(tmp_path);
+        snprintf(buf, MAX_BUF_SIZE, "failed to vacuum table %s", table_name);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    vdbrwlock_read_unlock(&db->lock);
+    vdbrwlock_write_lock(&db->lock);
+
+    if (rename(tmp_path, path) == -1) {
+        vdbrwlock_write_unlock(&db->lock);
+        close_w(fd);
+        remove_w(tmp_path);
+        snprintf(buf, MAX_BUF_SIZE, "failed to vacuum table %s", table_name);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    //the new file is already in place, so the swap goes ahead - but the rename may not survive a crash
+    int dir = open_w(dirname, O_RDONLY, 0);
+    bool dir_synced = fsync(dir) == 0;
+    close_w(dir);
+
+    tree = vdb_tree_open(table_name, fd, db->pager);
+
+    //index entries point to records by primary key, so they are still valid for the new file
+    struct VdbIndexList* indexes = tree->indexes;
+    tree->indexes = old->indexes;
+    old->indexes = indexes;
+
+    vdb_treelist_replace_tree(db->trees, tree);
+    vdb_tree_close(old);
+
+    vdbrwlock_write_unlock(&db->lock);
+
+    if (dir_synced) {
+        snprintf(buf, MAX_BUF_SIZE, "vacuumed table %s", table_name);
+    } else {
+        snprintf(buf, MAX_BUF_SIZE, "vacuumed table %s, but failed to sync database %s", table_name, db->name);
+    }
+    vdbvm_output_string(output, buf, strlen(buf));
+}
+
+//table holding the named index, or NULL.  Index names are unique within a database
+static struct VdbTree* vdbvm_index_table(struct VdbDatabase* db, const char* index_name) {
+    for (int i = 0; i < db->trees->count; i++) {
+        struct VdbTree* tree = db->trees->trees[i];
+        if (vdbindexlist_get_index(tree->indexes, index_name))
+            return tree;
+    }
+
+    return NULL;
+}
+
+//builds the index from the table while selects keep reading it, and then attaches it to the
+//table.  Statements that change tables are kept out until the index is attached
+static void vdbvm_create_index_executor(struct VdbByteList* output,
+                                        VDBHANDLE* h,
+                                        struct VdbToken target,
+                                        struct VdbToken table,
+                                        struct VdbTokenList* columns,
+                                        bool hash) {
+    struct VdbDatabase *db = (struct VdbDatabase*)(*h);
+    char index_name[MAX_TAR_SIZE];
+    char table_name[MAX_TAR_SIZE];
+    vdbtoken_serialize_lexeme(index_name, target);
+    vdbtoken_serialize_lexeme(table_name, table);
+    char buf[MAX_BUF_SIZE];
+
+    struct VdbTree* tree = vdb_treelist_get_tree(db->trees, table_name);
+    if (!tree) {
+        snprintf(buf, MAX_BUF_SIZE, "table %s does not exist", table_name);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    uint32_t cols[columns->count];
+    //hash entries have a fixed size, so the primary key can't be text
+    bool valid = !vdbvm_index_table(db, index_name);
+    if (hash) {
+        valid = valid && vdbhashindex_supports_key(tree->schema->types[tree->schema->key_idx]);
+    }
+    for (int i = 0; i < columns->count && valid; i++) {
+        struct VdbToken t = columns->tokens[i];
+        cols[i] = tree->schema->count;
+        for (uint32_t j = 0; j < tree->schema->count; j++) {
+            if (strlen(tree->schema->names[j]) == (size_t)t.len && strncmp(tree->schema->names[j], t.lexeme, t.len) == 0) {
+                cols[i] = j;
+                break;
+            }
+        }
+        valid = cols[i] < tree->schema->count;
+    }
+
+    if (!valid) {
+        snprintf(buf, MAX_BUF_SIZE, "failed to create index %s", index_name);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    char path[FILENAME_MAX];
+    vdbvm_index_path(path, db->name, table_name, index_name);
+
+    vdbrwlock_read_lock(&db->lock);
+
+    int fd = open_w(path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    enum VdbIndexType type = hash ? VDBIT_HASH : VDBIT_BTREE;
+    struct VdbIndex* index = vdbindex_init(index_name, type, tree->schema, cols, columns->count, db->pager, fd, tree->page_size);
+
+    struct VdbCursor* src = vdbcursor_init(tree);
+    vdbcursor_begin_scan(src);
+    struct VdbRecord** recs = malloc_w(sizeof(struct VdbRecord*) * VDB_LOAD_BATCH);
+    uint32_t batch_count = 0;
+
+    while (!vdbcursor_at_end(src) || batch_count > 0) {
+        if (!vdbcursor_at_end(src)) {
+            recs[batch_count++] = vdbcursor_fetch_record(src);
+            if (batch_count < VDB_LOAD_BATCH && !vdbcursor_at_end(src))
+                continue;
+        }
+
+        vdbcursor_insert_index_entries(index, tree->schema, recs, batch_count);
+        for (uint32_t i = 0; i < batch_count; i++) {
+            vdbrecord_free(recs[i]);
+        }
+        batch_count = 0;
+    }
+
+    free_w(recs, sizeof(struct VdbRecord*) * VDB_LOAD_BATCH);
+    vdbcursor_free(src);
+
+    vdbrwlock_read_unlock(&db->lock);
+    vdbrwlock_write_lock(&db->lock);
+    vdbindexlist_append_index(tree->indexes, index);
+    vdbrwlock_write_unlock(&db->lock);
+
+    snprintf(buf, MAX_BUF_SIZE, "created index %s", index_name);
+    vdbvm_output_string(output, buf, strlen(buf));
+}
+
+static void vdbvm_drop_index_executor(struct VdbByteList* output, VDBHANDLE* h, struct VdbToken target) {
+    struct VdbDatabase *db = (struct VdbDatabase*)(*h);
+    char index_name[MAX_TAR_SIZE];
+    vdbtoken_serialize_lexeme(index_name, target);
+    char buf[MAX_BUF_SIZE];
+
+    struct VdbTree* tree = vdbvm_index_table(db, index_name);
+    if (!tree) {
+        snprintf(buf, MAX_BUF_SIZE, "failed to drop index %s", index_name);
+        vdbvm_output_string(output, buf, strlen(buf));
+        return;
+    }
+
+    char path[FILENAME_MAX];
+    vdbvm_index_path(path, db->name, tree->name, index_name);
+
+    vdbindex_close(vdbindexlist_remove_index(tree->indexes, index_name));
+    remove_w(path);
+
+    snprintf(buf, MAX_BUF_SIZE, "dropped index %s", index_name);
+    vdbvm_output_string(output, buf, strlen(buf));
+}
+
 static void vdbvm_update_executor(struct VdbByteList* output, 
                                   VDBHANDLE* h, 
                                   struct VdbToken target, 
@@ -673,10 +1273,13 @@ static void vdbvm_update_executor(struct VdbByteList* output,
     vdbtoken_serialize_lexeme(table_name, target);
     struct VdbTree* tree = vdb_treelist_get_tree(db->trees, table_name);
     struct VdbCursor* cursor = vdbcursor_init(tree);
+    struct VdbKeyRange range;
+    vdbindex_plan_key_range(tree->schema, selection, &range);
+    vdbcursor_begin_range_scan(cursor, &range);
 
     int updated_count = 0;
 
-    while (!vdbcursor_at_end(cursor)) {
+    while (!vdbcursor_range_done(cursor, &range)) {
         if (vdbcursor_record_passes_selection(cursor, selection)) {
             vdbcursor_update_record(cursor, attrs, values);
             updated_count++;
@@ -689,6 +1292,7 @@ static void vdbvm_update_executor(struct VdbByteList* output,
     char buf[MAX_BUF_SIZE];
     snprintf(buf, MAX_BUF_SIZE, "%d row(s) updated", updated_count);
     vdbvm_output_string(output, buf, strlen(buf));
+    vdbkeyrange_free(&range);
     vdbcursor_free(cursor);
 }
 
@@ -698,10 +1302,13 @@ static void vdbvm_delete_executor(struct VdbByteList* output, VDBHANDLE* h, stru
     vdbtoken_serialize_lexeme(table_name, target);
     struct VdbTree* tree = vdb_treelist_get_tree(db->trees, table_name);
     struct VdbCursor* cursor = vdbcursor_init(tree);
+    struct VdbKeyRange range;
+    vdbindex_plan_key_range(tree->schema, selection, &range);
+    vdbcursor_begin_range_scan(cursor, &range);
 
     int deleted_count = 0;
 
-    while (!vdbcursor_at_end(cursor)) {
+    while (!vdbcursor_range_done(cursor, &range)) {
         if (vdbcursor_record_passes_selection(cursor, selection)) {
             vdbcursor_delete_record(cursor);
             deleted_count++;
@@ -715,6 +1322,7 @@ static void vdbvm_delete_executor(struct VdbByteList* output, VDBHANDLE* h, stru
     snprintf(buf, MAX_BUF_SIZE, "%d row(s) deleted", deleted_count);
     vdbvm_output_string(output, buf, strlen(buf));
 
+    vdbkeyrange_free(&range);
     vdbcursor_free(cursor);
 }
 
@@ -786,72 +1394,95 @@ static void vdbvm_select_executor(struct VdbByteList* output,
     struct VdbTree* tree = vdb_treelist_get_tree(db->trees, table_name);
     struct VdbCursor* cursor = vdbcursor_init(tree);
 
-    struct VdbHashTable* grouping_table = vdbhashtable_init();
-
-    struct VdbRecordSet* head = NULL;
-
-    while (!vdbcursor_at_end(cursor)) {
-        struct VdbRecord* rec = vdbcursor_fetch_record(cursor);
-        struct VdbRecordSet* rs = vdbrecordset_init(NULL);
-        vdbrecordset_append_record(rs, rec);
-
-        //grouping (will apply 'having' clause later)
-        if (grouping->count > 0) {
-            //not applying selection if 'group by' is used
-            //will apply 'having' clause later after aggregates can be applied to entire group
-            struct VdbByteList* key = vdbcursor_key_from_cols(cursor, rs, grouping);
-            //TODO: freeing recordset rs since it's not used, but kinda messy
-            free_w(rs->records, sizeof(struct VdbRecord*) * rs->capacity);
-            free_w(rs, sizeof(struct VdbRecordSet));
-            vdbhashtable_insert_entry(grouping_table, key, rec);
-
-            continue;
-        }
+    //'group by' doesn't apply the selection, so it always needs every record.  Records are read
+    //through an index only if it narrows the scan more than the bounds on the primary key
+    struct VdbKeyRange key_range;
+    struct VdbIndexRange range;
+    struct VdbIndex* index = NULL;
+    struct VdbIndexCursor* index_cursor = NULL;
+    if (grouping->count == 0) {
+        uint32_t key_score = vdbindex_plan_key_range(tree->schema, selection, &key_range);
+        index = vdbindex_plan(tree->indexes, tree->schema, selection, key_score, &range);
+    } else {
+        vdbindex_plan_key_range(tree->schema, NULL, &key_range);
+    }
 
-        //does not pass selection criteria
-        if (!vdbcursor_apply_selection(cursor, rs, selection)) {
-            vdbrecordset_free(rs);
-            continue;
+    //the limit counts the column names as a row
+    bool has_limit = false;
+    uint64_t limit_rows = 0;
+    if (limit) {
+        struct VdbValue n = vdbexpr_eval(limit, NULL, tree->schema);
+        if (n.type == VDBT_TYPE_INT8 && n.as.Int >= 0) {
+            has_limit = true;
+            limit_rows = n.as.Int;
         }
+        vdbvalue_free(n);
+    }
 
-        //not grouped, and where clause evaulates to true
-        rs->next = head;
-        head = rs;
+    //simple 'where' clauses on a table scan are checked in batches, before the records are built
+    struct VdbPredicate* predicate = NULL;
+    if (!index && grouping->count == 0 && selection) {
+        predicate = vdbpredicate_compile(selection, tree->schema);
+    }
 
+    struct VdbOperator* op;
+    if (index) {
+        index_cursor = vdbindexcursor_init(index, &range);
+        op = vdboperator_index_scan(cursor, index_cursor);
+    } else if (predicate) {
+        op = vdboperator_batch_scan(cursor, &key_range, predicate);
+    } else {
+        op = vdboperator_scan(cursor, &key_range);
     }
 
-    //TODO: should not manually use hash table internals like this - error prone.  Should be done with hashtable interface
     if (grouping->count > 0) {
-        for (int i = 0; i < VDB_MAX_BUCKETS; i++) {
-            struct VdbRecordSet* cur = grouping_table->entries[i];
-            while (cur) {
-                //eval 'having' clause, and only insert into bt if true
-                struct VdbRecordSet* cached_next = cur->next;
-                if (vdbcursor_apply_having(cursor, cur, having)) {
-                    cur->next = head;
-                    head = cur;
-                }
-                cur = cached_next;
+        op = vdboperator_group(op, grouping, having, ordering, order_desc, projection);
+    } else {
+        if (!predicate) {
+            op = vdboperator_filter(op, selection);
+        }
+
+        //a table scan already returns records in key order, so only 'order by' and index scans need sorting.
+        //'limit' applies after 'distinct', so only keeps the first n records if there are no duplicates to drop
+        if (ordering->count > 0 || index) {
+            if (has_limit && !distinct) {
+                op = vdboperator_topn(op, ordering, order_desc, limit_rows > UINT32_MAX ? UINT32_MAX : (uint32_t)limit_rows);
+            } else {
+                op = vdboperator_sort(op, ordering, order_desc, server.sort_budget);
             }
         }
     }
 
-    vdbcursor_sort_linked_list(cursor, &head, ordering, order_desc);
-
-    //apply projections to each recordset in linked-list, and return final single recordset
-    struct VdbRecordSet* final = vdbcursor_apply_projection(cursor, head, projection, grouping->count > 0);
+    op = vdboperator_project(op, projection);
 
     if (distinct) {
-        final = vdbrecordset_remove_duplicates(final);
+        op = vdboperator_distinct(op);
     }
 
+    if (has_limit) {
+        op = vdboperator_limit(op, limit_rows > 0 ? limit_rows - 1 : 0);
+    }
+
+    struct VdbRecordSet* final = vdbcursor_projection_header(cursor, projection);
+    struct VdbRecord* rec;
+    while ((rec = vdboperator_next(op))) {
+        vdbrecordset_append_record(final, rec);
+    }
+
+    vdboperator_free(op);
+
+    //drops the column names too if the limit is 0
     vdbcursor_apply_limit(cursor, final, limit);
 
     vdbrecordset_serialize(final, output);
 
+    if (index) {
+        vdbindexcursor_free(index_cursor);
+        vdbindexrange_free(&range);
+    }
+    vdbkeyrange_free(&key_range);
     vdbcursor_free(cursor);
     vdbrecordset_free(final);
-    vdbhashtable_free(grouping_table);
 }
 
 static void vdbvm_exit_executor(struct VdbByteList* output, VDBHANDLE* h) {
@@ -879,69 +1510,138 @@ enum VdbReturnCode vdbvm_execute_stmts(VDBHANDLE* h,
             case VDBST_SHOW_DBS:
                 vdbvm_show_dbs_executor(output);
                 break;
-            case VDBST_SHOW_TABS:
+            case VDBST_SHOW_TABS: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                vdbrwlock_read_lock(&db->lock);
                 vdbvm_show_tabs_executor(output, h);
+                vdbrwlock_read_unlock(&db->lock);
                 break;
+            }
             case VDBST_CREATE_DB:
-                vdbvm_create_db_executor(output, stmt->target);
+                vdbvm_create_db_executor(output, stmt->target, stmt->as.create_db.has_page_size, stmt->as.create_db.page_size);
                 break;
-            case VDBST_CREATE_TAB:
+            case VDBST_CREATE_TAB: {
+                //the table list may be reallocated, so selects walking it are kept out
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
                 vdbvm_create_tab_executor(output, h, 
                                           stmt->target, 
                                           stmt->as.create.attributes, 
                                           stmt->as.create.types, 
-                                          stmt->as.create.key_idx);
+                                          stmt->as.create.key_idx,
+                                          stmt->as.create.clustered);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
                 break;
+            }
             case VDBST_IF_EXISTS_DROP_DB: 
                 vdbvm_if_exists_drop_db_executor(output, stmt->target);
                 break;
-            case VDBST_IF_EXISTS_DROP_TAB:
+            case VDBST_IF_EXISTS_DROP_TAB: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
                 vdbvm_if_exists_drop_tab_executor(output, h, stmt->target);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
                 break;
+            }
             case VDBST_DROP_DB:
                 vdbvm_drop_db_executor(output, stmt->target);
                 break;
-            case VDBST_DROP_TAB:
+            case VDBST_DROP_TAB: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
                 vdbvm_drop_tab_executor(output, h, stmt->target);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
                 break;
+            }
             case VDBST_OPEN:
                 vdbvm_return_db_executor(output, h, stmt->target);
                 break;
             case VDBST_CLOSE:
                 vdbvm_close_db_executor(output, h, stmt->target);
                 break;
-            case VDBST_DESCRIBE:
+            case VDBST_DESCRIBE: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                vdbrwlock_read_lock(&db->lock);
                 vdbvm_describe_tab_executor(output, h, stmt->target);
+                vdbrwlock_read_unlock(&db->lock);
                 break;
+            }
             case VDBST_INSERT: {
                 struct VdbDatabase* db = (struct VdbDatabase*)(*h);
-                mtx_lock(&db->lock);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
                 vdbvm_insert_executor(output, h, stmt->target, 
                                          stmt->as.insert.attributes, 
                                          stmt->as.insert.values);
-                mtx_unlock(&db->lock);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
+                break;
+            }
+            case VDBST_COPY: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
+                vdbvm_copy_executor(output, h, stmt->target, stmt->as.copy.path);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
+                break;
+            }
+            case VDBST_VACUUM: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                mtx_lock(&db->write_lock);
+                vdbvm_vacuum_executor(output, h, stmt->target);
+                mtx_unlock(&db->write_lock);
+                break;
+            }
+            case VDBST_CREATE_INDEX: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                mtx_lock(&db->write_lock);
+                vdbvm_create_index_executor(output, h, stmt->target,
+                                            stmt->as.create_index.table,
+                                            stmt->as.create_index.columns,
+                                            stmt->as.create_index.hash);
+                mtx_unlock(&db->write_lock);
+                break;
+            }
+            case VDBST_DROP_INDEX: {
+                struct VdbDatabase* db = (struct VdbDatabase*)(*h);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
+                vdbvm_drop_index_executor(output, h, stmt->target);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
                 break;
             }
             case VDBST_UPDATE: {
                 struct VdbDatabase* db = (struct VdbDatabase*)(*h);
-                mtx_lock(&db->lock);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
                 vdbvm_update_executor(output, h, stmt->target, 
                                          stmt->as.update.attributes, 
                                          stmt->as.update.values, 
                                          stmt->as.update.selection);
-                mtx_unlock(&db->lock);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
                 break;
             }
             case VDBST_DELETE: {
                 struct VdbDatabase* db = (struct VdbDatabase*)(*h);
-                mtx_lock(&db->lock);
+                mtx_lock(&db->write_lock);
+                vdbrwlock_write_lock(&db->lock);
                 vdbvm_delete_executor(output, h, stmt->target, stmt->as.delete.selection);
-                mtx_unlock(&db->lock);
+                vdbrwlock_write_unlock(&db->lock);
+                mtx_unlock(&db->write_lock);
                 break;
             }
             case VDBST_SELECT: {
                 struct VdbDatabase* db = (struct VdbDatabase*)(*h);
-                mtx_lock(&db->lock);
+                vdbrwlock_read_lock(&db->lock);
 
                 if (vdbinterp_select_process(h, stmt)) {
                     vdbvm_select_executor(output, h, stmt->target, 
@@ -957,7 +1657,7 @@ enum VdbReturnCode vdbvm_execute_stmts(VDBHANDLE* h,
                     vdberrorlist_append_error(*errors, 1, "select stmt error");
                 }
 
-                mtx_unlock(&db->lock);
+                vdbrwlock_read_unlock(&db->lock);
                 break;
             }
             case VDBST_EXIT:
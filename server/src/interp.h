@@ -4,6 +4,8 @@
 #include <threads.h>
 
 #include "parser.h"
+#include "pager.h"
+#include "util.h"
 
 typedef void* VDBHANDLE;
 
@@ -11,7 +13,10 @@ struct VdbDatabase {
     char* name;
     struct VdbPager* pager;
     struct VdbTreeList* trees;
-    mtx_t lock;
+    uint32_t page_size; //used for new tables, read from the database header file
+    struct VdbRWLock lock; //shared by selects, held exclusively by statements that change tables
+    mtx_t write_lock; //taken before lock by statements that change tables, so vacuum can keep them out while selects run
+    uint32_t handles; //connections that have the database open, guarded by the server lock
 };
 
 struct VdbDatabaseList {
@@ -23,14 +28,17 @@ struct VdbDatabaseList {
 struct VdbServer {
     struct VdbPager* pager;
     struct VdbDatabaseList* dbs;
+    uint64_t sort_budget; //bytes of records each sort holds before spilling to temp files
+    mtx_t lock; //guards dbs and the handle count of each database
 };
 
-void vdbserver_init();
+void vdbserver_init(uint64_t pool_size, enum VdbEvictPolicy policy, bool mmap_reads, uint32_t dirty_watermark, uint64_t sort_budget);
 void vdbserver_free();
 
 struct VdbDatabaseList *vdbdblist_init();
 void vdbdblist_free(struct VdbDatabaseList* l);
 void vdbdblist_append_db(struct VdbDatabaseList* l, struct VdbDatabase* d);
+void vdbvm_release_db(VDBHANDLE h);
 void vdbvm_output_string(struct VdbByteList* bl, const char* buf, size_t size);
 
 enum VdbReturnCode vdbvm_execute_stmts(VDBHANDLE* h, struct VdbStmtList* sl, struct VdbByteList* output, bool* end, struct VdbErrorList** errors);
@@ -132,8 +132,12 @@ enum VdbReturnCode vdblexer_read_word(struct VdbLexer* lexer, struct VdbToken* t
         case 'c':
             if (t->len == 5 && strncmp("close", t->lexeme, 5) == 0)
                 t->type = VDBT_CLOSE;
+            if (t->len == 9 && strncmp("clustered", t->lexeme, 9) == 0)
+                t->type = VDBT_CLUSTERED;
             if (t->len == 6 && strncmp("commit", t->lexeme, 6) == 0)
                 t->type = VDBT_COMMIT;
+            if (t->len == 4 && strncmp("copy", t->lexeme, 4) == 0)
+                t->type = VDBT_COPY;
             if (t->len == 5 && strncmp("count", t->lexeme, 5) == 0)
                 t->type = VDBT_COUNT;
             if (t->len == 6 && strncmp("create", t->lexeme, 6) == 0)
@@ -174,6 +178,8 @@ enum VdbReturnCode vdblexer_read_word(struct VdbLexer* lexer, struct VdbToken* t
                 t->type = VDBT_GROUP;
             break;
         case 'h':
+            if (t->len == 4 && strncmp("hash", t->lexeme, 4) == 0)
+                t->type = VDBT_HASH;
             if (t->len == 6 && strncmp("having", t->lexeme, 6) == 0)
                 t->type = VDBT_HAVING;
             break;
@@ -188,6 +194,8 @@ enum VdbReturnCode vdblexer_read_word(struct VdbLexer* lexer, struct VdbToken* t
                 t->type = VDBT_IF;
             if (t->len == 2 && strncmp("is", t->lexeme, 2) == 0)
                 t->type = VDBT_IS;
+            if (t->len == 5 && strncmp("index", t->lexeme, 5) == 0)
+                t->type = VDBT_INDEX;
             break;
         case 'k':
             if (t->len == 3 && strncmp("key", t->lexeme, 3) == 0)
@@ -216,6 +224,12 @@ enum VdbReturnCode vdblexer_read_word(struct VdbLexer* lexer, struct VdbToken* t
                 t->type = VDBT_OR;
             if (t->len == 5 && strncmp("order", t->lexeme, 5) == 0)
                 t->type = VDBT_ORDER;
+            if (t->len == 2 && strncmp("on", t->lexeme, 2) == 0)
+                t->type = VDBT_ON;
+            break;
+        case 'p':
+            if (t->len == 9 && strncmp("page_size", t->lexeme, 9) == 0)
+                t->type = VDBT_PAGE_SIZE;
             break;
         case 'r':
             if (t->len == 8 && strncmp("rollback", t->lexeme, 8) == 0)
@@ -248,6 +262,8 @@ enum VdbReturnCode vdblexer_read_word(struct VdbLexer* lexer, struct VdbToken* t
         case 'v':
             if (t->len == 6 && strncmp("values", t->lexeme, 6) == 0)
                 t->type = VDBT_VALUES;
+            if (t->len == 6 && strncmp("vacuum", t->lexeme, 6) == 0)
+                t->type = VDBT_VACUUM;
             break;
         case 'w':
             if (t->len == 5 && strncmp("where", t->lexeme, 5) == 0)
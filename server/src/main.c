@@ -18,6 +18,9 @@
 #define BACKLOG 10
 //end network stuff
 
+#define VDB_DEFAULT_POOL_SIZE (64 * 1024 * 1024)
+#define VDB_DEFAULT_SORT_BUDGET (64 * 1024 * 1024)
+
 #include "lexer.h"
 #include "parser.h"
 #include "interp.h"
@@ -240,6 +243,10 @@ void vdbtcp_handle_client(struct VdbThreadContext* c) {
             break;
         }
     }
+
+    //a database left open by exit or a dropped connection can be dropped again once released
+    if (h)
+        vdbvm_release_db(h);
 }
 
 int vdbtcp_handle_client_thread(void* args) {
@@ -281,20 +288,75 @@ int vdbtcp_serve(const char* port) {
     return 0;
 }
 
+//parses sizes such as '4096', '512k', '64m' or '1g'
+static bool vdbserver_parse_size(const char* s, uint64_t* size) {
+    char* end;
+    unsigned long long n = strtoull(s, &end, 10);
+    if (end == s)
+        return false;
+
+    switch (*end) {
+        case 'k': case 'K': n *= 1024ull; end++; break;
+        case 'm': case 'M': n *= 1024ull * 1024ull; end++; break;
+        case 'g': case 'G': n *= 1024ull * 1024ull * 1024ull; end++; break;
+        default: break;
+    }
+
+    *size = n;
+    return *end == '\0' && n > 0;
+}
+
+static void vdbserver_usage() {
+    printf("usage: vdb -p [port number] -b [buffer pool size in bytes, eg 64m] -e [clock | lruk] -m -w [dirty page watermark, percent of pool] -s [sort memory in bytes, eg 64m]\n");
+    exit(1);
+}
+
 int main(int argc, char** argv) {
     int opt;
     bool set_port = false;
     char* port_arg;
+    uint64_t pool_size = VDB_DEFAULT_POOL_SIZE;
+    enum VdbEvictPolicy policy = VDBEP_CLOCK;
+    bool mmap_reads = false;
+    uint32_t dirty_watermark = VDB_DEFAULT_DIRTY_WATERMARK;
+    uint64_t sort_budget = VDB_DEFAULT_SORT_BUDGET;
 
-    while ((opt = getopt(argc, argv, "p:")) != -1) {
+    while ((opt = getopt(argc, argv, "p:b:e:mw:s:")) != -1) {
         switch (opt) {
             case 'p':
                 set_port = true;
                 port_arg = optarg;
                 break;
+            case 'b':
+                if (!vdbserver_parse_size(optarg, &pool_size))
+                    vdbserver_usage();
+                break;
+            case 'e':
+                if (strcmp(optarg, "clock") == 0) {
+                    policy = VDBEP_CLOCK;
+                } else if (strcmp(optarg, "lruk") == 0) {
+                    policy = VDBEP_LRUK;
+                } else {
+                    vdbserver_usage();
+                }
+                break;
+            case 'm':
+                mmap_reads = true;
+                break;
+            case 'w': {
+                char* end;
+                unsigned long n = strtoul(optarg, &end, 10);
+                if (end == optarg || *end != '\0' || n == 0 || n > 100)
+                    vdbserver_usage();
+                dirty_watermark = (uint32_t)n;
+                break;
+            }
+            case 's':
+                if (!vdbserver_parse_size(optarg, &sort_budget))
+                    vdbserver_usage();
+                break;
             default:
-                printf("usage: vdb -p [port number]\n");
-                exit(1);
+                vdbserver_usage();
                 break;
         }
     }
@@ -303,7 +365,7 @@ int main(int argc, char** argv) {
         port_arg = "3333";
     }
 
-    vdbserver_init();
+    vdbserver_init(pool_size, policy, mmap_reads, dirty_watermark, sort_budget);
     vdbtcp_serve(port_arg);
     vdbserver_free();
 
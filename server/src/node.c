@@ -10,7 +10,7 @@
 
 /*
  * Meta node de/serialization
- * [type|parent_idx|pk_counter|root_idx|schema_off|data_block_idx|last_leaf_idx|largest_key...|...|...schema]
+ * [type|parent_idx|pk_counter|root_idx|schema_off|data_block_idx|last_leaf_idx|free_page_idx|clustered|...|...schema]
  */
 
 uint32_t* vdbmeta_auto_counter_ptr(uint8_t* buf) {
@@ -21,8 +21,8 @@ uint32_t* vdbmeta_root_ptr(uint8_t* buf) {
     return (uint32_t*)(buf + sizeof(uint32_t) * 3);
 }
 
-void vdbmeta_allocate_schema_ptr(uint8_t* buf, uint32_t size) {
-    *((uint32_t*)(buf + sizeof(uint32_t) * 4)) = VDB_PAGE_SIZE - size;
+void vdbmeta_allocate_schema_ptr(uint8_t* buf, uint32_t page_size, uint32_t size) {
+    *((uint32_t*)(buf + sizeof(uint32_t) * 4)) = page_size - size;
 }
 
 uint32_t* vdbmeta_data_block_ptr(uint8_t* buf) {
@@ -33,8 +33,14 @@ uint32_t* vdbmeta_last_leaf(uint8_t* buf) {
     return (uint32_t*)(buf + sizeof(uint32_t) * 6);
 }
 
-void* vdbmeta_largest_key(uint8_t* buf) {
-    return (void*)(buf + sizeof(uint32_t) * 7);
+//head of the list of free pages in the file, 0 if there are none
+uint32_t* vdbmeta_freelist_ptr(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 7);
+}
+
+//non-zero if leaves hold whole records rather than pointers into data blocks
+uint32_t* vdbmeta_clustered_ptr(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 8);
 }
 
 void* vdbmeta_schema_ptr(uint8_t* buf) {
@@ -44,16 +50,71 @@ void* vdbmeta_schema_ptr(uint8_t* buf) {
 }
 
 /*
- * Internal node de/serialization
- * [type|parent_idx|next|idxcell count|datacells size|right ptr block|right ptr key| ... |index cells...datacells]
+ * Hash index meta node de/serialization - the schema offset is where the tree meta node keeps
+ * it, so vdbmeta_allocate_schema_ptr and vdbmeta_schema_ptr work on both
+ * [type|parent_idx|level|split|schema_off|entry count|free page idx|directory count|directory idxs...|...schema]
  */
 
-uint32_t* vdbintern_rightptr_block(uint8_t* buf) {
+uint32_t* vdbhashmeta_level_ptr(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 2);
+}
+
+//next bucket to split in the current level
+uint32_t* vdbhashmeta_split_ptr(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 3);
+}
+
+uint32_t* vdbhashmeta_entry_count_ptr(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 5);
+}
+
+uint32_t* vdbhashmeta_freelist_ptr(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 6);
+}
+
+uint32_t* vdbhashmeta_dir_count_ptr(uint8_t* buf) {
     return (uint32_t*)(buf + sizeof(uint32_t) * 7);
 }
 
-void* vdbintern_rightptr_key(uint8_t* buf) {
-    return (void*)(buf + sizeof(uint32_t) * 8);
+//indices of the directory nodes, in bucket order
+uint32_t* vdbhashmeta_dirs(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 8);
+}
+
+//directory indices that fit before the schema
+uint32_t vdbhashmeta_dir_capacity(uint8_t* buf) {
+    uint32_t off = *((uint32_t*)(buf + sizeof(uint32_t) * 4));
+    return (off - sizeof(uint32_t) * 8) / sizeof(uint32_t);
+}
+
+/*
+ * Hash index directory node de/serialization - page indices of the first page of each bucket
+ * [type|parent_idx| ... |bucket idxs...]
+ */
+
+uint32_t* vdbhashdir_buckets(uint8_t* buf) {
+    return (uint32_t*)(buf + VDB_PAGE_HDR_SIZE);
+}
+
+uint32_t vdbhashdir_capacity(uint32_t page_size) {
+    return (page_size - VDB_PAGE_HDR_SIZE) / sizeof(uint32_t);
+}
+
+/*
+ * Bucket node de/serialization - uses the shared node layout, with next linking the overflow
+ * pages of the bucket
+ * [type|parent_idx|next|idxcell count|datacells size|idxcells freelist|datacells freelist| ... |index cells...datacells]
+ * datacells are [hash|primary key]
+ */
+
+/*
+ * Internal node de/serialization
+ * [type|parent_idx|next|idxcell count|datacells size|idxcells freelist|datacells freelist|right ptr block| ... |index cells...datacells]
+ * datacells are [block_idx|separator key]
+ */
+
+uint32_t* vdbintern_rightptr_block(uint8_t* buf) {
+    return (uint32_t*)(buf + sizeof(uint32_t) * 7);
 }
 
 /* 
@@ -61,6 +122,24 @@ void* vdbintern_rightptr_key(uint8_t* buf) {
  * [type|parent_idx|record count|datacells size|next leaf idx| ... |index cells ... datacells]
  */
 
+/*
+ * Free page de/serialization
+ * [type|parent_idx|next free page idx| ... ]
+ */
+
+/*
+ * Overflow page de/serialization - holds part of a string too long for a data block
+ * [type|parent_idx|next overflow page idx|string bytes ...]
+ */
+
+uint8_t* vdboverflow_data(uint8_t* buf) {
+    return buf + sizeof(uint32_t) * 3;
+}
+
+uint32_t vdboverflow_capacity(uint32_t page_size) {
+    return page_size - sizeof(uint32_t) * 3;
+}
+
 /*
  * Shared node functions
  * [type|parent_idx|next|idxcell count|datacells size|<block specific header data> ... |index cells...datacells]
@@ -94,16 +173,16 @@ uint32_t* vdbnode_datacells_freelist(uint8_t* buf) {
     return (uint32_t*)(buf + sizeof(uint32_t) * 6);
 }
 
-bool vdbnode_can_fit(uint8_t* buf, uint32_t datacell_size) {
+bool vdbnode_can_fit(uint8_t* buf, uint32_t page_size, uint32_t datacell_size) {
     uint32_t used_size = *vdbnode_idxcell_count(buf) * sizeof(uint32_t) + *vdbnode_datacells_size(buf);
     uint32_t idxcell_size = sizeof(uint32_t);
     uint32_t datacell_header_size = sizeof(uint32_t) * 2; //next and size fields
-    return VDB_PAGE_SIZE - VDB_PAGE_HDR_SIZE >= datacell_size + idxcell_size + datacell_header_size + used_size;
+    return page_size - VDB_PAGE_HDR_SIZE >= datacell_size + idxcell_size + datacell_header_size + used_size;
 }
 
 //reuses free idxcell or appends a new one
-uint32_t vdbnode_new_idxcell(uint8_t* buf, uint32_t datacell_size) {
-    assert(vdbnode_can_fit(buf, datacell_size) && "node must be able to fit data");
+uint32_t vdbnode_new_idxcell(uint8_t* buf, uint32_t page_size, uint32_t datacell_size) {
+    assert(vdbnode_can_fit(buf, page_size, datacell_size) && "node must be able to fit data");
 
     uint32_t new_idx;
     if (*vdbnode_idxcells_freelist(buf) == 0) {
@@ -116,7 +195,7 @@ uint32_t vdbnode_new_idxcell(uint8_t* buf, uint32_t datacell_size) {
     (*vdbnode_datacells_size(buf)) += datacell_size + sizeof(uint32_t) * 2; //next and size fields
 
     uint32_t idxcell_off = VDB_PAGE_HDR_SIZE + new_idx * sizeof(uint32_t);
-    *((uint32_t*)(buf + idxcell_off)) = VDB_PAGE_SIZE - *vdbnode_datacells_size(buf);
+    *((uint32_t*)(buf + idxcell_off)) = page_size - *vdbnode_datacells_size(buf);
 
     int data_off = *((uint32_t*)(buf + idxcell_off));
     *((uint32_t*)(buf + data_off + sizeof(uint32_t))) = datacell_size;
@@ -124,9 +203,9 @@ uint32_t vdbnode_new_idxcell(uint8_t* buf, uint32_t datacell_size) {
     return new_idx;
 }
 
-void vdbnode_insert_idxcell(uint8_t* buf, uint32_t idxcell_idx, uint32_t datacell_size) {
-    assert(vdbnode_can_fit(buf, datacell_size) && "node must be able to fit data");
-    assert(*vdbnode_idxcell_freelist(buf) == 0 && "cannot use 'vdbnode_insert_idxcell' when idxcells are fragmented");
+void vdbnode_insert_idxcell(uint8_t* buf, uint32_t page_size, uint32_t idxcell_idx, uint32_t datacell_size) {
+    assert(vdbnode_can_fit(buf, page_size, datacell_size) && "node must be able to fit data");
+    assert(*vdbnode_idxcells_freelist(buf) == 0 && "cannot use 'vdbnode_insert_idxcell' when idxcells are fragmented");
 
     uint8_t* src = buf + VDB_PAGE_HDR_SIZE + idxcell_idx * sizeof(uint32_t);
     uint8_t* dst = src + sizeof(uint32_t);
@@ -134,7 +213,7 @@ void vdbnode_insert_idxcell(uint8_t* buf, uint32_t idxcell_idx, uint32_t datacel
     memmove(dst, src, size);
 
     *vdbnode_datacells_size(buf) += datacell_size + sizeof(uint32_t) * 2; //next and size fields
-    *((uint32_t*)(buf + VDB_PAGE_HDR_SIZE + idxcell_idx * sizeof(uint32_t))) = VDB_PAGE_SIZE - *vdbnode_datacells_size(buf);
+    *((uint32_t*)(buf + VDB_PAGE_HDR_SIZE + idxcell_idx * sizeof(uint32_t))) = page_size - *vdbnode_datacells_size(buf);
 
     (*vdbnode_idxcell_count(buf))++;
 
@@ -143,6 +222,74 @@ void vdbnode_insert_idxcell(uint8_t* buf, uint32_t idxcell_idx, uint32_t datacel
     *((uint32_t*)(buf + data_off + sizeof(uint32_t))) = datacell_size;
 }
 
+uint32_t vdbnode_datacell_size(uint8_t* buf, uint32_t idxcell_idx) {
+    int off = VDB_PAGE_HDR_SIZE + idxcell_idx * sizeof(uint32_t);
+    int data_off = *((uint32_t*)(buf + off));
+
+    return *((uint32_t*)(buf + data_off + sizeof(uint32_t)));
+}
+
+//size taken by idxcells and datacells, not counting the page header
+uint32_t vdbnode_used_size(uint8_t* buf) {
+    return *vdbnode_idxcell_count(buf) * sizeof(uint32_t) + *vdbnode_datacells_size(buf);
+}
+
+//keeps only cells [from, to) in buf, repacked so its datacells stay contiguous
+static void vdbnode_keep_cells(uint8_t* buf, uint32_t page_size, uint32_t from, uint32_t to) {
+    uint8_t old[page_size];
+    memcpy(old, buf, page_size);
+    *vdbnode_idxcell_count(buf) = 0;
+    *vdbnode_datacells_size(buf) = 0;
+
+    for (uint32_t i = from; i < to; i++) {
+        uint32_t size = vdbnode_datacell_size(old, i);
+        uint32_t new_idx = vdbnode_new_idxcell(buf, page_size, size);
+        memcpy(vdbnode_datacell(buf, new_idx), vdbnode_datacell(old, i), size);
+    }
+}
+
+//moves cells from idxcell 'from' onwards to the end of dst, keeping their order.  The
+//cells left in src are repacked so its datacells stay contiguous
+void vdbnode_move_cells(uint8_t* src, uint8_t* dst, uint32_t page_size, uint32_t from) {
+    assert(*vdbnode_idxcells_freelist(src) == 0 && "cannot move cells when idxcells are fragmented");
+    uint32_t count = *vdbnode_idxcell_count(src);
+
+    for (uint32_t i = from; i < count; i++) {
+        uint32_t size = vdbnode_datacell_size(src, i);
+        uint32_t new_idx = vdbnode_new_idxcell(dst, page_size, size);
+        memcpy(vdbnode_datacell(dst, new_idx), vdbnode_datacell(src, i), size);
+    }
+
+    vdbnode_keep_cells(src, page_size, 0, from);
+}
+
+//moves cells from idxcell 'from' onwards to the front of dst, keeping their order
+void vdbnode_move_cells_to_front(uint8_t* src, uint8_t* dst, uint32_t page_size, uint32_t from) {
+    assert(*vdbnode_idxcells_freelist(src) == 0 && "cannot move cells when idxcells are fragmented");
+    uint32_t count = *vdbnode_idxcell_count(src);
+
+    for (uint32_t i = from; i < count; i++) {
+        uint32_t size = vdbnode_datacell_size(src, i);
+        vdbnode_insert_idxcell(dst, page_size, i - from, size);
+        memcpy(vdbnode_datacell(dst, i - from), vdbnode_datacell(src, i), size);
+    }
+
+    vdbnode_keep_cells(src, page_size, 0, from);
+}
+
+//moves the first count cells of src to the end of dst, keeping their order
+void vdbnode_move_head_cells(uint8_t* src, uint8_t* dst, uint32_t page_size, uint32_t count) {
+    assert(*vdbnode_idxcells_freelist(src) == 0 && "cannot move cells when idxcells are fragmented");
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t size = vdbnode_datacell_size(src, i);
+        uint32_t new_idx = vdbnode_new_idxcell(dst, page_size, size);
+        memcpy(vdbnode_datacell(dst, new_idx), vdbnode_datacell(src, i), size);
+    }
+
+    vdbnode_keep_cells(src, page_size, count, *vdbnode_idxcell_count(src));
+}
+
 void* vdbnode_datacell(uint8_t* buf, uint32_t idxcell_idx) {
     int off = VDB_PAGE_HDR_SIZE + idxcell_idx * sizeof(uint32_t);
     int data_off = *((uint32_t*)(buf + off));
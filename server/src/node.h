@@ -9,7 +9,12 @@ enum VdbNodeType {
     VDBN_META,
     VDBN_INTERN,
     VDBN_LEAF,
-    VDBN_DATA
+    VDBN_DATA,
+    VDBN_FREE,
+    VDBN_OVERFLOW,
+    VDBN_HASH_META,
+    VDBN_HASH_DIR,
+    VDBN_BUCKET
 };
 
 struct VdbPtr {
@@ -23,19 +28,35 @@ struct VdbRecPtr {
     struct VdbValue key;
 };
 
+//overflow page
+uint8_t* vdboverflow_data(uint8_t* buf);
+uint32_t vdboverflow_capacity(uint32_t page_size);
+
 //meta data node
 uint32_t* vdbmeta_auto_counter_ptr(uint8_t* buf);
 uint32_t* vdbmeta_root_ptr(uint8_t* buf);
 uint32_t* vdbmeta_last_leaf(uint8_t* buf);
-uint32_t* vdbmeta_largest_key_size(uint8_t* buf);
-void* vdbmeta_largest_key(uint8_t* buf);
-void vdbmeta_allocate_schema_ptr(uint8_t* buf, uint32_t size);
+uint32_t* vdbmeta_freelist_ptr(uint8_t* buf);
+uint32_t* vdbmeta_clustered_ptr(uint8_t* buf);
+void vdbmeta_allocate_schema_ptr(uint8_t* buf, uint32_t page_size, uint32_t size);
 uint32_t* vdbmeta_data_block_ptr(uint8_t* buf);
 void* vdbmeta_schema_ptr(uint8_t* buf);
 
+//hash index meta data node
+uint32_t* vdbhashmeta_level_ptr(uint8_t* buf);
+uint32_t* vdbhashmeta_split_ptr(uint8_t* buf);
+uint32_t* vdbhashmeta_entry_count_ptr(uint8_t* buf);
+uint32_t* vdbhashmeta_freelist_ptr(uint8_t* buf);
+uint32_t* vdbhashmeta_dir_count_ptr(uint8_t* buf);
+uint32_t* vdbhashmeta_dirs(uint8_t* buf);
+uint32_t vdbhashmeta_dir_capacity(uint8_t* buf);
+
+//hash index directory node
+uint32_t* vdbhashdir_buckets(uint8_t* buf);
+uint32_t vdbhashdir_capacity(uint32_t page_size);
+
 //internal node
 uint32_t* vdbintern_rightptr_block(uint8_t* buf);
-void* vdbintern_rightptr_key(uint8_t* buf);
 
 //node functions
 enum VdbNodeType* vdbnode_type(uint8_t* buf);
@@ -48,10 +69,15 @@ uint32_t* vdbnode_datacells_freelist(uint8_t* buf);
 void vdbnode_free_cell_and_defrag_datacells_only(uint8_t* buf, uint32_t idxcell_idx);
 void vdbnode_free_cell_and_defrag_node(uint8_t* buf, uint32_t idxcell_idx);
 
-bool vdbnode_can_fit(uint8_t* buf, uint32_t datacell_size);
-uint32_t vdbnode_new_idxcell(uint8_t* buf, uint32_t datacell_size);
-void vdbnode_insert_idxcell(uint8_t* buf, uint32_t idxcell_idx, uint32_t datacell_size);
+bool vdbnode_can_fit(uint8_t* buf, uint32_t page_size, uint32_t datacell_size);
+uint32_t vdbnode_new_idxcell(uint8_t* buf, uint32_t page_size, uint32_t datacell_size);
+void vdbnode_insert_idxcell(uint8_t* buf, uint32_t page_size, uint32_t idxcell_idx, uint32_t datacell_size);
 void* vdbnode_datacell(uint8_t* buf, uint32_t idxcell_idx);
+uint32_t vdbnode_datacell_size(uint8_t* buf, uint32_t idxcell_idx);
+uint32_t vdbnode_used_size(uint8_t* buf);
+void vdbnode_move_cells(uint8_t* src, uint8_t* dst, uint32_t page_size, uint32_t from);
+void vdbnode_move_cells_to_front(uint8_t* src, uint8_t* dst, uint32_t page_size, uint32_t from);
+void vdbnode_move_head_cells(uint8_t* src, uint8_t* dst, uint32_t page_size, uint32_t count);
 void vdbnode_free_cell(uint8_t* buf, uint32_t idxcell_idx);
 
 #endif //VDB_NODE_H
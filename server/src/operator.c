@@ -0,0 +1,354 @@
+#include <assert.h>
+#include <string.h>
+
+#include "operator.h"
+
+
+static struct VdbOperator* vdboperator_init(enum VdbOperatorType type, struct VdbOperator* child, struct VdbCursor* cursor) {
+    struct VdbOperator* op = malloc_w(sizeof(struct VdbOperator));
+    op->type = type;
+    op->child = child;
+    op->cursor = child ? child->cursor : cursor;
+    op->started = false;
+    return op;
+}
+
+struct VdbOperator* vdboperator_scan(struct VdbCursor* cursor, struct VdbKeyRange* range) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_SCAN, NULL, cursor);
+    op->as.scan.range = range;
+    vdbcursor_begin_range_scan(cursor, range);
+    return op;
+}
+
+struct VdbOperator* vdboperator_index_scan(struct VdbCursor* cursor, struct VdbIndexCursor* ic) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_INDEX_SCAN, NULL, cursor);
+    op->as.index_scan.ic = ic;
+    return op;
+}
+
+//scan that filters records in batches before building them.  Takes ownership of the predicate
+struct VdbOperator* vdboperator_batch_scan(struct VdbCursor* cursor, struct VdbKeyRange* range, struct VdbPredicate* predicate) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_BATCH_SCAN, NULL, cursor);
+    op->as.batch_scan.range = range;
+    op->as.batch_scan.predicate = predicate;
+    op->as.batch_scan.done = false;
+
+    //the key is read with the batch too when an upper bound needs checking
+    uint32_t col_count = vdbpredicate_col_count(predicate);
+    uint32_t key_idx = cursor->tree->schema->key_idx;
+    if (range->has_upper && key_idx >= col_count) {
+        col_count = key_idx + 1;
+    }
+    op->as.batch_scan.batch = vdbbatch_init(col_count);
+
+    vdbcursor_begin_range_scan(cursor, range);
+    return op;
+}
+
+struct VdbOperator* vdboperator_filter(struct VdbOperator* child, struct VdbExpr* selection) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_FILTER, child, NULL);
+    op->as.filter.selection = selection;
+    return op;
+}
+
+struct VdbOperator* vdboperator_sort(struct VdbOperator* child, struct VdbExprList* ordering_cols, bool order_desc, uint64_t budget) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_SORT, child, NULL);
+    op->as.sort.sorter = vdbsorter_init(op->cursor->tree->schema, ordering_cols, order_desc, budget);
+    return op;
+}
+
+struct VdbOperator* vdboperator_topn(struct VdbOperator* child, struct VdbExprList* ordering_cols, bool order_desc, uint32_t limit) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_TOPN, child, NULL);
+    op->as.topn.top = vdbtopn_init(op->cursor, ordering_cols, order_desc, limit);
+    op->as.topn.ordering_cols = ordering_cols;
+    op->as.topn.order_desc = order_desc;
+    op->as.topn.head = NULL;
+    return op;
+}
+
+//groups keep their first record and the running results of the aggregate functions they use
+struct VdbOperator* vdboperator_group(struct VdbOperator* child, struct VdbExprList* grouping, struct VdbExpr* having,
+                                      struct VdbExprList* ordering_cols, bool order_desc, struct VdbExprList* projection) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_GROUP, child, NULL);
+    op->as.group.grouping = grouping;
+    op->as.group.having = having;
+    op->as.group.ordering_cols = ordering_cols;
+    op->as.group.order_desc = order_desc;
+    op->as.group.head = NULL;
+    op->as.group.current = NULL;
+
+    op->as.group.aggregates = vdbaccumulatorlist_init();
+    for (int i = 0; i < projection->count; i++) {
+        vdbaccumulatorlist_add_calls(op->as.group.aggregates, projection->exprs[i]);
+    }
+    for (int i = 0; i < ordering_cols->count; i++) {
+        vdbaccumulatorlist_add_calls(op->as.group.aggregates, ordering_cols->exprs[i]);
+    }
+    vdbaccumulatorlist_add_calls(op->as.group.aggregates, having);
+
+    return op;
+}
+
+struct VdbOperator* vdboperator_project(struct VdbOperator* child, struct VdbExprList* projection) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_PROJECT, child, NULL);
+    op->as.project.projection = projection;
+    return op;
+}
+
+struct VdbOperator* vdboperator_distinct(struct VdbOperator* child) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_DISTINCT, child, NULL);
+    op->as.distinct.rows = vdbdistinct_init();
+    return op;
+}
+
+struct VdbOperator* vdboperator_limit(struct VdbOperator* child, uint64_t limit) {
+    struct VdbOperator* op = vdboperator_init(VDBOP_LIMIT, child, NULL);
+    op->as.limit.remaining = limit;
+    return op;
+}
+
+static struct VdbRecord* vdboperator_next_scan(struct VdbOperator* op) {
+    if (vdbcursor_range_done(op->cursor, op->as.scan.range))
+        return NULL;
+
+    return vdbcursor_fetch_record(op->cursor);
+}
+
+static struct VdbRecord* vdboperator_next_batch_scan(struct VdbOperator* op) {
+    struct VdbBatch* batch = op->as.batch_scan.batch;
+
+    while (true) {
+        while (batch->next < batch->count) {
+            uint32_t i = batch->next++;
+            if (batch->selected[i])
+                return vdbtree_leaf_read_record(op->cursor->tree, batch->leaf_idxs[i], batch->rec_idxs[i]);
+        }
+
+        if (op->as.batch_scan.done)
+            return NULL;
+
+        op->as.batch_scan.done = !vdbcursor_fetch_batch(op->cursor, op->as.batch_scan.range, batch);
+        vdbpredicate_eval(op->as.batch_scan.predicate, batch, batch->selected);
+    }
+}
+
+static struct VdbRecord* vdboperator_next_filter(struct VdbOperator* op) {
+    struct VdbRecord* rec;
+    while ((rec = vdboperator_next(op->child))) {
+        struct VdbRecord* recs[1] = { rec };
+        struct VdbRecordSet rs = { .records = recs, .count = 1, .capacity = 1, .next = NULL, .key = NULL, .accs = NULL };
+        if (vdbcursor_apply_selection(op->cursor, &rs, op->as.filter.selection))
+            return rec;
+
+        vdbrecord_free(rec);
+    }
+
+    return NULL;
+}
+
+static struct VdbRecord* vdboperator_next_sort(struct VdbOperator* op) {
+    struct VdbSorter* sorter = op->as.sort.sorter;
+    if (!op->started) {
+        struct VdbRecord* rec;
+        while ((rec = vdboperator_next(op->child))) {
+            vdbsorter_insert(sorter, rec);
+        }
+        vdbsorter_finish(sorter);
+        op->started = true;
+    }
+
+    return vdbsorter_next(sorter);
+}
+
+//takes the first record of the next recordset in a sorted list, and frees the recordset
+static struct VdbRecord* vdboperator_pop_record(struct VdbRecordSet** head) {
+    struct VdbRecordSet* rs = *head;
+    if (!rs)
+        return NULL;
+
+    *head = rs->next;
+    struct VdbRecord* rec = rs->records[0];
+    rs->count = 0;
+    vdbrecordset_free(rs);
+    return rec;
+}
+
+static struct VdbRecord* vdboperator_next_topn(struct VdbOperator* op) {
+    if (!op->started) {
+        struct VdbRecord* rec;
+        while ((rec = vdboperator_next(op->child))) {
+            struct VdbRecordSet* rs = vdbrecordset_init(NULL);
+            vdbrecordset_append_record(rs, rec);
+            vdbtopn_insert(op->as.topn.top, rs);
+        }
+
+        op->as.topn.head = vdbtopn_finish(op->as.topn.top);
+        op->as.topn.top = NULL;
+        vdbcursor_sort_linked_list(op->cursor, &op->as.topn.head, op->as.topn.ordering_cols, op->as.topn.order_desc);
+        op->started = true;
+    }
+
+    return vdboperator_pop_record(&op->as.topn.head);
+}
+
+static void vdboperator_build_groups(struct VdbOperator* op) {
+    struct VdbSchema* schema = op->cursor->tree->schema;
+    struct VdbHashTable* groups = vdbhashtable_init();
+
+    struct VdbRecord* rec;
+    while ((rec = vdboperator_next(op->child))) {
+        struct VdbRecord* recs[1] = { rec };
+        struct VdbRecordSet rs = { .records = recs, .count = 1, .capacity = 1, .next = NULL, .key = NULL, .accs = NULL };
+        struct VdbByteList* key = vdbcursor_key_from_cols(op->cursor, &rs, op->as.group.grouping);
+
+        struct VdbRecordSet* group = vdbhashtable_find_entry(groups, key);
+        if (group) {
+            vdbbytelist_free(key);
+        } else {
+            group = vdbhashtable_insert_entry(groups, key, rec);
+            group->accs = vdbaccumulatorlist_copy(op->as.group.aggregates);
+        }
+
+        vdbaccumulatorlist_update(group->accs, rec, schema);
+        if (group->records[0] != rec) {
+            vdbrecord_free(rec);
+        }
+    }
+
+    //'having' can only be applied once the aggregates have seen the entire group
+    uint32_t idx = 0;
+    struct VdbRecordSet* cur;
+    while ((cur = vdbhashtable_next_entry(groups, &idx))) {
+        if (vdbcursor_apply_having(op->cursor, cur, op->as.group.having)) {
+            cur->next = op->as.group.head;
+            op->as.group.head = cur;
+        } else {
+            vdbrecordset_free(cur);
+        }
+    }
+
+    vdbhashtable_free(groups);
+    vdbcursor_sort_linked_list(op->cursor, &op->as.group.head, op->as.group.ordering_cols, op->as.group.order_desc);
+}
+
+static struct VdbRecord* vdboperator_next_group(struct VdbOperator* op) {
+    if (!op->started) {
+        vdboperator_build_groups(op);
+        op->started = true;
+    }
+
+    //the previous group's record was already returned
+    if (op->as.group.current) {
+        op->as.group.current->count = 0;
+        vdbrecordset_free(op->as.group.current);
+    }
+
+    struct VdbRecordSet* group = op->as.group.head;
+    op->as.group.current = group;
+    if (!group)
+        return NULL;
+
+    op->as.group.head = group->next;
+    return group->records[0];
+}
+
+static struct VdbRecord* vdboperator_next_project(struct VdbOperator* op) {
+    struct VdbRecord* rec = vdboperator_next(op->child);
+    if (!rec)
+        return NULL;
+
+    //aggregates are evaluated on the group the record stands in for
+    if (op->child->type == VDBOP_GROUP) {
+        vdbcursor_project_record(op->cursor, op->child->as.group.current, rec, op->as.project.projection);
+    } else {
+        struct VdbRecord* recs[1] = { rec };
+        struct VdbRecordSet rs = { .records = recs, .count = 1, .capacity = 1, .next = NULL, .key = NULL, .accs = NULL };
+        vdbcursor_project_record(op->cursor, &rs, rec, op->as.project.projection);
+    }
+
+    return rec;
+}
+
+static struct VdbRecord* vdboperator_next_distinct(struct VdbOperator* op) {
+    struct VdbRecord* rec;
+    while ((rec = vdboperator_next(op->child))) {
+        if (vdbdistinct_first_seen(op->as.distinct.rows, rec))
+            return rec;
+
+        vdbrecord_free(rec);
+    }
+
+    return NULL;
+}
+
+static struct VdbRecord* vdboperator_next_limit(struct VdbOperator* op) {
+    if (op->as.limit.remaining == 0)
+        return NULL;
+
+    op->as.limit.remaining--;
+    return vdboperator_next(op->child);
+}
+
+//next record, which the caller takes ownership of.  NULL once there are none left
+struct VdbRecord* vdboperator_next(struct VdbOperator* op) {
+    switch (op->type) {
+        case VDBOP_SCAN: return vdboperator_next_scan(op);
+        case VDBOP_INDEX_SCAN: return vdbindexcursor_fetch_record(op->as.index_scan.ic, op->cursor);
+        case VDBOP_BATCH_SCAN: return vdboperator_next_batch_scan(op);
+        case VDBOP_FILTER: return vdboperator_next_filter(op);
+        case VDBOP_SORT: return vdboperator_next_sort(op);
+        case VDBOP_TOPN: return vdboperator_next_topn(op);
+        case VDBOP_GROUP: return vdboperator_next_group(op);
+        case VDBOP_PROJECT: return vdboperator_next_project(op);
+        case VDBOP_DISTINCT: return vdboperator_next_distinct(op);
+        case VDBOP_LIMIT: return vdboperator_next_limit(op);
+        default: assert(false && "invalid operator type"); break;
+    }
+
+    return NULL;
+}
+
+//frees an operator and its children, along with any records they have not returned yet
+void vdboperator_free(struct VdbOperator* op) {
+    switch (op->type) {
+        case VDBOP_BATCH_SCAN:
+            vdbpredicate_free(op->as.batch_scan.predicate);
+            vdbbatch_free(op->as.batch_scan.batch);
+            break;
+        case VDBOP_SORT:
+            vdbsorter_free(op->as.sort.sorter);
+            break;
+        case VDBOP_TOPN:
+            if (op->as.topn.top) {
+                struct VdbRecordSet* head = vdbtopn_finish(op->as.topn.top);
+                op->as.topn.head = head;
+            }
+            while (op->as.topn.head) {
+                vdbrecord_free(vdboperator_pop_record(&op->as.topn.head));
+            }
+            break;
+        case VDBOP_GROUP:
+            if (op->as.group.current) {
+                op->as.group.current->count = 0;
+                vdbrecordset_free(op->as.group.current);
+            }
+            while (op->as.group.head) {
+                struct VdbRecordSet* next = op->as.group.head->next;
+                vdbrecordset_free(op->as.group.head);
+                op->as.group.head = next;
+            }
+            vdbaccumulatorlist_free(op->as.group.aggregates);
+            break;
+        case VDBOP_DISTINCT:
+            vdbdistinct_free(op->as.distinct.rows);
+            break;
+        default:
+            break;
+    }
+
+    if (op->child) {
+        vdboperator_free(op->child);
+    }
+
+    free_w(op, sizeof(struct VdbOperator));
+}
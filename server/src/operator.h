@@ -0,0 +1,95 @@
+#ifndef VDB_OPERATOR_H
+#define VDB_OPERATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cursor.h"
+#include "sort.h"
+#include "hashtable.h"
+
+/*
+ * Select operators - each one pulls records from its child one at a time, so a record goes from the
+ * scan to the result without being held in between.  Only sorting and grouping read all of their
+ * input before returning their first record, and a limit stops reading once it has enough
+ */
+
+enum VdbOperatorType {
+    VDBOP_SCAN,
+    VDBOP_INDEX_SCAN,
+    VDBOP_BATCH_SCAN,
+    VDBOP_FILTER,
+    VDBOP_SORT,
+    VDBOP_TOPN,
+    VDBOP_GROUP,
+    VDBOP_PROJECT,
+    VDBOP_DISTINCT,
+    VDBOP_LIMIT
+};
+
+struct VdbOperator {
+    enum VdbOperatorType type;
+    struct VdbOperator* child;
+    struct VdbCursor* cursor; //table being read, and its schema is used to evaluate expressions
+    bool started; //sort, topn and group read their input on the first call
+    union {
+        struct {
+            struct VdbKeyRange* range;
+        } scan;
+        struct {
+            struct VdbIndexCursor* ic;
+        } index_scan;
+        struct {
+            struct VdbKeyRange* range;
+            struct VdbPredicate* predicate;
+            struct VdbBatch* batch;
+            bool done;
+        } batch_scan;
+        struct {
+            struct VdbExpr* selection;
+        } filter;
+        struct {
+            struct VdbSorter* sorter;
+        } sort;
+        struct {
+            struct VdbTopN* top;
+            struct VdbExprList* ordering_cols;
+            bool order_desc;
+            struct VdbRecordSet* head;
+        } topn;
+        struct {
+            struct VdbExprList* grouping;
+            struct VdbExpr* having;
+            struct VdbExprList* ordering_cols;
+            bool order_desc;
+            struct VdbAccumulatorList* aggregates;
+            struct VdbRecordSet* head;
+            struct VdbRecordSet* current; //group of the last record returned, which the projection evaluates on
+        } group;
+        struct {
+            struct VdbExprList* projection;
+        } project;
+        struct {
+            struct VdbDistinct* rows;
+        } distinct;
+        struct {
+            uint64_t remaining;
+        } limit;
+    } as;
+};
+
+struct VdbOperator* vdboperator_scan(struct VdbCursor* cursor, struct VdbKeyRange* range);
+struct VdbOperator* vdboperator_index_scan(struct VdbCursor* cursor, struct VdbIndexCursor* ic);
+struct VdbOperator* vdboperator_batch_scan(struct VdbCursor* cursor, struct VdbKeyRange* range, struct VdbPredicate* predicate);
+struct VdbOperator* vdboperator_filter(struct VdbOperator* child, struct VdbExpr* selection);
+struct VdbOperator* vdboperator_sort(struct VdbOperator* child, struct VdbExprList* ordering_cols, bool order_desc, uint64_t budget);
+struct VdbOperator* vdboperator_topn(struct VdbOperator* child, struct VdbExprList* ordering_cols, bool order_desc, uint32_t limit);
+struct VdbOperator* vdboperator_group(struct VdbOperator* child, struct VdbExprList* grouping, struct VdbExpr* having,
+                                      struct VdbExprList* ordering_cols, bool order_desc, struct VdbExprList* projection);
+struct VdbOperator* vdboperator_project(struct VdbOperator* child, struct VdbExprList* projection);
+struct VdbOperator* vdboperator_distinct(struct VdbOperator* child);
+struct VdbOperator* vdboperator_limit(struct VdbOperator* child, uint64_t limit);
+struct VdbRecord* vdboperator_next(struct VdbOperator* op);
+void vdboperator_free(struct VdbOperator* op);
+
+#endif //VDB_OPERATOR_H
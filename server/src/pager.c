@@ -2,135 +2,809 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
 
 #include "pager.h"
 #include "util.h"
 
 
-static void vdbpager_flush_page(struct VdbPage* p);
+static void vdbpager_flush_page(struct VdbPager* pager, struct VdbPage* p);
+static void vdbpager_release_buf(struct VdbPager* pager, struct VdbPage* p);
+static int vdbpager_flusher(void* arg);
 
-struct VdbPager* vdbpager_init() {
+//pool_size is in bytes.  Page sizes differ between databases, so there are
+//enough frames for the smallest page size, and buffer bytes are budgeted separately
+struct VdbPager* vdbpager_init(uint64_t pool_size, enum VdbEvictPolicy policy, bool mmap_reads, uint32_t dirty_watermark) {
     struct VdbPager* pager = malloc_w(sizeof(struct VdbPager));
 
+    uint64_t capacity = pool_size / VDB_MIN_PAGE_SIZE;
+    if (capacity < 1)
+        capacity = 1;
+    if (capacity > VDB_NO_FRAME - 1)
+        capacity = VDB_NO_FRAME - 1;
+
+    //frames are never reallocated so that pointers to pinned pages stay valid
     pager->count = 0;
-    pager->capacity = 4096;
+    pager->capacity = (uint32_t)capacity;
     pager->pages = malloc_w(sizeof(struct VdbPage) * pager->capacity);
+    pager->free_frames = malloc_w(sizeof(uint32_t) * pager->capacity);
+    pager->free_count = 0;
+    pager->pool_size = pool_size;
+    pager->bytes = 0;
+    pager->policy = policy;
+    pager->mmap_reads = mmap_reads;
+    pager->clock_hand = 0;
+    pager->clean_heap.frames = malloc_w(sizeof(uint32_t) * pager->capacity);
+    pager->clean_heap.count = 0;
+    pager->dirty_heap.frames = malloc_w(sizeof(uint32_t) * pager->capacity);
+    pager->dirty_heap.count = 0;
+    pager->tick = 0;
+
+    //page table has at least as many buckets as frames, so chains stay around one frame long
+    uint32_t bucket_bits = 4;
+    while (((uint32_t)1 << bucket_bits) < capacity) {
+        bucket_bits++;
+    }
+    pager->bucket_shift = 64 - bucket_bits;
+    pager->buckets = malloc_w(sizeof(uint32_t) * ((size_t)1 << bucket_bits));
+    memset(pager->buckets, 0xff, sizeof(uint32_t) * ((size_t)1 << bucket_bits)); //all VDB_NO_FRAME
+
+    pager->file_count = 0;
+    pager->file_capacity = 8;
+    pager->files = malloc_w(sizeof(struct VdbPagerFile) * pager->file_capacity);
+
+    pager->stop = false;
+    pager->writeback_active = false;
+    pager->dirty_count = 0;
+    pager->dirty_watermark = dirty_watermark;
+    pager->staging = malloc_w(VDB_FLUSH_BATCH * VDB_MAX_PAGE_SIZE);
+    mtx_init(&pager->lock, mtx_plain);
+    cnd_init(&pager->flush_cond);
+    cnd_init(&pager->writeback_cond);
+    if (thrd_create(&pager->flusher, &vdbpager_flusher, pager) != thrd_success)
+        err_quit("failed to start pager flusher thread");
 
     return pager;
 }
 
 void vdbpager_free(struct VdbPager* pager) {
+    mtx_lock(&pager->lock);
+    pager->stop = true;
+    cnd_signal(&pager->flush_cond);
+    mtx_unlock(&pager->lock);
+    thrd_join(pager->flusher, NULL);
+
     for (uint32_t i = 0; i < pager->count; i++) {
         struct VdbPage* p = &pager->pages[i];
+        if (p->free)
+            continue;
+
         if (p->dirty) {
-            vdbpager_flush_page(p);
+            vdbpager_flush_page(pager, p);
         }
+        vdbpager_release_buf(pager, p);
     }
 
+    cnd_destroy(&pager->writeback_cond);
+    cnd_destroy(&pager->flush_cond);
+    mtx_destroy(&pager->lock);
+    free_w(pager->staging, VDB_FLUSH_BATCH * VDB_MAX_PAGE_SIZE);
+
+    free_w(pager->files, sizeof(struct VdbPagerFile) * pager->file_capacity);
+    free_w(pager->buckets, sizeof(uint32_t) * ((size_t)1 << (64 - pager->bucket_shift)));
+    free_w(pager->free_frames, sizeof(uint32_t) * pager->capacity);
+    free_w(pager->clean_heap.frames, sizeof(uint32_t) * pager->capacity);
+    free_w(pager->dirty_heap.frames, sizeof(uint32_t) * pager->capacity);
     free_w(pager->pages, sizeof(struct VdbPage) * pager->capacity);
     free_w(pager, sizeof(struct VdbPager));
 }
 
-uint32_t vdbpager_fresh_page(FILE* f) {
-    static uint8_t buf[VDB_PAGE_SIZE] = {0};
+//fibonacci hashing of the (file, page idx) pair - top bits are used as the bucket
+static uint32_t vdbpager_bucket(struct VdbPager* pager, int fd, uint32_t idx) {
+    uint64_t key = ((uint64_t)(uint32_t)fd << 32) ^ idx;
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> pager->bucket_shift);
+}
+
+static void vdbpager_hash_insert(struct VdbPager* pager, uint32_t frame) {
+    struct VdbPage* p = &pager->pages[frame];
+    uint32_t b = vdbpager_bucket(pager, p->fd, p->idx);
+    p->hash_next = pager->buckets[b];
+    pager->buckets[b] = frame;
+}
+
+static void vdbpager_hash_remove(struct VdbPager* pager, uint32_t frame) {
+    struct VdbPage* p = &pager->pages[frame];
+    uint32_t* link = &pager->buckets[vdbpager_bucket(pager, p->fd, p->idx)];
+    while (*link != frame) {
+        assert(*link != VDB_NO_FRAME && "frame not found in page table");
+        link = &pager->pages[*link].hash_next;
+    }
+    *link = p->hash_next;
+}
+
+static struct VdbPage* vdbpager_lookup(struct VdbPager* pager, int fd, uint32_t idx) {
+    uint32_t frame = pager->buckets[vdbpager_bucket(pager, fd, idx)];
+    while (frame != VDB_NO_FRAME) {
+        struct VdbPage* p = &pager->pages[frame];
+        if (p->idx == idx && p->fd == fd) {
+            return p;
+        }
+        frame = p->hash_next;
+    }
+
+    return NULL;
+}
+
+bool vdbpager_valid_page_size(uint32_t page_size) {
+    bool power_of_two = (page_size & (page_size - 1)) == 0;
+    return power_of_two && page_size >= VDB_MIN_PAGE_SIZE && page_size <= VDB_MAX_PAGE_SIZE;
+}
+
+void vdbpager_write_file_hdr(int fd, uint32_t page_size) {
+    uint8_t buf[VDB_FILE_HDR_SIZE];
+    int off = 0;
+    write_u32(buf, VDB_FILE_MAGIC, &off);
+    write_u32(buf, VDB_FORMAT_VERSION, &off);
+    write_u32(buf, page_size, &off);
+
+    pwrite_w(fd, buf, VDB_FILE_HDR_SIZE, 0);
+}
+
+//returns false if the file is not a vaquita file or was written by an incompatible version
+bool vdbpager_read_file_hdr(int fd, uint32_t* page_size) {
+    uint8_t buf[VDB_FILE_HDR_SIZE];
+    if (pread(fd, buf, VDB_FILE_HDR_SIZE, 0) != VDB_FILE_HDR_SIZE)
+        return false;
 
-    fseek_w(f, 0, SEEK_END);
-    uint32_t idx = ftell_w(f) / VDB_PAGE_SIZE;
-    fwrite_w(buf, sizeof(uint8_t), VDB_PAGE_SIZE, f);
+    uint32_t magic;
+    uint32_t version;
+    int off = 0;
+    read_u32(&magic, buf, &off);
+    read_u32(&version, buf, &off);
+    read_u32(page_size, buf, &off);
+
+    return magic == VDB_FILE_MAGIC && version == VDB_FORMAT_VERSION && vdbpager_valid_page_size(*page_size);
+}
+
+static void vdbpager_register_file(struct VdbPager* pager, int fd, uint32_t page_size) {
+    if (pager->file_count == pager->file_capacity) {
+        uint32_t old_cap = pager->file_capacity;
+        pager->file_capacity *= 2;
+        pager->files = realloc_w(pager->files, sizeof(struct VdbPagerFile) * pager->file_capacity, sizeof(struct VdbPagerFile) * old_cap);
+    }
+
+    struct VdbPagerFile* file = &pager->files[pager->file_count++];
+    file->fd = fd;
+    file->page_size = page_size;
+    file->map = NULL;
+
+    //reserve address space for the largest file we expect - the mapping follows the file as it grows
+    if (pager->mmap_reads) {
+        void* map = mmap(NULL, VDB_MMAP_RESERVE, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            file->map = map;
+        }
+    }
+}
+
+static struct VdbPagerFile* vdbpager_file(struct VdbPager* pager, int fd) {
+    for (uint32_t i = 0; i < pager->file_count; i++) {
+        if (pager->files[i].fd == fd)
+            return &pager->files[i];
+    }
+
+    assert(false && "file not registered with pager");
+    return NULL;
+}
+
+static uint32_t vdbpager_append_page(int fd, uint32_t page_size) {
+    static uint8_t buf[VDB_MAX_PAGE_SIZE] = {0};
+
+    uint32_t idx = fsize_w(fd) / page_size;
+    pwrite_w(fd, buf, page_size, (off_t)idx * page_size);
 
     return idx;
 }
 
-struct VdbPage* vdbpager_load_page(struct VdbPager* pager, FILE* f, uint32_t idx) {
-    if (pager->count >= pager->capacity) {
-        int old_cap = pager->capacity;
-        pager->capacity *= 2;
-        pager->pages = realloc_w(pager->pages, sizeof(struct VdbPage) * pager->capacity, sizeof(struct VdbPage) * old_cap);
+//writes the file header into page 0 of a new (empty) table file
+void vdbpager_create_file(struct VdbPager* pager, int fd, uint32_t page_size) {
+    assert(vdbpager_valid_page_size(page_size) && "invalid page size");
+    mtx_lock(&pager->lock);
+    vdbpager_register_file(pager, fd, page_size);
+
+    uint32_t idx = vdbpager_append_page(fd, page_size);
+    assert(idx == 0 && "file header must be page 0");
+    vdbpager_write_file_hdr(fd, page_size);
+    mtx_unlock(&pager->lock);
+}
+
+//returns the page size of the file, or 0 if the file header is invalid
+uint32_t vdbpager_open_file(struct VdbPager* pager, int fd) {
+    uint32_t page_size;
+    if (!vdbpager_read_file_hdr(fd, &page_size))
+        return 0;
+
+    mtx_lock(&pager->lock);
+    vdbpager_register_file(pager, fd, page_size);
+    mtx_unlock(&pager->lock);
+    return page_size;
+}
+
+uint32_t vdbpager_page_size(struct VdbPager* pager, int fd) {
+    mtx_lock(&pager->lock);
+    uint32_t page_size = vdbpager_file(pager, fd)->page_size;
+    mtx_unlock(&pager->lock);
+    return page_size;
+}
+
+uint32_t vdbpager_fresh_page(struct VdbPager* pager, int fd) {
+    mtx_lock(&pager->lock);
+    uint32_t idx = vdbpager_append_page(fd, vdbpager_file(pager, fd)->page_size);
+    mtx_unlock(&pager->lock);
+    return idx;
+}
+
+static void vdbpager_alloc_buf(struct VdbPager* pager, struct VdbPage* p, uint32_t page_size) {
+    p->size = page_size;
+    p->buf = malloc_w(page_size);
+    p->mapped = false;
+    pager->bytes += page_size;
+}
+
+//mapped views point into the file mapping, so there is nothing to free
+static void vdbpager_release_buf(struct VdbPager* pager, struct VdbPage* p) {
+    if (!p->mapped) {
+        free_w(p->buf, p->size);
+        pager->bytes -= p->size;
     }
+    p->buf = NULL;
+}
+
+//returns a pointer to the page inside the file mapping, or NULL if the page must be read into a buffer
+static uint8_t* vdbpager_mapped_view(struct VdbPager* pager, int fd, uint32_t idx) {
+    struct VdbPagerFile* file = vdbpager_file(pager, fd);
+    size_t off = (size_t)idx * file->page_size;
+    if (!file->map || off + file->page_size > VDB_MMAP_RESERVE)
+        return NULL;
 
-    struct VdbPage* p = &pager->pages[pager->count++];
+    return file->map + off;
+}
 
+static void vdbpager_flush_page(struct VdbPager* pager, struct VdbPage* p) {
+    pwrite_w(p->fd, p->buf, p->size, (off_t)p->idx * p->size);
     p->dirty = false;
-    p->pin_count = 0;
-    p->idx = idx;
-    fseek_w(f, p->idx * VDB_PAGE_SIZE, SEEK_SET);
-    fread_w(p->buf, sizeof(uint8_t), VDB_PAGE_SIZE, f);
-    p->f = f;
+    pager->dirty_count--;
+}
 
-    return p;
+static bool vdbpager_over_watermark(struct VdbPager* pager) {
+    return (uint64_t)pager->dirty_count * 100 > (uint64_t)pager->dirty_watermark * pager->capacity;
 }
 
-static void vdbpager_flush_page(struct VdbPage* p) {
-    fseek_w(p->f, p->idx * VDB_PAGE_SIZE, SEEK_SET);
-    fwrite_w(p->buf, sizeof(uint8_t), VDB_PAGE_SIZE, p->f);
-    p->dirty = false;
+//frames being written back must keep their page until the write lands, or a re-read could see old data
+static bool vdbpager_evictable(struct VdbPage* p, bool clean_only) {
+    return !p->free && p->pin_count == 0 && !p->writeback && !(clean_only && p->dirty);
 }
 
-static struct VdbPage* vdbpager_evict_first_unpinned(struct VdbPager* pager, FILE* f, uint32_t idx) {
-    uint32_t i; 
-    for (i = 0; i < pager->count; i++) {
+//CLOCK: sweep the hand, giving referenced frames a second chance
+static uint32_t vdbpager_clock_victim(struct VdbPager* pager, bool clean_only) {
+    if (pager->clock_hand >= pager->count)
+        pager->clock_hand = 0;
+
+    //two full sweeps clear every reference bit, so anything left after that is pinned
+    for (uint32_t n = 0; n < pager->count * 2; n++) {
+        uint32_t i = pager->clock_hand;
+        pager->clock_hand = (pager->clock_hand + 1) % pager->count;
+
         struct VdbPage* p = &pager->pages[i];
-        if (p->pin_count == 0) {
-            if (p->dirty) {
-                vdbpager_flush_page(p);
-            }
+        if (!vdbpager_evictable(p, clean_only))
+            continue;
 
-            p->dirty = false;
-            p->pin_count = 0;
-            p->idx = idx;
-            fseek_w(f, p->idx * VDB_PAGE_SIZE, SEEK_SET);
-            fread_w(p->buf, sizeof(uint8_t), VDB_PAGE_SIZE, f);
-            p->f = f;
-            return p;
+        if (p->referenced) {
+            p->referenced = false;
+            continue;
         }
+
+        return i;
     }
-    
-    printf("buffer pool doesn't have enough space!!! Bug!!!\n");
-    return NULL;
+
+    return VDB_NO_FRAME;
 }
 
-struct VdbPage* vdbpager_pin_page(struct VdbPager* pager, FILE* f, uint32_t idx) {
-    struct VdbPage* page = NULL;
-    for (uint32_t i = 0; i < pager->count; i++) {
-        struct VdbPage* p = &pager->pages[i];
-        if (p->idx == idx && fileno(f) == fileno(p->f)) {
-            page = p;
+//LRU-K: evict the frame whose K-th most recent reference is oldest.  Frames with fewer
+//than K references have infinite backward K-distance, and are evicted first (LRU among them)
+static bool vdbpager_lruk_before(struct VdbPager* pager, uint32_t a, uint32_t b) {
+    struct VdbPage* l = &pager->pages[a];
+    struct VdbPage* r = &pager->pages[b];
+    bool l_has_k = l->history[VDB_LRU_K - 1] != 0;
+    bool r_has_k = r->history[VDB_LRU_K - 1] != 0;
+    if (l_has_k != r_has_k)
+        return !l_has_k;
+
+    uint32_t k = l_has_k ? VDB_LRU_K - 1 : 0;
+    return l->history[k] < r->history[k];
+}
+
+static void vdbpager_heap_set(struct VdbPager* pager, struct VdbFrameHeap* heap, uint32_t pos, uint32_t frame) {
+    heap->frames[pos] = frame;
+    pager->pages[frame].heap_pos = pos;
+}
+
+static void vdbpager_heap_sift_up(struct VdbPager* pager, struct VdbFrameHeap* heap, uint32_t pos) {
+    uint32_t frame = heap->frames[pos];
+    while (pos > 0) {
+        uint32_t parent = (pos - 1) / 2;
+        if (!vdbpager_lruk_before(pager, frame, heap->frames[parent]))
             break;
+
+        vdbpager_heap_set(pager, heap, pos, heap->frames[parent]);
+        pos = parent;
+    }
+    vdbpager_heap_set(pager, heap, pos, frame);
+}
+
+static void vdbpager_heap_sift_down(struct VdbPager* pager, struct VdbFrameHeap* heap, uint32_t pos) {
+    uint32_t frame = heap->frames[pos];
+    while (true) {
+        uint32_t child = pos * 2 + 1;
+        if (child >= heap->count)
+            break;
+
+        if (child + 1 < heap->count && vdbpager_lruk_before(pager, heap->frames[child + 1], heap->frames[child])) {
+            child++;
+        }
+        if (!vdbpager_lruk_before(pager, heap->frames[child], frame))
+            break;
+
+        vdbpager_heap_set(pager, heap, pos, heap->frames[child]);
+        pos = child;
+    }
+    vdbpager_heap_set(pager, heap, pos, frame);
+}
+
+static void vdbpager_heap_remove(struct VdbPager* pager, uint32_t frame) {
+    struct VdbPage* p = &pager->pages[frame];
+    struct VdbFrameHeap* heap = p->heap;
+    uint32_t pos = p->heap_pos;
+    p->heap = NULL;
+
+    uint32_t last = heap->frames[--heap->count];
+    if (pos == heap->count)
+        return;
+
+    vdbpager_heap_set(pager, heap, pos, last);
+    vdbpager_heap_sift_up(pager, heap, pos);
+    vdbpager_heap_sift_down(pager, heap, pager->pages[last].heap_pos);
+}
+
+//moves the frame into the heap matching its state.  A frame's references only change while it is
+//pinned, and pinned frames are in neither heap, so a frame's position stays valid while it is in one
+static void vdbpager_lruk_track(struct VdbPager* pager, uint32_t frame) {
+    if (pager->policy != VDBEP_LRUK)
+        return;
+
+    struct VdbPage* p = &pager->pages[frame];
+    struct VdbFrameHeap* heap = NULL;
+    if (!p->free && p->pin_count == 0 && !p->writeback) {
+        heap = p->dirty ? &pager->dirty_heap : &pager->clean_heap;
+    }
+
+    if (p->heap == heap)
+        return;
+
+    if (p->heap) {
+        vdbpager_heap_remove(pager, frame);
+    }
+
+    if (heap) {
+        p->heap = heap;
+        vdbpager_heap_set(pager, heap, heap->count++, frame);
+        vdbpager_heap_sift_up(pager, heap, p->heap_pos);
+    }
+}
+
+static uint32_t vdbpager_lruk_victim(struct VdbPager* pager, bool clean_only) {
+    uint32_t clean = pager->clean_heap.count > 0 ? pager->clean_heap.frames[0] : VDB_NO_FRAME;
+    uint32_t dirty = pager->dirty_heap.count > 0 ? pager->dirty_heap.frames[0] : VDB_NO_FRAME;
+    if (clean_only || dirty == VDB_NO_FRAME)
+        return clean;
+    if (clean == VDB_NO_FRAME)
+        return dirty;
+
+    return vdbpager_lruk_before(pager, dirty, clean) ? dirty : clean;
+}
+
+static uint32_t vdbpager_victim(struct VdbPager* pager, bool clean_only) {
+    switch (pager->policy) {
+        case VDBEP_CLOCK:
+            return vdbpager_clock_victim(pager, clean_only);
+        case VDBEP_LRUK:
+            return vdbpager_lruk_victim(pager, clean_only);
+        default:
+            assert(false && "invalid eviction policy");
+            return VDB_NO_FRAME;
+    }
+}
+
+//picks an unpinned victim - the frame keeps its buffer.  Clean frames are preferred so the
+//query doesn't wait on a write; a dirty victim is only written here if the flusher fell behind
+static uint32_t vdbpager_evict(struct VdbPager* pager) {
+    uint32_t i = vdbpager_victim(pager, true);
+    if (i == VDB_NO_FRAME) {
+        i = vdbpager_victim(pager, false);
+        cnd_signal(&pager->flush_cond);
+    }
+
+    if (i == VDB_NO_FRAME) {
+        return VDB_NO_FRAME;
+    }
+
+    struct VdbPage* p = &pager->pages[i];
+    if (p->heap) {
+        vdbpager_heap_remove(pager, i);
+    }
+    if (p->dirty) {
+        vdbpager_flush_page(pager, p);
+    }
+
+    vdbpager_hash_remove(pager, i);
+    return i;
+}
+
+static void vdbpager_record_reference(struct VdbPager* pager, struct VdbPage* p) {
+    pager->tick++;
+    p->referenced = true;
+
+    //pins within the correlated reference period only refresh the latest reference
+    if (p->history[0] != 0 && pager->tick - p->history[0] <= VDB_LRU_CRP) {
+        p->history[0] = pager->tick;
+        return;
+    }
+
+    memmove(p->history + 1, p->history, sizeof(uint64_t) * (VDB_LRU_K - 1));
+    p->history[0] = pager->tick;
+}
+
+static uint32_t vdbpager_take_free_frame(struct VdbPager* pager, uint32_t page_size, bool mapped) {
+    uint32_t frame = pager->free_frames[--pager->free_count];
+    pager->pages[frame].free = false;
+    if (!mapped) {
+        vdbpager_alloc_buf(pager, &pager->pages[frame], page_size);
+    }
+    return frame;
+}
+
+//returns a frame with a buffer for page_size bytes (or no buffer if a mapped view will be used)
+static uint32_t vdbpager_claim_frame(struct VdbPager* pager, uint32_t page_size, bool mapped) {
+    uint32_t needed = mapped ? 0 : page_size;
+    uint32_t frame = VDB_NO_FRAME;
+    bool over_budget = pager->count > 0 && pager->bytes + needed > pager->pool_size;
+
+    //frames left by a closed file have no buffer, so they are only reused while there are bytes for one
+    if (pager->free_count > 0 && !over_budget) {
+        return vdbpager_take_free_frame(pager, page_size, mapped);
+    }
+
+    if (pager->count >= pager->capacity || over_budget) {
+        frame = vdbpager_evict(pager);
+    }
+
+    if (frame != VDB_NO_FRAME) {
+        //victim may belong to a database with a different page size
+        struct VdbPage* p = &pager->pages[frame];
+        if (mapped || p->mapped || p->size != page_size) {
+            vdbpager_release_buf(pager, p);
+            if (!mapped) {
+                vdbpager_alloc_buf(pager, p, page_size);
+            }
         }
+        return frame;
     }
 
-    const int MAX_PAGES = 8; //TODO: replace with larger number (artificially small to test eviction)
+    //every frame is pinned - large pages can exhaust the byte budget before the frame
+    //capacity, so go over budget until some pages are unpinned
+    if (pager->free_count > 0) {
+        return vdbpager_take_free_frame(pager, page_size, mapped);
+    }
 
-    //not cached, so read from disk
+    if (pager->count >= pager->capacity) {
+        return VDB_NO_FRAME;
+    }
+
+    frame = pager->count++;
+    pager->pages[frame].free = false;
+    pager->pages[frame].heap = NULL;
+    if (!mapped) {
+        vdbpager_alloc_buf(pager, &pager->pages[frame], page_size);
+    }
+    return frame;
+}
+
+static struct VdbPage* vdbpager_pin(struct VdbPager* pager, int fd, uint32_t idx, bool read_only) {
+    struct VdbPage* page = vdbpager_lookup(pager, fd, idx);
+
+    //not cached, so map or read from disk
     if (!page) {
-        if (pager->count >= MAX_PAGES) {
-            //TODO: replace with LRU or other eviction algorithm later
-            page = vdbpager_evict_first_unpinned(pager, f, idx);
+        uint32_t page_size = vdbpager_file(pager, fd)->page_size;
+        uint8_t* view = read_only ? vdbpager_mapped_view(pager, fd, idx) : NULL;
+
+        //callers never get a NULL page, so running out of frames is fatal
+        uint32_t frame = vdbpager_claim_frame(pager, page_size, view != NULL);
+        if (frame == VDB_NO_FRAME)
+            err_quit("buffer pool exhausted - every frame is pinned");
+
+        page = &pager->pages[frame];
+        page->dirty = false;
+        page->writeback = false;
+        page->pin_count = 0;
+        page->referenced = false;
+        memset(page->history, 0, sizeof(page->history));
+        page->idx = idx;
+        page->fd = fd;
+        if (view) {
+            page->buf = view;
+            page->size = page_size;
+            page->mapped = true;
         } else {
-            page = vdbpager_load_page(pager, f, idx);
+            pread_w(fd, page->buf, page->size, (off_t)idx * page->size);
         }
+
+        vdbpager_hash_insert(pager, frame);
+    } else if (page->mapped && !read_only) {
+        //first write to a mapped page - give the frame its own copy
+        uint8_t* view = page->buf;
+        vdbpager_alloc_buf(pager, page, page->size);
+        memcpy(page->buf, view, page->size);
     }
 
     page->pin_count++;
+    vdbpager_record_reference(pager, page);
+    vdbpager_lruk_track(pager, (uint32_t)(page - pager->pages));
+
+    return page;
+}
+
+struct VdbPage* vdbpager_pin_page(struct VdbPager* pager, int fd, uint32_t idx) {
+    mtx_lock(&pager->lock);
+    struct VdbPage* page = vdbpager_pin(pager, fd, idx, false);
+    mtx_unlock(&pager->lock);
+    return page;
+}
 
+//pages pinned for reading must be unpinned clean.  In mmap mode buf may point directly
+//into the file mapping, so the caller gets the page contents without a copy
+struct VdbPage* vdbpager_pin_page_readonly(struct VdbPager* pager, int fd, uint32_t idx) {
+    mtx_lock(&pager->lock);
+    struct VdbPage* page = vdbpager_pin(pager, fd, idx, true);
+    mtx_unlock(&pager->lock);
     return page;
 }
 
-void vdbpager_unpin_page(struct VdbPage* page, bool dirty) {
+//sequential hint makes the kernel read further ahead and drop pages behind the scan sooner
+void vdbpager_begin_scan(struct VdbPager* pager, int fd) {
+    (void)pager;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+void vdbpager_end_scan(struct VdbPager* pager, int fd) {
+    (void)pager;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_NORMAL);
+}
+
+//starts asynchronous reads for pages that will be pinned soon.  Pages already in the pool
+//are skipped, and runs of adjacent pages are requested together
+void vdbpager_prefetch(struct VdbPager* pager, int fd, uint32_t* idxs, uint32_t count) {
+    mtx_lock(&pager->lock);
+    uint32_t page_size = vdbpager_file(pager, fd)->page_size;
+    uint32_t run_start = 0;
+    uint32_t run_len = 0;
+
+    for (uint32_t i = 0; i <= count; i++) {
+        bool uncached = i < count && !vdbpager_lookup(pager, fd, idxs[i]);
+        if (uncached && run_len > 0 && idxs[i] == run_start + run_len) {
+            run_len++;
+            continue;
+        }
+
+        if (run_len > 0) {
+            posix_fadvise(fd, (off_t)run_start * page_size, (off_t)run_len * page_size, POSIX_FADV_WILLNEED);
+            run_len = 0;
+        }
+
+        if (uncached) {
+            run_start = idxs[i];
+            run_len = 1;
+        }
+    }
+    mtx_unlock(&pager->lock);
+}
+
+void vdbpager_unpin_page(struct VdbPager* pager, struct VdbPage* page, bool dirty) {
+    assert(!(dirty && page->mapped) && "page pinned read-only was modified");
+    mtx_lock(&pager->lock);
     page->pin_count--;
-    if (dirty) {
+    if (dirty && !page->dirty) {
         page->dirty = true;
+        pager->dirty_count++;
+        if (vdbpager_over_watermark(pager)) {
+            cnd_signal(&pager->flush_cond);
+        }
     }
+    vdbpager_lruk_track(pager, (uint32_t)(page - pager->pages));
+    mtx_unlock(&pager->lock);
 }
 
-void vdbpager_evict_pages(struct VdbPager* pager, FILE* f) {
+//writes back and drops all frames belonging to the file, and forgets the file
+void vdbpager_close_file(struct VdbPager* pager, int fd) {
+    mtx_lock(&pager->lock);
+
+    //the flusher may be writing copies of this file's pages through fd
+    while (pager->writeback_active) {
+        cnd_wait(&pager->writeback_cond, &pager->lock);
+    }
+
+    //frames stay where they are, since other threads may hold pointers to pinned pages of other files
     for (uint32_t i = 0; i < pager->count; i++) {
         struct VdbPage* p = &pager->pages[i];
-        if (fileno(p->f) == fileno(f)) {
-            memcpy(pager->pages + i, pager->pages + pager->count - 1, sizeof(struct VdbPage));
-            pager->count--;
-            i--;
+        if (!p->free && p->fd == fd) {
+            assert(p->pin_count == 0 && "closing file with pinned pages");
+            if (p->dirty) {
+                vdbpager_flush_page(pager, p);
+            }
+
+            vdbpager_hash_remove(pager, i);
+            vdbpager_release_buf(pager, p);
+            p->free = true;
+            vdbpager_lruk_track(pager, i);
+            pager->free_frames[pager->free_count++] = i;
+        }
+    }
+
+    for (uint32_t i = 0; i < pager->file_count; i++) {
+        if (pager->files[i].fd == fd) {
+            if (pager->files[i].map) {
+                munmap(pager->files[i].map, VDB_MMAP_RESERVE);
+            }
+            pager->files[i] = pager->files[--pager->file_count];
+            break;
+        }
+    }
+
+    mtx_unlock(&pager->lock);
+}
+
+struct VdbWriteback {
+    int fd;
+    uint32_t idx;
+    uint32_t size;
+    uint32_t frame;
+};
+
+static int vdbpager_compare_writeback(const void* a, const void* b) {
+    const struct VdbWriteback* l = a;
+    const struct VdbWriteback* r = b;
+    if (l->fd != r->fd)
+        return l->fd < r->fd ? -1 : 1;
+    if (l->idx != r->idx)
+        return l->idx < r->idx ? -1 : 1;
+    return 0;
+}
+
+//copies up to VDB_FLUSH_BATCH dirty, unpinned frames into the staging buffer, then writes them
+//without holding the lock.  Adjacent pages of a file go out in a single pwritev.  Called and
+//returns with the lock held - returns the number of pages written
+static uint32_t vdbpager_write_back(struct VdbPager* pager, bool sync) {
+    struct VdbWriteback batch[VDB_FLUSH_BATCH];
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < pager->count && n < VDB_FLUSH_BATCH; i++) {
+        struct VdbPage* p = &pager->pages[i];
+        if (p->free || !p->dirty || p->pin_count > 0 || p->writeback)
+            continue;
+
+        batch[n].fd = p->fd;
+        batch[n].idx = p->idx;
+        batch[n].size = p->size;
+        batch[n].frame = i;
+        n++;
+    }
+
+    if (n == 0 && !sync)
+        return 0;
+
+    qsort(batch, n, sizeof(struct VdbWriteback), &vdbpager_compare_writeback);
+
+    //frames are clean once copied - a later write pin dirties them again
+    for (uint32_t i = 0; i < n; i++) {
+        struct VdbPage* p = &pager->pages[batch[i].frame];
+        memcpy(pager->staging + (size_t)i * VDB_MAX_PAGE_SIZE, p->buf, p->size);
+        p->dirty = false;
+        p->writeback = true;
+        pager->dirty_count--;
+        vdbpager_lruk_track(pager, batch[i].frame);
+    }
+
+    //checkpoints sync every open file, including pages written by evictions since the last one
+    uint32_t sync_count = sync ? pager->file_count : 0;
+    int sync_fds[sync_count > 0 ? sync_count : 1];
+    for (uint32_t i = 0; i < sync_count; i++) {
+        sync_fds[i] = pager->files[i].fd;
+    }
+
+    pager->writeback_active = true;
+    mtx_unlock(&pager->lock);
+
+    struct iovec iov[VDB_FLUSH_BATCH];
+    uint32_t start = 0;
+    while (start < n) {
+        uint32_t end = start + 1;
+        iov[0].iov_base = pager->staging + (size_t)start * VDB_MAX_PAGE_SIZE;
+        iov[0].iov_len = batch[start].size;
+        while (end < n && batch[end].fd == batch[start].fd && batch[end].idx == batch[end - 1].idx + 1) {
+            iov[end - start].iov_base = pager->staging + (size_t)end * VDB_MAX_PAGE_SIZE;
+            iov[end - start].iov_len = batch[end].size;
+            end++;
+        }
+
+        pwritev_w(batch[start].fd, iov, end - start, (off_t)batch[start].idx * batch[start].size);
+        start = end;
+    }
+
+    for (uint32_t i = 0; i < sync_count; i++) {
+        fdatasync(sync_fds[i]);
+    }
+
+    mtx_lock(&pager->lock);
+    for (uint32_t i = 0; i < n; i++) {
+        pager->pages[batch[i].frame].writeback = false;
+        vdbpager_lruk_track(pager, batch[i].frame);
+    }
+    pager->writeback_active = false;
+    cnd_broadcast(&pager->writeback_cond);
+
+    return n;
+}
+
+//wakes when the dirty watermark is crossed (or eviction had to write a page itself) and writes
+//back until the pool is below half the watermark.  Every VDB_FLUSH_INTERVAL_MS it checkpoints:
+//all dirty frames are written and the files synced
+static int vdbpager_flusher(void* arg) {
+    struct VdbPager* pager = arg;
+
+    mtx_lock(&pager->lock);
+    while (!pager->stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += VDB_FLUSH_INTERVAL_MS / 1000;
+        deadline.tv_nsec += (VDB_FLUSH_INTERVAL_MS % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        bool checkpoint = cnd_timedwait(&pager->flush_cond, &pager->lock, &deadline) == thrd_timedout;
+        if (pager->stop)
+            break;
+
+        if (checkpoint) {
+            bool written = false;
+            while (vdbpager_write_back(pager, false) > 0) {
+                written = true;
+            }
+            if (written) {
+                vdbpager_write_back(pager, true);
+            }
+        } else {
+            uint32_t low = pager->dirty_watermark / 2;
+            while ((uint64_t)pager->dirty_count * 100 > (uint64_t)low * pager->capacity) {
+                if (vdbpager_write_back(pager, false) == 0)
+                    break;
+            }
         }
     }
+    mtx_unlock(&pager->lock);
 
+    return 0;
 }
@@ -3,30 +3,114 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <threads.h>
 
-#define VDB_PAGE_SIZE 256
-#define VDB_PAGE_HDR_SIZE 128
+#define VDB_MIN_PAGE_SIZE 4096
+#define VDB_MAX_PAGE_SIZE 65536
+#define VDB_DEFAULT_PAGE_SIZE 4096
+#define VDB_PAGE_HDR_SIZE 64
+#define VDB_NO_FRAME UINT32_MAX
+#define VDB_LRU_K 2
+#define VDB_LRU_CRP 64 //correlated reference period (in pins) - repeated pins inside it count as one reference
+#define VDB_MMAP_RESERVE ((size_t)1 << 36) //address space reserved per table file in mmap mode
+#define VDB_FLUSH_BATCH 64 //max frames written back by the flusher while it holds the staging buffer
+#define VDB_FLUSH_INTERVAL_MS 1000 //checkpoint period - all dirty frames are written and synced
+#define VDB_DEFAULT_DIRTY_WATERMARK 10 //percent of frames allowed to be dirty before the flusher wakes
+
+/*
+ * File header - occupies page 0 of every table file and the database header file
+ * [magic|format version|page size| ... ]
+ */
+#define VDB_FILE_MAGIC 0x31424456 //"VDB1"
+#define VDB_FORMAT_VERSION 5
+#define VDB_FILE_HDR_SIZE 12
+
+enum VdbEvictPolicy {
+    VDBEP_CLOCK,
+    VDBEP_LRUK
+};
+
+//unpinned frames ordered by LRU-K eviction priority, with the next victim at frames[0]
+struct VdbFrameHeap {
+    uint32_t* frames;
+    uint32_t count;
+};
 
 struct VdbPage {
     bool dirty;
     uint32_t idx;
     uint32_t pin_count;
-    uint8_t buf[VDB_PAGE_SIZE];
-    FILE* f;
+    uint8_t* buf;
+    uint32_t size;
+    bool mapped; //buf points into the file mapping and must not be written
+    bool writeback; //contents are being written by the flusher, so the frame can't be reused yet
+    int fd;
+    bool free; //page was dropped when its file closed, and the frame is on the free list
+    uint32_t hash_next; //next frame in the same page table bucket
+    bool referenced; //CLOCK reference bit
+    uint64_t history[VDB_LRU_K]; //LRU-K reference times, most recent first (0 if fewer than K references)
+    struct VdbFrameHeap* heap; //LRU-K heap holding the frame, NULL if it can't be evicted
+    uint32_t heap_pos;
+};
+
+struct VdbPagerFile {
+    int fd;
+    uint32_t page_size;
+    uint8_t* map; //read-only mapping of the whole file, NULL if not in mmap mode
 };
 
 struct VdbPager {
     struct VdbPage* pages;
     uint32_t count;
     uint32_t capacity;
+    uint64_t pool_size;
+    uint64_t bytes; //sum of frame buffer sizes
+    uint32_t* free_frames; //frames below count that hold no page, reused before evicting
+    uint32_t free_count;
+    uint32_t* buckets; //page table: (file, page idx) -> first frame in bucket chain
+    uint32_t bucket_shift;
+    enum VdbEvictPolicy policy;
+    bool mmap_reads;
+    uint32_t clock_hand;
+    struct VdbFrameHeap clean_heap; //LRU-K candidates, kept apart so clean victims are found without a write
+    struct VdbFrameHeap dirty_heap;
+    uint64_t tick;
+    struct VdbPagerFile* files;
+    uint32_t file_count;
+    uint32_t file_capacity;
+
+    //all pager state is guarded by lock - page contents are guarded by the database locks
+    mtx_t lock;
+    thrd_t flusher;
+    cnd_t flush_cond; //wakes the flusher early
+    cnd_t writeback_cond; //signalled when a writeback batch completes
+    bool stop;
+    bool writeback_active;
+    uint32_t dirty_count;
+    uint32_t dirty_watermark; //percent of frames
+    uint8_t* staging; //frame copies being written by the flusher
 };
 
-struct VdbPager* vdbpager_init();
+struct VdbPager* vdbpager_init(uint64_t pool_size, enum VdbEvictPolicy policy, bool mmap_reads, uint32_t dirty_watermark);
 void vdbpager_free(struct VdbPager* pager);
 
-uint32_t vdbpager_fresh_page(FILE* f);
-struct VdbPage* vdbpager_pin_page(struct VdbPager* pager, FILE* f, uint32_t idx);
-void vdbpager_unpin_page(struct VdbPage* page, bool dirty);
-void vdbpager_evict_pages(struct VdbPager* pager, FILE* f);
+bool vdbpager_valid_page_size(uint32_t page_size);
+void vdbpager_write_file_hdr(int fd, uint32_t page_size);
+bool vdbpager_read_file_hdr(int fd, uint32_t* page_size);
+
+void vdbpager_create_file(struct VdbPager* pager, int fd, uint32_t page_size);
+uint32_t vdbpager_open_file(struct VdbPager* pager, int fd);
+void vdbpager_close_file(struct VdbPager* pager, int fd);
+uint32_t vdbpager_page_size(struct VdbPager* pager, int fd);
+
+uint32_t vdbpager_fresh_page(struct VdbPager* pager, int fd);
+struct VdbPage* vdbpager_pin_page(struct VdbPager* pager, int fd, uint32_t idx);
+struct VdbPage* vdbpager_pin_page_readonly(struct VdbPager* pager, int fd, uint32_t idx);
+
+void vdbpager_begin_scan(struct VdbPager* pager, int fd);
+void vdbpager_end_scan(struct VdbPager* pager, int fd);
+void vdbpager_prefetch(struct VdbPager* pager, int fd, uint32_t* idxs, uint32_t count);
+void vdbpager_unpin_page(struct VdbPager* pager, struct VdbPage* page, bool dirty);
 
 #endif //VDB_PAGER_H
@@ -225,7 +225,8 @@ struct VdbExpr* vdbexpr_init_is_not_null(struct VdbExpr* left) {
     return expr;
 }
 
-struct VdbValue vdbexpr_eval_identifier(struct VdbToken token, struct VdbRecord* rec, struct VdbSchema* schema) {
+//column an identifier refers to, or the column count if there is none
+uint32_t vdbexpr_identifier_col(struct VdbToken token, struct VdbSchema* schema) {
     uint32_t i;
     for (i = 0; i < schema->count; i++) {
         if (strncmp(schema->names[i], token.lexeme, token.len) == 0) {
@@ -233,6 +234,12 @@ struct VdbValue vdbexpr_eval_identifier(struct VdbToken token, struct VdbRecord*
         }
     }
 
+    return i;
+}
+
+struct VdbValue vdbexpr_eval_identifier(struct VdbToken token, struct VdbRecord* rec, struct VdbSchema* schema) {
+    uint32_t i = vdbexpr_identifier_col(token, schema);
+
     if (rec->data[i].type == VDBT_TYPE_TEXT) {
         return vdbstring(rec->data[i].as.Str.start, rec->data[i].as.Str.len);
     }
@@ -303,7 +310,7 @@ static struct VdbValue vdbexpr_eval_binary_equals(struct VdbValue* left, struct
     d.type = VDBT_TYPE_BOOL;
     switch (left->type) {
         case VDBT_TYPE_TEXT:
-            d.as.Bool = strncmp(left->as.Str.start, right->as.Str.start, left->as.Str.len) == 0;
+            d.as.Bool = vdbvalue_compare(*left, *right) == 0;
             break;
         case VDBT_TYPE_INT8:
             d.as.Bool = left->as.Int == right->as.Int;
@@ -337,7 +344,7 @@ static struct VdbValue vdbexpr_eval_binary_not_equals(struct VdbValue* left, str
     d.type = VDBT_TYPE_BOOL;
     switch (left->type) {
         case VDBT_TYPE_TEXT:
-            d.as.Bool = strncmp(left->as.Str.start, right->as.Str.start, left->as.Str.len) != 0;
+            d.as.Bool = vdbvalue_compare(*left, *right) != 0;
             break;
         case VDBT_TYPE_INT8:
             d.as.Bool = left->as.Int != right->as.Int;
@@ -370,7 +377,7 @@ static struct VdbValue vdbexpr_eval_binary_less(struct VdbValue* left, struct Vd
     d.type = VDBT_TYPE_BOOL;
     switch (left->type) {
         case VDBT_TYPE_TEXT:
-            d.as.Bool = strncmp(left->as.Str.start, right->as.Str.start, left->as.Str.len) < 0;
+            d.as.Bool = vdbvalue_compare(*left, *right) < 0;
             break;
         case VDBT_TYPE_INT8:
             d.as.Bool = left->as.Int < right->as.Int;
@@ -401,7 +408,7 @@ static struct VdbValue vdbexpr_eval_binary_less_equals(struct VdbValue* left, st
     d.type = VDBT_TYPE_BOOL;
     switch (left->type) {
         case VDBT_TYPE_TEXT:
-            d.as.Bool = strncmp(left->as.Str.start, right->as.Str.start, left->as.Str.len) <= 0;
+            d.as.Bool = vdbvalue_compare(*left, *right) <= 0;
             break;
         case VDBT_TYPE_INT8:
             d.as.Bool = left->as.Int <= right->as.Int;
@@ -432,7 +439,7 @@ static struct VdbValue vdbexpr_eval_binary_greater(struct VdbValue* left, struct
     d.type = VDBT_TYPE_BOOL;
     switch (left->type) {
         case VDBT_TYPE_TEXT:
-            d.as.Bool = strncmp(left->as.Str.start, right->as.Str.start, left->as.Str.len) > 0;
+            d.as.Bool = vdbvalue_compare(*left, *right) > 0;
             break;
         case VDBT_TYPE_INT8:
             d.as.Bool = left->as.Int > right->as.Int;
@@ -463,7 +470,7 @@ static struct VdbValue vdbexpr_eval_binary_greater_equals(struct VdbValue* left,
     d.type = VDBT_TYPE_BOOL;
     switch (left->type) {
         case VDBT_TYPE_TEXT:
-            d.as.Bool = strncmp(left->as.Str.start, right->as.Str.start, left->as.Str.len) >= 0;
+            d.as.Bool = vdbvalue_compare(*left, *right) >= 0;
             break;
         case VDBT_TYPE_INT8:
             d.as.Bool = left->as.Int >= right->as.Int;
@@ -735,6 +742,163 @@ static struct VdbValue vdbexpr_eval_call_min(struct VdbExpr* arg, struct VdbReco
     return d;
 }
 
+struct VdbAccumulatorList* vdbaccumulatorlist_init() {
+    struct VdbAccumulatorList* al = malloc_w(sizeof(struct VdbAccumulatorList));
+    al->count = 0;
+    al->capacity = 4;
+    al->accs = malloc_w(sizeof(struct VdbAccumulator) * al->capacity);
+    return al;
+}
+
+void vdbaccumulatorlist_free(struct VdbAccumulatorList* al) {
+    free_w(al->accs, sizeof(struct VdbAccumulator) * al->capacity);
+    free_w(al, sizeof(struct VdbAccumulatorList));
+}
+
+static void vdbaccumulatorlist_append(struct VdbAccumulatorList* al, struct VdbExpr* call) {
+    if (al->count == al->capacity) {
+        uint32_t old_cap = al->capacity;
+        al->capacity *= 2;
+        al->accs = realloc_w(al->accs, sizeof(struct VdbAccumulator) * al->capacity, sizeof(struct VdbAccumulator) * old_cap);
+    }
+
+    struct VdbAccumulator* acc = &al->accs[al->count++];
+    acc->call = call;
+    acc->col = UINT32_MAX;
+    acc->rows = 0;
+    acc->count = 0;
+    acc->value.type = VDBT_TYPE_NULL;
+}
+
+//finds the aggregate function calls in an expression
+void vdbaccumulatorlist_add_calls(struct VdbAccumulatorList* al, struct VdbExpr* expr) {
+    if (!expr)
+        return;
+
+    switch (expr->type) {
+        case VDBET_UNARY:
+            vdbaccumulatorlist_add_calls(al, expr->as.unary.right);
+            break;
+        case VDBET_BINARY:
+            vdbaccumulatorlist_add_calls(al, expr->as.binary.left);
+            vdbaccumulatorlist_add_calls(al, expr->as.binary.right);
+            break;
+        case VDBET_IS_NULL:
+            vdbaccumulatorlist_add_calls(al, expr->as.is_null.left);
+            break;
+        case VDBET_IS_NOT_NULL:
+            vdbaccumulatorlist_add_calls(al, expr->as.is_not_null.left);
+            break;
+        case VDBET_CALL:
+            vdbaccumulatorlist_append(al, expr);
+            break;
+        default:
+            break;
+    }
+}
+
+//same calls with nothing accumulated, for a new group
+struct VdbAccumulatorList* vdbaccumulatorlist_copy(struct VdbAccumulatorList* al) {
+    struct VdbAccumulatorList* copy = vdbaccumulatorlist_init();
+    for (uint32_t i = 0; i < al->count; i++) {
+        vdbaccumulatorlist_append(copy, al->accs[i].call);
+    }
+    return copy;
+}
+
+static void vdbaccumulator_update(struct VdbAccumulator* acc, struct VdbRecord* rec, struct VdbSchema* schema) {
+    acc->rows++;
+
+    enum VdbTokenType fcn = acc->call->as.call.fcn_name.type;
+    if (fcn == VDBT_COUNT)
+        return;
+
+    //columns are read straight from the record rather than looked up by name for every record
+    struct VdbExpr* arg = acc->call->as.call.arg;
+    struct VdbValue v;
+    if (arg->type == VDBET_IDENTIFIER) {
+        if (acc->col == UINT32_MAX) {
+            acc->col = vdbexpr_identifier_col(arg->as.identifier.token, schema);
+        }
+        v = rec->data[acc->col];
+    } else {
+        v = vdbexpr_eval_arg(arg, rec, schema);
+    }
+
+    if (vdbvalue_is_null(&v))
+        return;
+
+    if (v.type != VDBT_TYPE_INT8 && v.type != VDBT_TYPE_FLOAT8) {
+        assert(false && "aggregate functions need to be used with columns of int or float type");
+        return;
+    }
+
+    if (acc->count++ == 0) {
+        acc->value = v;
+        return;
+    }
+
+    bool is_int = v.type == VDBT_TYPE_INT8;
+    switch (fcn) {
+        case VDBT_AVG:
+        case VDBT_SUM:
+            if (is_int) acc->value.as.Int += v.as.Int;
+            else acc->value.as.Float += v.as.Float;
+            break;
+        case VDBT_MAX:
+            if (is_int ? v.as.Int > acc->value.as.Int : v.as.Float > acc->value.as.Float)
+                acc->value = v;
+            break;
+        case VDBT_MIN:
+            if (is_int ? v.as.Int < acc->value.as.Int : v.as.Float < acc->value.as.Float)
+                acc->value = v;
+            break;
+        default:
+            assert(false && "invalid function name");
+            break;
+    }
+}
+
+void vdbaccumulatorlist_update(struct VdbAccumulatorList* al, struct VdbRecord* rec, struct VdbSchema* schema) {
+    for (uint32_t i = 0; i < al->count; i++) {
+        vdbaccumulator_update(&al->accs[i], rec, schema);
+    }
+}
+
+static struct VdbValue vdbaccumulatorlist_result(struct VdbAccumulatorList* al, struct VdbExpr* call) {
+    struct VdbAccumulator* acc = NULL;
+    for (uint32_t i = 0; i < al->count; i++) {
+        if (al->accs[i].call == call) {
+            acc = &al->accs[i];
+            break;
+        }
+    }
+
+    assert(acc && "aggregate function call not accumulated");
+
+    struct VdbValue d;
+    switch (call->as.call.fcn_name.type) {
+        case VDBT_COUNT:
+            d.type = VDBT_TYPE_INT8;
+            d.as.Int = acc->rows;
+            return d;
+        case VDBT_AVG:
+            if (acc->count == 0) {
+                d.type = VDBT_TYPE_NULL;
+                return d;
+            }
+            d.type = VDBT_TYPE_FLOAT8;
+            if (acc->value.type == VDBT_TYPE_INT8) {
+                d.as.Float = (double)acc->value.as.Int / (double)acc->count;
+            } else {
+                d.as.Float = acc->value.as.Float / (double)acc->count;
+            }
+            return d;
+        default:
+            return acc->value;
+    }
+}
+
 static struct VdbValue vdbexpr_do_eval(struct VdbExpr* expr, struct VdbRecordSet* rs, struct VdbSchema* schema) {
     switch (expr->type) {
         case VDBET_BINARY: {
@@ -838,6 +1002,10 @@ static struct VdbValue vdbexpr_do_eval(struct VdbExpr* expr, struct VdbRecordSet
             return d;
         }
         case VDBET_CALL: {
+            if (rs->accs) {
+                return vdbaccumulatorlist_result(rs->accs, expr);
+            }
+
             switch (expr->as.call.fcn_name.type) {
                 case VDBT_AVG: return vdbexpr_eval_call_avg(expr->as.call.arg, rs, schema);
                 case VDBT_COUNT: return vdbexpr_eval_call_count(expr->as.call.arg, rs, schema);
@@ -908,6 +1076,8 @@ void vdbexpr_free(struct VdbExpr* expr) {
             break;
         case VDBET_IDENTIFIER:
             break;
+        case VDBET_WILDCARD:
+            break;
         case VDBET_UNARY:
             vdbexpr_free(expr->as.unary.right);
             break;
@@ -1192,6 +1362,32 @@ enum VdbReturnCode vdbparser_parse_stmt(struct VdbParser* parser, struct VdbStmt
                 stmt->type = VDBST_CREATE_DB;
                 vdbparser_consume_token(parser, VDBT_DATABASE);
                 stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
+                stmt->as.create_db.has_page_size = false;
+                stmt->as.create_db.page_size = 0;
+                if (vdbparser_peek_token(parser).type == VDBT_PAGE_SIZE) {
+                    vdbparser_consume_token(parser, VDBT_PAGE_SIZE);
+                    struct VdbToken t = vdbparser_consume_token(parser, VDBT_INT);
+                    stmt->as.create_db.has_page_size = true;
+                    stmt->as.create_db.page_size = strtoull(t.lexeme, NULL, 10);
+                }
+            } else if (vdbparser_peek_token(parser).type == VDBT_INDEX) {
+                stmt->type = VDBST_CREATE_INDEX;
+                vdbparser_consume_token(parser, VDBT_INDEX);
+                stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
+                vdbparser_consume_token(parser, VDBT_ON);
+                stmt->as.create_index.table = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
+                stmt->as.create_index.columns = vdbtokenlist_init();
+                vdbparser_parse_identifier_tuple(parser, stmt->as.create_index.columns);
+
+                if (stmt->as.create_index.columns->count == 0) {
+                    vdberrorlist_append_error(parser->errors, 1, "'create index' requires at least one column");
+                }
+
+                stmt->as.create_index.hash = false;
+                if (vdbparser_peek_token(parser).type == VDBT_HASH) {
+                    vdbparser_consume_token(parser, VDBT_HASH);
+                    stmt->as.create_index.hash = true;
+                }
             } else {
                 stmt->type = VDBST_CREATE_TAB;
                 vdbparser_consume_token(parser, VDBT_TABLE);
@@ -1222,6 +1418,12 @@ enum VdbReturnCode vdbparser_parse_stmt(struct VdbParser* parser, struct VdbStmt
                 }
                 vdbparser_consume_token(parser, VDBT_RPAREN);
 
+                stmt->as.create.clustered = false;
+                if (vdbparser_peek_token(parser).type == VDBT_CLUSTERED) {
+                    vdbparser_consume_token(parser, VDBT_CLUSTERED);
+                    stmt->as.create.clustered = true;
+                }
+
                 if (stmt->as.create.key_idx == -1) {
                     vdberrorlist_append_error(parser->errors, 1, "'create table' requires exactly one 'key' constraint");
                 }
@@ -1246,6 +1448,10 @@ enum VdbReturnCode vdbparser_parse_stmt(struct VdbParser* parser, struct VdbStmt
                 stmt->type = VDBST_DROP_DB;
                 vdbparser_consume_token(parser, VDBT_DATABASE);
                 stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
+            } else if (vdbparser_peek_token(parser).type == VDBT_INDEX) {
+                stmt->type = VDBST_DROP_INDEX;
+                vdbparser_consume_token(parser, VDBT_INDEX);
+                stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
             } else {
                 stmt->type = VDBST_DROP_TAB;
                 vdbparser_consume_token(parser, VDBT_TABLE);
@@ -1268,6 +1474,11 @@ enum VdbReturnCode vdbparser_parse_stmt(struct VdbParser* parser, struct VdbStmt
             stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
             break;
         }
+        case VDBT_VACUUM: {
+            stmt->type = VDBST_VACUUM;
+            stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
+            break;
+        }
         case VDBT_INSERT: {
             stmt->type = VDBST_INSERT;
             vdbparser_consume_token(parser, VDBT_INTO);
@@ -1298,6 +1509,13 @@ enum VdbReturnCode vdbparser_parse_stmt(struct VdbParser* parser, struct VdbStmt
 
             break;
         }
+        case VDBT_COPY: {
+            stmt->type = VDBST_COPY;
+            stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
+            vdbparser_consume_token(parser, VDBT_FROM);
+            stmt->as.copy.path = vdbparser_consume_token(parser, VDBT_STR);
+            break;
+        }
         case VDBT_UPDATE: {
             stmt->type = VDBST_UPDATE;
             stmt->target = vdbparser_consume_token(parser, VDBT_IDENTIFIER);
@@ -1463,6 +1681,9 @@ void vdbstmt_free_fields(struct VdbStmt* stmt) {
             vdbtokenlist_free(stmt->as.create.attributes);
             vdbtokenlist_free(stmt->as.create.types);
             break;
+        case VDBST_CREATE_INDEX:
+            vdbtokenlist_free(stmt->as.create_index.columns);
+            break;
         case VDBST_INSERT:
             vdbtokenlist_free(stmt->as.insert.attributes);
             vdbexprlist_free(stmt->as.insert.values);
@@ -1502,6 +1723,9 @@ void vdbstmt_print(struct VdbStmt* stmt) {
         }
         case VDBST_CREATE_DB: {
             printf("<create database [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
+            if (stmt->as.create_db.has_page_size) {
+                printf("\tpage size: %llu\n", (unsigned long long)stmt->as.create_db.page_size);
+            }
             break;
         }
         case VDBST_CREATE_TAB: {
@@ -1512,6 +1736,22 @@ void vdbstmt_print(struct VdbStmt* stmt) {
                 struct VdbToken type = stmt->as.create.types->tokens[i];
                 printf("\t\t[%.*s]: %.*s\n", attribute.len, attribute.lexeme, type.len, type.lexeme);
             }
+            if (stmt->as.create.clustered) {
+                printf("\tclustered\n");
+            }
+            break;
+        }
+        case VDBST_CREATE_INDEX: {
+            struct VdbToken table = stmt->as.create_index.table;
+            printf("<create index [%.*s] on table [%.*s]>\n", stmt->target.len, stmt->target.lexeme, table.len, table.lexeme);
+            printf("\tcolumns:\n");
+            for (int i = 0; i < stmt->as.create_index.columns->count; i++) {
+                struct VdbToken column = stmt->as.create_index.columns->tokens[i];
+                printf("\t\t[%.*s]\n", column.len, column.lexeme);
+            }
+            if (stmt->as.create_index.hash) {
+                printf("\thash\n");
+            }
             break;
         }
         case VDBST_DROP_DB: {
@@ -1522,6 +1762,10 @@ void vdbstmt_print(struct VdbStmt* stmt) {
             printf("<drop table [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
             break;
         }
+        case VDBST_DROP_INDEX: {
+            printf("<drop index [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
+            break;
+        }
         case VDBST_OPEN: {
             printf("<open database [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
             break;
@@ -1534,6 +1778,10 @@ void vdbstmt_print(struct VdbStmt* stmt) {
             printf("<describe table [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
             break;
         }
+        case VDBST_VACUUM: {
+            printf("<vacuum table [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
+            break;
+        }
         case VDBST_INSERT: {
             printf("<insert into table [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
             printf("\tcolumns:\n");
@@ -1554,6 +1802,11 @@ void vdbstmt_print(struct VdbStmt* stmt) {
             }
             break;
         }
+        case VDBST_COPY: {
+            printf("<copy into table [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
+            printf("\tfile: %.*s\n", stmt->as.copy.path.len, stmt->as.copy.path.lexeme);
+            break;
+        }
         case VDBST_UPDATE: {
             printf("<update record(s) in table [%.*s]>\n", stmt->target.len, stmt->target.lexeme);
             printf("\tset:\n");
@@ -57,6 +57,21 @@ struct VdbExprList {
     int capacity;
 };
 
+//running result of an aggregate function call, updated as each record of a group is read
+struct VdbAccumulator {
+    struct VdbExpr* call;
+    uint32_t col; //column of an identifier argument, found on the first update
+    int64_t rows;
+    int64_t count; //non-null values
+    struct VdbValue value; //sum, min or max so far
+};
+
+struct VdbAccumulatorList {
+    struct VdbAccumulator* accs;
+    uint32_t count;
+    uint32_t capacity;
+};
+
 enum VdbStmtType {
     VDBST_CONNECT,
     VDBST_SHOW_DBS,
@@ -77,22 +92,39 @@ enum VdbStmtType {
     VDBST_EXIT,
     VDBST_BEGIN,
     VDBST_COMMIT,
-    VDBST_ROLLBACK
+    VDBST_ROLLBACK,
+    VDBST_COPY,
+    VDBST_VACUUM,
+    VDBST_CREATE_INDEX,
+    VDBST_DROP_INDEX
 };
 
 struct VdbStmt {
     enum VdbStmtType type;
     struct VdbToken target;
     union {
+        struct {
+            bool has_page_size;
+            uint64_t page_size; //not narrowed until checked, so out of range values can't wrap
+        } create_db;
         struct {
             struct VdbTokenList* attributes;
             struct VdbTokenList* types;
             int key_idx;
+            bool clustered;
         } create;
+        struct {
+            struct VdbToken table;
+            struct VdbTokenList* columns;
+            bool hash;
+        } create_index;
         struct {
             struct VdbTokenList* attributes;
             struct VdbExprList* values;
         } insert;
+        struct {
+            struct VdbToken path; //csv file, relative to the server directory
+        } copy;
         struct {
             struct VdbTokenList* attributes;
             struct VdbExprList* values;
@@ -134,6 +166,8 @@ struct VdbExpr* vdbexpr_init_binary(struct VdbToken op, struct VdbExpr* left, st
 struct VdbExpr* vdbexpr_init_is_null(struct VdbExpr* left);
 struct VdbExpr* vdbexpr_init_is_not_null(struct VdbExpr* left);
 struct VdbValue vdbexpr_eval(struct VdbExpr* expr, struct VdbRecordSet* rs, struct VdbSchema* schema);
+uint32_t vdbexpr_identifier_col(struct VdbToken token, struct VdbSchema* schema);
+struct VdbValue vdbexpr_eval_literal(struct VdbToken token);
 bool vdbexpr_attrs_valid(struct VdbExpr* expr, struct VdbSchema* schema);
 char* vdbexpr_to_string(struct VdbExpr* expr);
 
@@ -144,6 +178,12 @@ struct VdbExprList* vdbexprlist_init();
 void vdbexprlist_free(struct VdbExprList* el);
 void vdbexprlist_append_expr(struct VdbExprList* el, struct VdbExpr* expr);
 
+struct VdbAccumulatorList* vdbaccumulatorlist_init();
+void vdbaccumulatorlist_free(struct VdbAccumulatorList* al);
+void vdbaccumulatorlist_add_calls(struct VdbAccumulatorList* al, struct VdbExpr* expr);
+struct VdbAccumulatorList* vdbaccumulatorlist_copy(struct VdbAccumulatorList* al);
+void vdbaccumulatorlist_update(struct VdbAccumulatorList* al, struct VdbRecord* rec, struct VdbSchema* schema);
+
 struct VdbStmtList* vdbstmtlist_init();
 void vdbstmtlist_free(struct VdbStmtList* sl);
 void vdbstmtlist_append_stmt(struct VdbStmtList* sl, struct VdbStmt stmt);
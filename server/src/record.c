@@ -5,6 +5,7 @@
 #include "record.h"
 #include "util.h"
 #include "hashtable.h"
+#include "parser.h"
 
 struct VdbRecord* vdbrecord_init(int count, struct VdbValue* data) {
     struct VdbRecord* rec = malloc_w(sizeof(struct VdbRecord));
@@ -113,6 +114,7 @@ struct VdbRecordSet* vdbrecordset_init(struct VdbByteList* key) {
     rs->records = malloc_w(sizeof(struct VdbRecord*) * rs->capacity);
     rs->next = NULL;
     rs->key = key;
+    rs->accs = NULL;
     return rs;
 }
 
@@ -133,9 +135,10 @@ void vdbrecordset_free(struct VdbRecordSet* rs) {
     }
 
     free_w(rs->records, sizeof(struct VdbRecord*) * rs->capacity);
-    free_w(rs, sizeof(struct VdbRecordSet));
     //TODO: Who should free next recordset in linked list ('next' field)
     if (rs->key) vdbbytelist_free(rs->key);
+    if (rs->accs) vdbaccumulatorlist_free(rs->accs);
+    free_w(rs, sizeof(struct VdbRecordSet));
 }
 
 void vdbrecordset_serialize(struct VdbRecordSet* rs, struct VdbByteList* bl) {
@@ -167,39 +170,56 @@ void vdbrecordset_serialize(struct VdbRecordSet* rs, struct VdbByteList* bl) {
     }
 }
 
-struct VdbRecordSet* vdbrecordset_remove_duplicates(struct VdbRecordSet* rs) {
-    struct VdbHashTable* distinct_table = vdbhashtable_init();
-    for (int i = 0; i < rs->count; i++) {
-        struct VdbRecord* rec = rs->records[i];
+struct VdbDistinct* vdbdistinct_init() {
+    struct VdbDistinct* d = malloc_w(sizeof(struct VdbDistinct));
+    d->seen = vdbhashtable_init();
+    d->key = vdbbytelist_init();
+    return d;
+}
 
-        //generate key for hash table
-        struct VdbByteList* key = vdbbytelist_init();
-        for (int i = 0; i < rec->count; i++) {
-            struct VdbValue v = rec->data[i];
-            if (v.type == VDBT_TYPE_TEXT) {
-                vdbbytelist_resize(key, vdbvalue_serialized_string_size(v));
-                key->count += vdbvalue_serialize_string(key->values + key->count, &v);
-            } else {
-                vdbbytelist_resize(key, vdbvalue_serialized_size(v));
-                key->count += vdbvalue_serialize(key->values + key->count, v);
-            }
-        }
+void vdbdistinct_free(struct VdbDistinct* d) {
+    //the rows belong to the result, so only the table's recordsets (and keys) are freed
+    uint32_t idx = 0;
+    struct VdbRecordSet* entry;
+    while ((entry = vdbhashtable_next_entry(d->seen, &idx))) {
+        entry->count = 0;
+        vdbrecordset_free(entry);
+    }
 
-        if (!vdbhashtable_contains_key(distinct_table, key)) {
-            vdbhashtable_insert_entry(distinct_table, key, rec); //using hashtable to check for duplicates bc of 'distinct' keyword
+    vdbhashtable_free(d->seen);
+    vdbbytelist_free(d->key);
+    free_w(d, sizeof(struct VdbDistinct));
+}
+
+//true the first time the values in columns [first, first + count) of rec are seen
+static bool vdbdistinct_first_seen_cols(struct VdbDistinct* d, struct VdbRecord* rec, int first, int count) {
+    struct VdbByteList* key = d->key;
+    key->count = 0;
+    for (int i = first; i < first + count; i++) {
+        struct VdbValue v = rec->data[i];
+        if (v.type == VDBT_TYPE_TEXT) {
+            vdbbytelist_resize(key, vdbvalue_serialized_string_size(v));
+            key->count += vdbvalue_serialize_string(key->values + key->count, &v);
         } else {
-            struct VdbRecord** dst = &rs->records[i];
-            size_t size = sizeof(struct VdbRecord*) * (rs->count - 1 - i);
-            memmove(dst, dst + 1, size);
-            
-            rs->count--;
-            i--; //shifting all values in array down, so need to recheck the same index again for next iteration
+            vdbbytelist_resize(key, vdbvalue_serialized_size(v));
+            key->count += vdbvalue_serialize(key->values + key->count, v);
         }
-
-        vdbbytelist_free(key); //key not used in this hash table anymore, BUT it is used when executing the 'group by' clause in vm.c
     }
 
-    vdbhashtable_free(distinct_table);
+    if (vdbhashtable_find_entry(d->seen, key))
+        return false;
 
-    return rs;
+    vdbhashtable_insert_entry(d->seen, key, rec);
+    d->key = vdbbytelist_init();
+    return true;
+}
+
+//true the first time a row with these values is seen
+bool vdbdistinct_first_seen(struct VdbDistinct* d, struct VdbRecord* rec) {
+    return vdbdistinct_first_seen_cols(d, rec, 0, rec->count);
+}
+
+//true the first time a row with this key is seen
+bool vdbdistinct_first_seen_key(struct VdbDistinct* d, struct VdbRecord* rec, uint32_t key_idx) {
+    return vdbdistinct_first_seen_cols(d, rec, key_idx, 1);
 }
@@ -11,12 +11,22 @@ struct VdbRecord {
     int count;
 };
 
+struct VdbAccumulatorList;
+struct VdbHashTable;
+
 struct VdbRecordSet {
     struct VdbRecord** records;
     int count;
     int capacity;
     struct VdbRecordSet* next;
     struct VdbByteList* key;
+    struct VdbAccumulatorList* accs; //aggregates of a group, which then keeps only its first record
+};
+
+//rows already returned by a 'distinct' select
+struct VdbDistinct {
+    struct VdbHashTable* seen;
+    struct VdbByteList* key; //reused for each row until a new row keeps it
 };
 
 
@@ -35,6 +45,10 @@ struct VdbRecordSet* vdbrecordset_init(struct VdbByteList* key);
 void vdbrecordset_append_record(struct VdbRecordSet* rs, struct VdbRecord* rec);
 void vdbrecordset_free(struct VdbRecordSet* rs);
 void vdbrecordset_serialize(struct VdbRecordSet* rs, struct VdbByteList* bl);
-struct VdbRecordSet* vdbrecordset_remove_duplicates(struct VdbRecordSet* rs);
+
+struct VdbDistinct* vdbdistinct_init();
+void vdbdistinct_free(struct VdbDistinct* d);
+bool vdbdistinct_first_seen(struct VdbDistinct* d, struct VdbRecord* rec);
+bool vdbdistinct_first_seen_key(struct VdbDistinct* d, struct VdbRecord* rec, uint32_t key_idx);
 
 #endif //VDB_RECORD_H
@@ -64,6 +64,19 @@ uint32_t vdbschema_serialized_size(struct VdbSchema* schema) {
     return size;
 }
 
+//size of a serialized record with no null columns - an upper bound for any record in the table
+uint32_t vdbschema_fixedlen_size(struct VdbSchema* schema) {
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i < schema->count; i++) {
+        struct VdbValue v;
+        v.type = schema->types[i];
+        size += vdbvalue_serialized_size(v);
+    }
+
+    return size;
+}
+
 void vdbschema_serialize(uint8_t* buf, struct VdbSchema* schema) {
     int off = 0;
 
@@ -19,6 +19,7 @@ struct VdbSchema* vdbschema_alloc(int count, struct VdbTokenList* attributes, st
 void vdb_schema_free(struct VdbSchema* schema);
 struct VdbSchema* vdb_schema_copy(struct VdbSchema* schema);
 uint32_t vdbschema_serialized_size(struct VdbSchema* schema);
+uint32_t vdbschema_fixedlen_size(struct VdbSchema* schema);
 void vdbschema_serialize(uint8_t* buf, struct VdbSchema* schema);
 struct VdbSchema* vdbschema_deserialize(uint8_t* buf);
 
@@ -0,0 +1,436 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "sort.h"
+#include "util.h"
+
+struct VdbSorter* vdbsorter_init(struct VdbSchema* schema, struct VdbExprList* ordering_cols, bool order_desc, uint64_t budget) {
+    struct VdbSorter* s = malloc_w(sizeof(struct VdbSorter));
+    s->schema = schema;
+    s->ordering_cols = ordering_cols;
+    s->order_desc = order_desc;
+    s->budget = budget;
+
+    s->count = 0;
+    s->capacity = 64;
+    s->items = malloc_w(sizeof(struct VdbSortItem) * s->capacity);
+    s->size = 0;
+    s->next_item = 0;
+
+    s->run_count = 0;
+    s->run_capacity = VDB_SORT_FANIN;
+    s->runs = malloc_w(sizeof(struct VdbSortRun) * s->run_capacity);
+
+    s->heap = NULL;
+    s->heap_count = 0;
+    s->heap_capacity = 0;
+
+    return s;
+}
+
+/*
+ * Sort items
+ */
+
+static struct VdbSortItem vdbsorter_item(struct VdbSorter* s, struct VdbRecord* rec) {
+    struct VdbSortItem item;
+    item.rec = rec;
+    item.keys = NULL;
+    item.run = 0;
+
+    uint32_t count = s->ordering_cols->count;
+    if (count > 0) {
+        struct VdbRecord* recs[1] = { rec };
+        struct VdbRecordSet rs = { .records = recs, .count = 1, .capacity = 1, .next = NULL, .key = NULL, .accs = NULL };
+
+        item.keys = malloc_w(sizeof(struct VdbValue) * count);
+        for (uint32_t i = 0; i < count; i++) {
+            item.keys[i] = vdbexpr_eval(s->ordering_cols->exprs[i], &rs, s->schema);
+        }
+    }
+
+    return item;
+}
+
+static void vdbsorter_free_keys(struct VdbSorter* s, struct VdbSortItem* item) {
+    if (!item->keys)
+        return;
+
+    for (int i = 0; i < s->ordering_cols->count; i++) {
+        vdbvalue_free(item->keys[i]);
+    }
+    free_w(item->keys, sizeof(struct VdbValue) * s->ordering_cols->count);
+    item->keys = NULL;
+}
+
+//bytes an item holds in memory, counted against the budget
+static uint64_t vdbsorter_item_size(struct VdbSorter* s, struct VdbSortItem* item) {
+    uint64_t size = sizeof(struct VdbSortItem) + sizeof(struct VdbRecord) + sizeof(struct VdbValue) * item->rec->count;
+    for (int i = 0; i < item->rec->count; i++) {
+        if (item->rec->data[i].type == VDBT_TYPE_TEXT) {
+            size += item->rec->data[i].as.Str.len;
+        }
+    }
+
+    for (int i = 0; item->keys && i < s->ordering_cols->count; i++) {
+        size += sizeof(struct VdbValue);
+        if (item->keys[i].type == VDBT_TYPE_TEXT) {
+            size += item->keys[i].as.Str.len;
+        }
+    }
+
+    return size;
+}
+
+//orders by the ordering columns and then by primary key, the same as vdbcursor_sort_linked_list
+static int vdbsorter_compare(struct VdbSorter* s, struct VdbSortItem* left, struct VdbSortItem* right) {
+    int result = 0;
+    for (int i = 0; i < s->ordering_cols->count && result == 0; i++) {
+        result = vdbvalue_compare(left->keys[i], right->keys[i]);
+    }
+
+    if (result == 0) {
+        uint32_t key_idx = s->schema->key_idx;
+        result = vdbvalue_compare(left->rec->data[key_idx], right->rec->data[key_idx]);
+    }
+
+    return s->order_desc ? -result : result;
+}
+
+static void vdbsorter_merge_sort_items(struct VdbSorter* s, struct VdbSortItem* items, struct VdbSortItem* tmp, uint32_t count) {
+    if (count < 2)
+        return;
+
+    uint32_t mid = count / 2;
+    vdbsorter_merge_sort_items(s, items, tmp, mid);
+    vdbsorter_merge_sort_items(s, items + mid, tmp, count - mid);
+
+    uint32_t l = 0;
+    uint32_t r = mid;
+    for (uint32_t i = 0; i < count; i++) {
+        if (r >= count || (l < mid && vdbsorter_compare(s, &items[l], &items[r]) <= 0)) {
+            tmp[i] = items[l++];
+        } else {
+            tmp[i] = items[r++];
+        }
+    }
+
+    memcpy(items, tmp, sizeof(struct VdbSortItem) * count);
+}
+
+static void vdbsorter_sort_items(struct VdbSorter* s) {
+    if (s->count < 2)
+        return;
+
+    struct VdbSortItem* tmp = malloc_w(sizeof(struct VdbSortItem) * s->count);
+    vdbsorter_merge_sort_items(s, s->items, tmp, s->count);
+    free_w(tmp, sizeof(struct VdbSortItem) * s->count);
+}
+
+/*
+ * Runs - records are written as [column count|values...] with text written out in full, since
+ * the temp file can't point to data blocks
+ */
+
+static void vdbsorter_write_value(FILE* f, struct VdbValue* v) {
+    uint8_t type = (uint8_t)v->type;
+    fwrite_w(&type, sizeof(uint8_t), 1, f);
+
+    switch (v->type) {
+        case VDBT_TYPE_TEXT: {
+            uint32_t len = v->as.Str.len;
+            fwrite_w(&len, sizeof(uint32_t), 1, f);
+            fwrite_w(v->as.Str.start, sizeof(char), len, f);
+            break;
+        }
+        case VDBT_TYPE_INT8:
+            fwrite_w(&v->as.Int, sizeof(int64_t), 1, f);
+            break;
+        case VDBT_TYPE_FLOAT8:
+            fwrite_w(&v->as.Float, sizeof(double), 1, f);
+            break;
+        case VDBT_TYPE_BOOL:
+            fwrite_w(&v->as.Bool, sizeof(bool), 1, f);
+            break;
+        case VDBT_TYPE_NULL:
+            break;
+        default:
+            assert(false && "invalid data type");
+            break;
+    }
+}
+
+static void vdbsorter_read_value(FILE* f, struct VdbValue* v) {
+    uint8_t type;
+    fread_w(&type, sizeof(uint8_t), 1, f);
+    v->type = (enum VdbTokenType)type;
+
+    switch (v->type) {
+        case VDBT_TYPE_TEXT: {
+            uint32_t len;
+            fread_w(&len, sizeof(uint32_t), 1, f);
+            v->as.Str.len = len;
+            v->as.Str.start = malloc_w(sizeof(char) * len);
+            v->as.Str.block_idx = 0;
+            v->as.Str.idxcell_idx = 0;
+            fread_w(v->as.Str.start, sizeof(char), len, f);
+            break;
+        }
+        case VDBT_TYPE_INT8:
+            fread_w(&v->as.Int, sizeof(int64_t), 1, f);
+            break;
+        case VDBT_TYPE_FLOAT8:
+            fread_w(&v->as.Float, sizeof(double), 1, f);
+            break;
+        case VDBT_TYPE_BOOL:
+            fread_w(&v->as.Bool, sizeof(bool), 1, f);
+            break;
+        case VDBT_TYPE_NULL:
+            break;
+        default:
+            assert(false && "invalid data type");
+            break;
+    }
+}
+
+static void vdbsorter_write_record(FILE* f, struct VdbRecord* rec) {
+    uint32_t count = rec->count;
+    fwrite_w(&count, sizeof(uint32_t), 1, f);
+    for (int i = 0; i < rec->count; i++) {
+        vdbsorter_write_value(f, &rec->data[i]);
+    }
+}
+
+static struct VdbRecord* vdbsorter_read_record(FILE* f) {
+    uint32_t count;
+    fread_w(&count, sizeof(uint32_t), 1, f);
+
+    struct VdbRecord* rec = malloc_w(sizeof(struct VdbRecord));
+    rec->count = count;
+    rec->data = malloc_w(sizeof(struct VdbValue) * count);
+    for (uint32_t i = 0; i < count; i++) {
+        vdbsorter_read_value(f, &rec->data[i]);
+    }
+
+    return rec;
+}
+
+//reads the next record of a run, or returns false if the run is done
+static bool vdbsorter_read_item(struct VdbSorter* s, uint32_t run, struct VdbSortItem* item) {
+    struct VdbSortRun* r = &s->runs[run];
+    if (r->count == 0)
+        return false;
+
+    r->count--;
+    *item = vdbsorter_item(s, vdbsorter_read_record(r->f));
+    item->run = run;
+
+    return true;
+}
+
+static void vdbsorter_append_run(struct VdbSorter* s, FILE* f, uint64_t count, uint32_t level) {
+    if (s->run_count == s->run_capacity) {
+        uint32_t old_cap = s->run_capacity;
+        s->run_capacity *= 2;
+        s->runs = realloc_w(s->runs, sizeof(struct VdbSortRun) * s->run_capacity, sizeof(struct VdbSortRun) * old_cap);
+    }
+
+    fseek_w(f, 0, SEEK_SET);
+    s->runs[s->run_count].f = f;
+    s->runs[s->run_count].count = count;
+    s->runs[s->run_count].level = level;
+    s->run_count++;
+}
+
+/*
+ * Merging - a min heap holds the next record of each run being merged
+ */
+
+static void vdbsorter_heap_sift_down(struct VdbSorter* s, uint32_t i) {
+    while (true) {
+        uint32_t min = i;
+        uint32_t left = 2 * i + 1;
+        uint32_t right = 2 * i + 2;
+        if (left < s->heap_count && vdbsorter_compare(s, &s->heap[left], &s->heap[min]) < 0) {
+            min = left;
+        }
+        if (right < s->heap_count && vdbsorter_compare(s, &s->heap[right], &s->heap[min]) < 0) {
+            min = right;
+        }
+
+        if (min == i)
+            return;
+
+        struct VdbSortItem tmp = s->heap[i];
+        s->heap[i] = s->heap[min];
+        s->heap[min] = tmp;
+        i = min;
+    }
+}
+
+static void vdbsorter_heap_init(struct VdbSorter* s, uint32_t first, uint32_t count) {
+    s->heap_capacity = count;
+    s->heap = malloc_w(sizeof(struct VdbSortItem) * s->heap_capacity);
+    s->heap_count = 0;
+
+    for (uint32_t i = first; i < first + count; i++) {
+        if (vdbsorter_read_item(s, i, &s->heap[s->heap_count])) {
+            s->heap_count++;
+        }
+    }
+
+    for (uint32_t i = s->heap_count / 2; i-- > 0;) {
+        vdbsorter_heap_sift_down(s, i);
+    }
+}
+
+//removes the smallest record, and replaces it with the next one from the same run
+static struct VdbSortItem vdbsorter_heap_pop(struct VdbSorter* s) {
+    struct VdbSortItem top = s->heap[0];
+    if (!vdbsorter_read_item(s, top.run, &s->heap[0])) {
+        s->heap[0] = s->heap[--s->heap_count];
+    }
+
+    if (s->heap_count > 0) {
+        vdbsorter_heap_sift_down(s, 0);
+    }
+
+    return top;
+}
+
+static void vdbsorter_heap_free(struct VdbSorter* s) {
+    for (uint32_t i = 0; i < s->heap_count; i++) {
+        vdbrecord_free(s->heap[i].rec);
+        vdbsorter_free_keys(s, &s->heap[i]);
+    }
+
+    free_w(s->heap, sizeof(struct VdbSortItem) * s->heap_capacity);
+    s->heap = NULL;
+    s->heap_count = 0;
+    s->heap_capacity = 0;
+}
+
+//merges the last VDB_SORT_FANIN runs into one while they are all the same level, like carrying
+//digits in a counter.  Records are rewritten once per level, and few temp files are open at once
+static void vdbsorter_collapse_runs(struct VdbSorter* s) {
+    while (s->run_count >= VDB_SORT_FANIN) {
+        uint32_t first = s->run_count - VDB_SORT_FANIN;
+        uint32_t level = s->runs[first].level;
+        if (s->runs[s->run_count - 1].level != level)
+            return;
+
+        FILE* f = tmpfile_w();
+        uint64_t count = 0;
+
+        vdbsorter_heap_init(s, first, VDB_SORT_FANIN);
+        while (s->heap_count > 0) {
+            struct VdbSortItem item = vdbsorter_heap_pop(s);
+            vdbsorter_write_record(f, item.rec);
+            vdbrecord_free(item.rec);
+            vdbsorter_free_keys(s, &item);
+            count++;
+        }
+        vdbsorter_heap_free(s);
+
+        for (uint32_t i = first; i < s->run_count; i++) {
+            fclose_w(s->runs[i].f);
+        }
+        s->run_count = first;
+
+        vdbsorter_append_run(s, f, count, level + 1);
+    }
+}
+
+//sorts the records in memory and writes them to a new run
+static void vdbsorter_spill(struct VdbSorter* s) {
+    vdbsorter_sort_items(s);
+
+    FILE* f = tmpfile_w();
+    for (uint32_t i = 0; i < s->count; i++) {
+        vdbsorter_write_record(f, s->items[i].rec);
+        vdbrecord_free(s->items[i].rec);
+        vdbsorter_free_keys(s, &s->items[i]);
+    }
+
+    vdbsorter_append_run(s, f, s->count, 0);
+    s->count = 0;
+    s->size = 0;
+
+    vdbsorter_collapse_runs(s);
+}
+
+/*
+ * Sorter
+ */
+
+//takes ownership of rec
+void vdbsorter_insert(struct VdbSorter* s, struct VdbRecord* rec) {
+    if (s->count == s->capacity) {
+        uint32_t old_cap = s->capacity;
+        s->capacity *= 2;
+        s->items = realloc_w(s->items, sizeof(struct VdbSortItem) * s->capacity, sizeof(struct VdbSortItem) * old_cap);
+    }
+
+    s->items[s->count] = vdbsorter_item(s, rec);
+    s->size += vdbsorter_item_size(s, &s->items[s->count]);
+    s->count++;
+
+    if (s->size > s->budget) {
+        vdbsorter_spill(s);
+    }
+}
+
+//called once every record is inserted.  If nothing was spilled the records are sorted in memory,
+//and otherwise the rest are spilled too and every run is merged as records are read
+void vdbsorter_finish(struct VdbSorter* s) {
+    if (s->run_count == 0) {
+        vdbsorter_sort_items(s);
+        return;
+    }
+
+    if (s->count > 0) {
+        vdbsorter_spill(s);
+    }
+
+    vdbsorter_heap_init(s, 0, s->run_count);
+}
+
+//returns the next record in order, which the caller then owns, or NULL when done
+struct VdbRecord* vdbsorter_next(struct VdbSorter* s) {
+    if (s->run_count == 0) {
+        if (s->next_item == s->count)
+            return NULL;
+
+        struct VdbSortItem* item = &s->items[s->next_item++];
+        vdbsorter_free_keys(s, item);
+        return item->rec;
+    }
+
+    if (s->heap_count == 0)
+        return NULL;
+
+    struct VdbSortItem item = vdbsorter_heap_pop(s);
+    vdbsorter_free_keys(s, &item);
+
+    return item.rec;
+}
+
+void vdbsorter_free(struct VdbSorter* s) {
+    for (uint32_t i = s->next_item; i < s->count; i++) {
+        vdbrecord_free(s->items[i].rec);
+        vdbsorter_free_keys(s, &s->items[i]);
+    }
+    free_w(s->items, sizeof(struct VdbSortItem) * s->capacity);
+
+    if (s->heap) {
+        vdbsorter_heap_free(s);
+    }
+
+    for (uint32_t i = 0; i < s->run_count; i++) {
+        fclose_w(s->runs[i].f);
+    }
+    free_w(s->runs, sizeof(struct VdbSortRun) * s->run_capacity);
+
+    free_w(s, sizeof(struct VdbSorter));
+}
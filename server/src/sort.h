@@ -0,0 +1,62 @@
+#ifndef VDB_SORT_H
+#define VDB_SORT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "record.h"
+#include "schema.h"
+#include "parser.h"
+
+#define VDB_SORT_FANIN 16 //runs merged together, and the most runs of one size kept before merging
+
+/*
+ * External merge sort - records are held until they take up the memory budget, and are then
+ * sorted and written to a temp file as a run.  Runs are merged as they pile up, and the rest
+ * are merged while records are read back, so a sort only ever holds about its budget
+ */
+
+//a record with the values of its ordering columns, and the run it was read from when merging
+struct VdbSortItem {
+    struct VdbRecord* rec;
+    struct VdbValue* keys;
+    uint32_t run;
+};
+
+struct VdbSortRun {
+    FILE* f;
+    uint64_t count; //records left to read
+    uint32_t level; //times its records have been merged
+};
+
+struct VdbSorter {
+    struct VdbSchema* schema;
+    struct VdbExprList* ordering_cols;
+    bool order_desc;
+    uint64_t budget;
+
+    //records in memory
+    struct VdbSortItem* items;
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t size;
+    uint32_t next_item;
+
+    struct VdbSortRun* runs;
+    uint32_t run_count;
+    uint32_t run_capacity;
+
+    //head of each run being merged by vdbsorter_next
+    struct VdbSortItem* heap;
+    uint32_t heap_count;
+    uint32_t heap_capacity;
+};
+
+struct VdbSorter* vdbsorter_init(struct VdbSchema* schema, struct VdbExprList* ordering_cols, bool order_desc, uint64_t budget);
+void vdbsorter_free(struct VdbSorter* s);
+void vdbsorter_insert(struct VdbSorter* s, struct VdbRecord* rec);
+void vdbsorter_finish(struct VdbSorter* s);
+struct VdbRecord* vdbsorter_next(struct VdbSorter* s);
+
+#endif //VDB_SORT_H
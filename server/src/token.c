@@ -91,6 +91,13 @@ void vdbtoken_print(struct VdbToken t) {
         case VDBT_HAVING: printf("VDBT_HAVING\n"); break;
         case VDBT_LIMIT: printf("VDBT_LIMIT\n"); break;
         case VDBT_KEY: printf("VDBT_KEY\n"); break;
+        case VDBT_PAGE_SIZE: printf("VDBT_PAGE_SIZE\n"); break;
+        case VDBT_CLUSTERED: printf("VDBT_CLUSTERED\n"); break;
+        case VDBT_COPY: printf("VDBT_COPY\n"); break;
+        case VDBT_VACUUM: printf("VDBT_VACUUM\n"); break;
+        case VDBT_INDEX: printf("VDBT_INDEX\n"); break;
+        case VDBT_ON: printf("VDBT_ON\n"); break;
+        case VDBT_HASH: printf("VDBT_HASH\n"); break;
         case VDBT_COMMENT: printf("VDBT_COMMENT\n"); break;
         default: printf("not implemented\n"); break;
     }
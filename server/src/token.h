@@ -71,7 +71,14 @@ enum VdbTokenType {
     VDBT_COMMENT,
     VDBT_BEGIN,
     VDBT_COMMIT,
-    VDBT_ROLLBACK
+    VDBT_ROLLBACK,
+    VDBT_PAGE_SIZE,
+    VDBT_CLUSTERED,
+    VDBT_COPY,
+    VDBT_VACUUM,
+    VDBT_INDEX,
+    VDBT_ON,
+    VDBT_HASH
 };
 
 struct VdbToken {
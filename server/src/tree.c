@@ -4,8 +4,9 @@
 
 #include "util.h"
 #include "tree.h"
+#include "index.h"
 
-static struct VdbPtr vdbtree_intern_read_right_ptr(struct VdbTree* tree, uint32_t idx);
+static uint32_t vdbtree_intern_read_right_ptr(struct VdbTree* tree, uint32_t idx);
 static struct VdbPtr vdbtree_intern_read_ptr(struct VdbTree* tree, uint32_t idx, uint32_t ptr_idx);
 static uint32_t vdbtree_data_init(struct VdbTree* tree, uint32_t parent_idx);
 static uint32_t vdbtree_intern_read_ptr_count(struct VdbTree* tree, uint32_t idx);
@@ -13,6 +14,9 @@ static enum VdbNodeType vdbtree_node_type(struct VdbTree* tree, uint32_t idx);
 void vdbtree_serialize_to_data_block_if_varlen(struct VdbTree* tree, struct VdbValue* v);
 void vdbtree_deserialize_from_data_block_if_varlen(struct VdbTree* tree, struct VdbValue* v);
 uint32_t vdbtree_get_data_block(struct VdbTree* tree, uint32_t datacell_size);
+static uint32_t vdbtree_intern_read_parent(struct VdbTree* tree, uint32_t idx);
+static bool vdbtree_text_overflows(struct VdbTree* tree, uint32_t len);
+static void vdbtree_overflow_free(struct VdbTree* tree, uint32_t idx);
 
 void vdbtree_serialize_value(struct VdbTree* tree, uint8_t* buf, struct VdbValue* v) {
     vdbtree_serialize_to_data_block_if_varlen(tree, v);
@@ -42,16 +46,16 @@ struct VdbRecPtr vdbtree_deserialize_recptr(struct VdbTree* tree, uint8_t* buf)
 
 struct VdbRecPtr vdbtree_append_record_to_datablock(struct VdbTree* tree, struct VdbRecord* r) {
     uint32_t data_idx = vdbtree_get_data_block(tree, vdbrecord_fixedlen_size(r));
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, data_idx);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, data_idx);
 
-    uint32_t idxcell_idx = vdbnode_new_idxcell(page->buf, vdbrecord_fixedlen_size(r));
+    uint32_t idxcell_idx = vdbnode_new_idxcell(page->buf, tree->page_size, vdbrecord_fixedlen_size(r));
 
     for (int i = 0; i < r->count; i++) {
         vdbtree_serialize_to_data_block_if_varlen(tree, &r->data[i]);
     }
     vdbrecord_serialize(vdbnode_datacell(page->buf, idxcell_idx), r);
 
-    vdbpager_unpin_page(page, true);
+    vdbpager_unpin_page(tree->pager, page, true);
 
     struct VdbRecPtr p;
     p.block_idx = data_idx;
@@ -61,29 +65,15 @@ struct VdbRecPtr vdbtree_append_record_to_datablock(struct VdbTree* tree, struct
     return p;
 }
 
-void vdbtree_write_record_to_datablock(struct VdbTree* tree, struct VdbRecord* r, uint32_t leaf_idx, uint32_t leaf_idxcell_idx) {
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, leaf_idx);
-    //TODO: need to free value if its heap allocated
-    struct VdbRecPtr p = vdbtree_deserialize_recptr(tree, vdbnode_datacell(page->buf, leaf_idxcell_idx));
-    vdbpager_unpin_page(page, false);
-
-    struct VdbPage* data_page = vdbpager_pin_page(tree->pager, tree->f, p.block_idx);
-    for (int i = 0; i < r->count; i++) {
-        vdbtree_serialize_to_data_block_if_varlen(tree, &r->data[i]);
-    }
-    vdbrecord_serialize(vdbnode_datacell(data_page->buf, p.idxcell_idx), r);
-    vdbpager_unpin_page(data_page, true);
-}
-
 struct VdbRecord* vdbtree_read_record_from_datablock(struct VdbTree* tree, struct VdbRecPtr* p) {
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, p->block_idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, p->block_idx);
 
     struct VdbRecord* r = vdbrecord_deserialize(vdbnode_datacell(page->buf, p->idxcell_idx), tree->schema);
     for (int i = 0; i < r->count; i++) {
         vdbtree_deserialize_from_data_block_if_varlen(tree, &r->data[i]);
     }
 
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
     return r;
 }
 
@@ -92,9 +82,9 @@ struct VdbRecord* vdbtree_read_record_from_datablock(struct VdbTree* tree, struc
  */
 
 static enum VdbNodeType vdbtree_node_type(struct VdbTree* tree, uint32_t idx) {
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
     enum VdbNodeType type = *vdbnode_type(page->buf);
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
     return type;
 }
 
@@ -102,63 +92,160 @@ static enum VdbNodeType vdbtree_node_type(struct VdbTree* tree, uint32_t idx) {
  * Tree wrappers for meta node
  */
 
-static uint32_t vdbtree_meta_init(struct VdbTree* tree, struct VdbSchema* schema) {
-    uint32_t idx = vdbpager_fresh_page(tree->f);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+//writes the cached meta fields back to the meta node
+static void vdbtree_meta_write(struct VdbTree* tree) {
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, tree->meta_idx);
+    assert(*vdbnode_type(page->buf) == VDBN_META);
+
+    *vdbmeta_auto_counter_ptr(page->buf) = tree->pk_counter;
+    *vdbmeta_root_ptr(page->buf) = tree->root_idx;
+    *vdbmeta_data_block_ptr(page->buf) = tree->data_block;
+    *vdbmeta_last_leaf(page->buf) = tree->last_leaf;
+    *vdbmeta_freelist_ptr(page->buf) = tree->freelist;
+
+    vdbpager_unpin_page(tree->pager, page, true);
+}
 
+static void vdbtree_meta_read(struct VdbTree* tree) {
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, tree->meta_idx);
+    assert(*vdbnode_type(page->buf) == VDBN_META);
+
+    tree->pk_counter = *vdbmeta_auto_counter_ptr(page->buf);
+    tree->root_idx = *vdbmeta_root_ptr(page->buf);
+    tree->data_block = *vdbmeta_data_block_ptr(page->buf);
+    tree->last_leaf = *vdbmeta_last_leaf(page->buf);
+    tree->freelist = *vdbmeta_freelist_ptr(page->buf);
+    tree->clustered = *vdbmeta_clustered_ptr(page->buf) != 0;
+    tree->schema = vdbschema_deserialize(vdbmeta_schema_ptr(page->buf));
+
+    vdbpager_unpin_page(tree->pager, page, false);
+}
+
+static uint32_t vdbtree_meta_init(struct VdbTree* tree, struct VdbSchema* schema) {
+    uint32_t idx = vdbpager_fresh_page(tree->pager, tree->fd);
+    tree->meta_idx = idx;
+    tree->pk_counter = 0;
+    tree->root_idx = 0;
+    tree->last_leaf = 0;
+    tree->freelist = 0; //page allocation goes through the free list, so it must be set before the data block
+    tree->data_block = vdbtree_data_init(tree, idx);
+
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
     *vdbnode_type(page->buf) = VDBN_META;
     *vdbnode_parent(page->buf) = 0;
-    *vdbmeta_auto_counter_ptr(page->buf) = 0;
-    *vdbmeta_root_ptr(page->buf) = 0;
-    *vdbmeta_data_block_ptr(page->buf) = vdbtree_data_init(tree, idx);
-    vdbmeta_allocate_schema_ptr(page->buf, vdbschema_serialized_size(schema));
+    *vdbmeta_clustered_ptr(page->buf) = tree->clustered;
+    vdbmeta_allocate_schema_ptr(page->buf, tree->page_size, vdbschema_serialized_size(schema));
     vdbschema_serialize(vdbmeta_schema_ptr(page->buf), schema);
+    vdbpager_unpin_page(tree->pager, page, true);
 
-    vdbpager_unpin_page(page, true);
+    vdbtree_meta_write(tree);
 
     return idx;
 }
 
 uint32_t vdbtree_meta_read_primary_key_counter(struct VdbTree* tree) {
-    assert(vdbtree_node_type(tree, 0) == VDBN_META);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, 0);
-    uint32_t pk_counter = *vdbmeta_auto_counter_ptr(page->buf);
-    vdbpager_unpin_page(page, false);
-    return pk_counter;
+    return tree->pk_counter;
 }
 
-uint32_t vdbtree_meta_read_root(struct VdbTree* tree) {
-    assert(vdbtree_node_type(tree, 0) == VDBN_META);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, 0);
-    uint32_t root_idx = *vdbmeta_root_ptr(page->buf);
-    vdbpager_unpin_page(page, false);
-    return root_idx;
+static void vdbtree_meta_write_root(struct VdbTree* tree, uint32_t root_idx) {
+    tree->root_idx = root_idx;
+    vdbtree_meta_write(tree);
 }
 
-static void vdbtree_meta_write_root(struct VdbTree* tree, uint32_t root_idx) {
-    assert(vdbtree_node_type(tree, 0) == VDBN_META);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, 0);
-    *vdbmeta_root_ptr(page->buf) = root_idx;
-    vdbpager_unpin_page(page, true);
+static void vdbtree_meta_write_last_leaf(struct VdbTree* tree, uint32_t leaf_idx) {
+    if (tree->last_leaf == leaf_idx)
+        return;
+    tree->last_leaf = leaf_idx;
+    vdbtree_meta_write(tree);
 }
 
 uint32_t vdbtree_meta_increment_primary_key_counter(struct VdbTree* tree) {
-    assert(vdbtree_node_type(tree, 0) == VDBN_META);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, 0);
-    *vdbmeta_auto_counter_ptr(page->buf) += 1;
-    uint32_t pk_counter = *vdbmeta_auto_counter_ptr(page->buf);
-    vdbpager_unpin_page(page, true);
+    tree->pk_counter++;
+    vdbtree_meta_write(tree);
+    return tree->pk_counter;
+}
 
-    return pk_counter;
+//keeps an in memory upper bound on the keys in the rightmost leaf, so appends can skip the descent
+void vdbtree_meta_update_largest_key(struct VdbTree* tree, struct VdbValue key) {
+    if (tree->has_largest_key) {
+        if (vdbvalue_compare(key, tree->largest_key) <= 0)
+            return;
+        vdbvalue_free(tree->largest_key);
+    }
+
+    tree->largest_key = vdbvalue_copy(key);
+    tree->has_largest_key = true;
+}
+
+/*
+ * Free page list
+ */
+
+//reuses a page from the free list if there is one, otherwise grows the file
+static uint32_t vdbtree_alloc_page(struct VdbTree* tree) {
+    uint32_t idx = tree->freelist;
+    if (idx == 0) {
+        return vdbpager_fresh_page(tree->pager, tree->fd);
+    }
+
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    assert(*vdbnode_type(page->buf) == VDBN_FREE && "page on free list is in use");
+    tree->freelist = *vdbnode_next(page->buf);
+    memset(page->buf, 0, tree->page_size);
+    vdbpager_unpin_page(tree->pager, page, true);
+
+    vdbtree_meta_write(tree);
+
+    return idx;
+}
+
+static void vdbtree_free_page(struct VdbTree* tree, uint32_t idx) {
+    assert(idx != tree->meta_idx && "cannot free meta node");
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+
+    *vdbnode_type(page->buf) = VDBN_FREE;
+    *vdbnode_parent(page->buf) = 0;
+    *vdbnode_next(page->buf) = tree->freelist;
+    tree->freelist = idx;
+
+    vdbpager_unpin_page(tree->pager, page, true);
+
+    vdbtree_meta_write(tree);
+}
+
+//frees a cell in a data block, and returns the block to the free list once it is empty.
+//The block new cells are allocated from is kept even if empty
+static void vdbtree_free_datablock_cell(struct VdbTree* tree, uint32_t block_idx, uint32_t idxcell_idx) {
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, block_idx);
+    vdbnode_free_cell_and_defrag_datacells_only(page->buf, idxcell_idx);
+    bool empty = *vdbnode_datacells_size(page->buf) == 0;
+    vdbpager_unpin_page(tree->pager, page, true);
+
+    if (empty && block_idx != tree->data_block) {
+        vdbtree_free_page(tree, block_idx);
+    }
+}
+
+//frees the data block cell holding the string of a serialized text value
+static void vdbtree_free_serialized_value(struct VdbTree* tree, uint8_t* buf) {
+    struct VdbValue v;
+    vdbvalue_deserialize(&v, buf);
+    if (v.type == VDBT_TYPE_TEXT) {
+        vdbtree_free_datablock_string(tree, &v);
+    }
 }
 
 /*
  * Tree wrappers for internal node
+ *
+ * Pointer cells are kept sorted by separator key.  Keys under the child of cell i are less than
+ * or equal to its separator and greater than the separator of cell i - 1.  Keys greater than
+ * the last separator are under the right pointer
  */
 
 static uint32_t vdbtree_intern_init(struct VdbTree* tree, uint32_t parent_idx) {
-    uint32_t idx = vdbpager_fresh_page(tree->f);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    uint32_t idx = vdbtree_alloc_page(tree);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
 
     *vdbnode_type(page->buf) = VDBN_INTERN;
     *vdbnode_parent(page->buf) = parent_idx;
@@ -168,135 +255,306 @@ static uint32_t vdbtree_intern_init(struct VdbTree* tree, uint32_t parent_idx) {
     *vdbnode_idxcells_freelist(page->buf) = 0;
     *vdbnode_datacells_freelist(page->buf) = 0;
 
-    vdbpager_unpin_page(page, true);
+    vdbpager_unpin_page(tree->pager, page, true);
 
     return idx;
 }
 
-static void vdbtree_intern_write_right_ptr(struct VdbTree* tree, uint32_t idx, struct VdbPtr ptr) {
+static void vdbtree_intern_write_right_ptr(struct VdbTree* tree, uint32_t idx, uint32_t block_idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
-    *vdbintern_rightptr_block(page->buf) = ptr.block_idx;
-    vdbtree_serialize_value(tree, vdbintern_rightptr_key(page->buf), &ptr.key);
-    vdbpager_unpin_page(page, true);
-}
-
-static void vdbtree_intern_write_new_ptr(struct VdbTree* tree, uint32_t idx, struct VdbPtr ptr) {
-    assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
-
-    uint32_t block_idx_size = sizeof(uint32_t);
-    uint32_t key_size = vdbvalue_serialized_size(ptr.key);
-    uint32_t idxcell_idx = vdbnode_new_idxcell(page->buf, block_idx_size + key_size);
-
-    uint8_t* buf = vdbnode_datacell(page->buf, idxcell_idx);
-    *((uint32_t*)buf) = ptr.block_idx;
-    vdbtree_serialize_value(tree, buf + sizeof(uint32_t), &ptr.key);
-
-    vdbpager_unpin_page(page, true);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    *vdbintern_rightptr_block(page->buf) = block_idx;
+    vdbpager_unpin_page(tree->pager, page, true);
 }
 
 static uint32_t vdbtree_intern_read_ptr_count(struct VdbTree* tree, uint32_t idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
     uint32_t count = *vdbnode_idxcell_count(page->buf);
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
     return count;
 }
 
 static struct VdbPtr vdbtree_intern_read_ptr(struct VdbTree* tree, uint32_t idx, uint32_t ptr_idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
 
     struct VdbPtr ptr;
     uint8_t* buf = vdbnode_datacell(page->buf, ptr_idx);
     ptr.block_idx = *((uint32_t*)buf);
     vdbtree_deserialize_value(tree, &ptr.key, buf + sizeof(uint32_t));
 
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
     return ptr;
 }
 
-static struct VdbPtr vdbtree_intern_read_right_ptr(struct VdbTree* tree, uint32_t idx) {
+static uint32_t vdbtree_intern_read_right_ptr(struct VdbTree* tree, uint32_t idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+    uint32_t right = *vdbintern_rightptr_block(page->buf);
+    vdbpager_unpin_page(tree->pager, page, false);
+    return right;
+}
 
-    struct VdbPtr right;
-    right.block_idx = *vdbintern_rightptr_block(page->buf);
-    vdbtree_deserialize_value(tree, &right.key, vdbintern_rightptr_key(page->buf));
+//parent of an internal or leaf node
+static uint32_t vdbtree_node_read_parent(struct VdbTree* tree, uint32_t idx) {
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+    uint32_t parent = *vdbnode_parent(page->buf);
+    vdbpager_unpin_page(tree->pager, page, false);
+    return parent;
+}
 
-    vdbpager_unpin_page(page, false);
-    return right;
+static void vdbtree_node_write_parent(struct VdbTree* tree, uint32_t idx, uint32_t parent) {
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    *vdbnode_parent(page->buf) = parent;
+    vdbpager_unpin_page(tree->pager, page, true);
 }
 
 static uint32_t vdbtree_intern_read_parent(struct VdbTree* tree, uint32_t idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
-    uint32_t parent = *vdbnode_parent(page->buf);
-    vdbpager_unpin_page(page, false);
-    return parent;
+    return vdbtree_node_read_parent(tree, idx);
+}
+
+//space used by a node's cells
+static uint32_t vdbtree_node_used_size(struct VdbTree* tree, uint32_t idx) {
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+    uint32_t used = vdbnode_used_size(page->buf);
+    vdbpager_unpin_page(tree->pager, page, false);
+    return used;
+}
+
+//nodes using less than this share of a page are merged with or refilled from a sibling
+static bool vdbtree_node_underfull(struct VdbTree* tree, uint32_t idx) {
+    uint32_t usable = tree->page_size - VDB_PAGE_HDR_SIZE;
+    return vdbtree_node_used_size(tree, idx) < usable * VDB_MERGE_FILL_PERCENT / 100;
 }
 
-static void vdbtree_intern_write_parent(struct VdbTree* tree, uint32_t idx, uint32_t parent) {
+//position of child among the pointers of internal node idx.  The right pointer comes last
+static uint32_t vdbtree_intern_find_child(struct VdbTree* tree, uint32_t idx, uint32_t child) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
-    *vdbnode_parent(page->buf) = parent;
-    vdbpager_unpin_page(page, true);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+    uint32_t count = *vdbnode_idxcell_count(page->buf);
+
+    uint32_t i = 0;
+    while (i < count && *((uint32_t*)vdbnode_datacell(page->buf, i)) != child) {
+        i++;
+    }
+
+    assert((i < count || *vdbintern_rightptr_block(page->buf) == child) && "child not found in internal node");
+    vdbpager_unpin_page(tree->pager, page, false);
+    return i;
 }
 
-static bool vdbtree_intern_can_fit_ptr(struct VdbTree* tree, uint32_t idx, struct VdbValue key) {
+static uint32_t vdbtree_intern_read_child(struct VdbTree* tree, uint32_t idx, uint32_t pos) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
-    uint32_t block_idx_size = sizeof(uint32_t);
-    bool can_fit = vdbnode_can_fit(page->buf, vdbvalue_serialized_size(key) + block_idx_size);
-    vdbpager_unpin_page(page, false);
-    return can_fit;
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+    uint32_t child;
+    if (pos < *vdbnode_idxcell_count(page->buf)) {
+        child = *((uint32_t*)vdbnode_datacell(page->buf, pos));
+    } else {
+        child = *vdbintern_rightptr_block(page->buf);
+    }
+    vdbpager_unpin_page(tree->pager, page, false);
+    return child;
 }
 
-static uint32_t vdbtree_intern_split(struct VdbTree* tree, uint32_t idx, struct VdbValue new_right_key) {
+//removes separator ptr_idx after its two children were merged into the left one, which takes
+//over the range of the right one.  free_key is false when the separator was moved elsewhere
+static void vdbtree_intern_remove_separator(struct VdbTree* tree, uint32_t idx, uint32_t ptr_idx, bool free_key) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    uint32_t count = *vdbnode_idxcell_count(page->buf);
+
+    uint8_t* cell = vdbnode_datacell(page->buf, ptr_idx);
+    uint32_t left = *((uint32_t*)cell);
+    if (free_key) {
+        vdbtree_free_serialized_value(tree, cell + sizeof(uint32_t));
+    }
+
+    if (ptr_idx + 1 < count) {
+        *((uint32_t*)vdbnode_datacell(page->buf, ptr_idx + 1)) = left;
+    } else {
+        *vdbintern_rightptr_block(page->buf) = left;
+    }
+
+    vdbnode_free_cell_and_defrag_node(page->buf, ptr_idx);
+    vdbpager_unpin_page(tree->pager, page, true);
+}
+
+//merges an underfull internal node with a sibling when both fit in one page, pulling their
+//separator down from the parent.  A root left with a single internal child is replaced by it
+static void vdbtree_intern_rebalance(struct VdbTree* tree, uint32_t idx) {
     uint32_t parent = vdbtree_intern_read_parent(tree, idx);
 
-    if (parent == 0) { //split full root
-        uint32_t old_root = vdbtree_meta_read_root(tree);
-        struct VdbValue old_key = vdbtree_intern_read_right_ptr(tree, old_root).key;
-        uint32_t new_root = vdbtree_intern_init(tree, 0);
-        struct VdbPtr new_left_ptr = {old_root, old_key};
-        vdbtree_intern_write_new_ptr(tree, new_root, new_left_ptr);
-        vdbtree_intern_write_parent(tree, old_root, new_root);
+    if (parent == tree->meta_idx) {
+        uint32_t child = vdbtree_intern_read_right_ptr(tree, idx);
+        if (vdbtree_intern_read_ptr_count(tree, idx) == 0 && vdbtree_node_type(tree, child) == VDBN_INTERN) {
+            vdbtree_node_write_parent(tree, child, tree->meta_idx);
+            vdbtree_meta_write_root(tree, child);
+            vdbtree_free_page(tree, idx);
+            vdbtree_intern_rebalance(tree, child);
+        }
+        return;
+    }
+
+    if (!vdbtree_node_underfull(tree, idx))
+        return;
+
+    //an only child can't merge, but its parent is then underfull too
+    uint32_t count = vdbtree_intern_read_ptr_count(tree, parent);
+    if (count == 0) {
+        vdbtree_intern_rebalance(tree, parent);
+        return;
+    }
+
+    uint32_t pos = vdbtree_intern_find_child(tree, parent, idx);
+    uint32_t sep_pos = pos < count ? pos : pos - 1;
+    uint32_t left = vdbtree_intern_read_child(tree, parent, sep_pos);
+    uint32_t right = vdbtree_intern_read_child(tree, parent, sep_pos + 1);
+
+    struct VdbPage* parent_page = vdbpager_pin_page_readonly(tree->pager, tree->fd, parent);
+    struct VdbPage* left_page = vdbpager_pin_page(tree->pager, tree->fd, left);
+    struct VdbPage* right_page = vdbpager_pin_page(tree->pager, tree->fd, right);
+
+    //the separator cell also needs an idxcell and a datacell header
+    uint32_t key_size = vdbnode_datacell_size(parent_page->buf, sep_pos) - sizeof(uint32_t);
+    uint32_t sep_used = sizeof(uint32_t) * 4 + key_size;
+    uint32_t merged = vdbnode_used_size(left_page->buf) + vdbnode_used_size(right_page->buf) + sep_used;
 
-        uint32_t new_right = vdbtree_intern_init(tree, new_root);
-        struct VdbPtr new_right_ptr = {new_right, new_right_key};
-        vdbtree_intern_write_right_ptr(tree, new_root, new_right_ptr);
-        
-        vdbtree_meta_write_root(tree, new_root);
-        return new_right;
-    } else if (vdbtree_intern_can_fit_ptr(tree, parent, new_right_key)) {
-        struct VdbPtr old_right = vdbtree_intern_read_right_ptr(tree, parent);
-        vdbtree_intern_write_new_ptr(tree, parent, old_right);
+    if (merged > tree->page_size - VDB_PAGE_HDR_SIZE) {
+        vdbpager_unpin_page(tree->pager, right_page, false);
+        vdbpager_unpin_page(tree->pager, left_page, false);
+        vdbpager_unpin_page(tree->pager, parent_page, false);
+        return;
+    }
+
+    //the separator comes down as the cell of the old right pointer of left
+    uint32_t i = vdbnode_new_idxcell(left_page->buf, tree->page_size, sizeof(uint32_t) + key_size);
+    uint8_t* cell = vdbnode_datacell(left_page->buf, i);
+    *((uint32_t*)cell) = *vdbintern_rightptr_block(left_page->buf);
+    memcpy(cell + sizeof(uint32_t), (uint8_t*)vdbnode_datacell(parent_page->buf, sep_pos) + sizeof(uint32_t), key_size);
+
+    uint32_t moved = *vdbnode_idxcell_count(right_page->buf);
+    uint32_t children[moved + 1];
+    for (uint32_t j = 0; j < moved; j++) {
+        children[j] = *((uint32_t*)vdbnode_datacell(right_page->buf, j));
+    }
+    children[moved] = *vdbintern_rightptr_block(right_page->buf);
 
-        uint32_t new_intern = vdbtree_intern_init(tree, parent);
-        struct VdbPtr new_right = {new_intern, new_right_key};
-        vdbtree_intern_write_right_ptr(tree, parent, new_right);
-        return new_intern;
-    } else { 
-        uint32_t new_parent = vdbtree_intern_split(tree, parent, new_right_key);
-        uint32_t new_intern = vdbtree_intern_init(tree, new_parent);
-        struct VdbPtr ptr = {new_intern, new_right_key};
-        vdbtree_intern_write_right_ptr(tree, new_parent, ptr);
-        return new_intern;
+    vdbnode_move_cells(right_page->buf, left_page->buf, tree->page_size, 0);
+    *vdbintern_rightptr_block(left_page->buf) = children[moved];
+
+    vdbpager_unpin_page(tree->pager, right_page, true);
+    vdbpager_unpin_page(tree->pager, left_page, true);
+    vdbpager_unpin_page(tree->pager, parent_page, false);
+
+    for (uint32_t j = 0; j <= moved; j++) {
+        vdbtree_node_write_parent(tree, children[j], left);
     }
 
+    vdbtree_intern_remove_separator(tree, parent, sep_pos, false);
+    vdbtree_free_page(tree, right);
+    vdbtree_intern_rebalance(tree, parent);
 }
 
+static void vdbtree_intern_insert(struct VdbTree* tree, uint32_t idx, uint32_t left, uint8_t* key, uint32_t key_size, uint32_t right);
+
+//moves the upper half of the pointers into a new sibling, and pushes the middle separator
+//up into the parent.  A new root is added when the root splits
+static void vdbtree_intern_split(struct VdbTree* tree, uint32_t idx) {
+    uint32_t parent = vdbtree_intern_read_parent(tree, idx);
+    if (parent == tree->meta_idx) {
+        parent = vdbtree_intern_init(tree, tree->meta_idx);
+        vdbtree_intern_write_right_ptr(tree, parent, idx);
+        vdbtree_node_write_parent(tree, idx, parent);
+        vdbtree_meta_write_root(tree, parent);
+    }
+
+    uint32_t sibling = vdbtree_intern_init(tree, parent);
+
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    struct VdbPage* sibling_page = vdbpager_pin_page(tree->pager, tree->fd, sibling);
+
+    uint32_t count = *vdbnode_idxcell_count(page->buf);
+    uint32_t mid = count / 2;
+
+    //the middle separator moves up, and its child becomes the right pointer
+    uint8_t* mid_cell = vdbnode_datacell(page->buf, mid);
+    uint32_t key_size = vdbnode_datacell_size(page->buf, mid) - sizeof(uint32_t);
+    uint8_t key[key_size];
+    memcpy(key, mid_cell + sizeof(uint32_t), key_size);
+    uint32_t mid_child = *((uint32_t*)mid_cell);
+
+    vdbnode_move_cells(page->buf, sibling_page->buf, tree->page_size, mid + 1);
+    *vdbintern_rightptr_block(sibling_page->buf) = *vdbintern_rightptr_block(page->buf);
+    vdbnode_free_cell_and_defrag_node(page->buf, mid);
+    *vdbintern_rightptr_block(page->buf) = mid_child;
+
+    uint32_t moved = *vdbnode_idxcell_count(sibling_page->buf);
+    uint32_t children[moved + 1];
+    for (uint32_t i = 0; i < moved; i++) {
+        children[i] = *((uint32_t*)vdbnode_datacell(sibling_page->buf, i));
+    }
+    children[moved] = *vdbintern_rightptr_block(sibling_page->buf);
+
+    vdbpager_unpin_page(tree->pager, sibling_page, true);
+    vdbpager_unpin_page(tree->pager, page, true);
+
+    for (uint32_t i = 0; i <= moved; i++) {
+        vdbtree_node_write_parent(tree, children[i], sibling);
+    }
+
+    vdbtree_intern_insert(tree, parent, idx, key, key_size, sibling);
+}
+
+//child 'left' was split into 'left' (keys <= separator) and 'right'.  key is the serialized
+//separator - any data block cell it references is owned by this node from now on
+static void vdbtree_intern_insert(struct VdbTree* tree, uint32_t idx, uint32_t left, uint8_t* key, uint32_t key_size, uint32_t right) {
+    assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
+    uint32_t cell_size = sizeof(uint32_t) + key_size;
+
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+    bool can_fit = vdbnode_can_fit(page->buf, tree->page_size, cell_size);
+    vdbpager_unpin_page(tree->pager, page, false);
+
+    //splitting moves 'left' into whichever half it belongs to
+    if (!can_fit) {
+        vdbtree_intern_split(tree, idx);
+        idx = vdbtree_node_read_parent(tree, left);
+    }
+
+    page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    uint32_t count = *vdbnode_idxcell_count(page->buf);
+    uint32_t i = 0;
+    while (i < count && *((uint32_t*)vdbnode_datacell(page->buf, i)) != left) {
+        i++;
+    }
+
+    //'right' takes over the old range of 'left' - either its cell or the right pointer
+    if (i < count) {
+        *((uint32_t*)vdbnode_datacell(page->buf, i)) = right;
+    } else {
+        assert(*vdbintern_rightptr_block(page->buf) == left && "split child not found in parent");
+        *vdbintern_rightptr_block(page->buf) = right;
+    }
+
+    vdbnode_insert_idxcell(page->buf, tree->page_size, i, cell_size);
+    uint8_t* cell = vdbnode_datacell(page->buf, i);
+    *((uint32_t*)cell) = left;
+    memcpy(cell + sizeof(uint32_t), key, key_size);
+
+    vdbpager_unpin_page(tree->pager, page, true);
+
+    vdbtree_node_write_parent(tree, right, idx);
+}
 
 /*
  * Tree wrappers for leaf node
  */
 
 static uint32_t vdbtree_leaf_init(struct VdbTree* tree, uint32_t parent_idx) {
-    uint32_t idx = vdbpager_fresh_page(tree->f);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    uint32_t idx = vdbtree_alloc_page(tree);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
 
     *vdbnode_type(page->buf) = VDBN_LEAF;
     *vdbnode_parent(page->buf) = parent_idx;
@@ -306,97 +564,420 @@ static uint32_t vdbtree_leaf_init(struct VdbTree* tree, uint32_t parent_idx) {
     *vdbnode_idxcells_freelist(page->buf) = 0;
     *vdbnode_datacells_freelist(page->buf) = 0;
 
-    vdbpager_unpin_page(page, true);
+    vdbpager_unpin_page(tree->pager, page, true);
 
     return idx;
 }
 
 static uint32_t vdbtree_leaf_read_parent(struct VdbTree* tree, uint32_t idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
     uint32_t parent_idx = *vdbnode_parent(page->buf);
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
     return parent_idx;
 }
 
 uint32_t vdbtree_leaf_read_record_count(struct VdbTree* tree, uint32_t idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
     uint32_t count = *vdbnode_idxcell_count(page->buf);
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
     return count;
 }
 
-struct VdbValue vdbtree_leaf_read_record_key(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx) {
+/*
+ * Leaf cells are record pointers [data block idx|idxcell idx|key].  In clustered tables they are
+ * the record itself, padded to the fixed length of the schema so updates can rewrite it in place
+ */
+
+static uint8_t* vdbtree_leaf_key_ptr(struct VdbTree* tree, uint8_t* cell) {
+    if (!tree->clustered)
+        return cell + sizeof(uint32_t) * 2;
+
+    //skip the columns before the key - nulls are shorter than other values
+    uint32_t off = 0;
+    for (uint32_t i = 0; i < tree->schema->key_idx; i++) {
+        struct VdbValue v;
+        off += vdbvalue_deserialize(&v, cell + off);
+    }
+
+    return cell + off;
+}
+
+static uint32_t vdbtree_leaf_cell_size(struct VdbTree* tree, struct VdbRecord* rec) {
+    if (tree->clustered)
+        return vdbschema_fixedlen_size(tree->schema);
+
+    return sizeof(uint32_t) * 2 + vdbvalue_serialized_size(rec->data[tree->schema->key_idx]);
+}
+
+//writes strings to data blocks, and the record into a clustered leaf cell
+static void vdbtree_leaf_serialize_record(struct VdbTree* tree, uint8_t* buf, struct VdbRecord* rec) {
+    for (int i = 0; i < rec->count; i++) {
+        vdbtree_serialize_to_data_block_if_varlen(tree, &rec->data[i]);
+    }
+
+    uint32_t size = vdbrecord_serialize(buf, rec);
+    memset(buf + size, 0, vdbschema_fixedlen_size(tree->schema) - size);
+}
+
+bool vdbtree_leaf_can_fit_record(struct VdbTree* tree, uint32_t idx, struct VdbRecord* rec) {
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+    bool can_fit = vdbnode_can_fit(page->buf, tree->page_size, vdbtree_leaf_cell_size(tree, rec));
+    vdbpager_unpin_page(tree->pager, page, false);
+    return can_fit;
+}
+
+void vdbtree_leaf_insert_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx, struct VdbRecord* rec) {
     assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    uint32_t size = vdbtree_leaf_cell_size(tree, rec);
 
-    struct VdbRecord* rec = vdbtree_leaf_read_record(tree, idx, rec_idx);
-    if (!rec) printf("rec is null\n"); //TODO: this should never happend...?
+    if (tree->clustered) {
+        struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+        vdbnode_insert_idxcell(page->buf, tree->page_size, rec_idx, size);
+        vdbtree_leaf_serialize_record(tree, vdbnode_datacell(page->buf, rec_idx), rec);
+        vdbpager_unpin_page(tree->pager, page, true);
+        return;
+    }
 
-    struct VdbValue v = rec->data[tree->schema->key_idx];
-    if (v.type == VDBT_TYPE_TEXT) {
-        v = vdbstring(v.as.Str.start, v.as.Str.len);
+    struct VdbRecPtr p = vdbtree_append_record_to_datablock(tree, rec);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    vdbnode_insert_idxcell(page->buf, tree->page_size, rec_idx, size);
+    vdbtree_serialize_recptr(tree, vdbnode_datacell(page->buf, rec_idx), &p);
+    vdbpager_unpin_page(tree->pager, page, true);
+}
+
+//overwrites a record - its strings must already have been freed
+void vdbtree_leaf_write_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx, struct VdbRecord* rec) {
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    uint8_t* cell = vdbnode_datacell(page->buf, rec_idx);
+
+    if (tree->clustered) {
+        vdbtree_leaf_serialize_record(tree, cell, rec);
+        vdbpager_unpin_page(tree->pager, page, true);
+        return;
     }
 
-    vdbrecord_free(rec);
+    struct VdbRecPtr p;
+    p.block_idx = *((uint32_t*)cell);
+    p.idxcell_idx = *((uint32_t*)(cell + sizeof(uint32_t)));
+    vdbpager_unpin_page(tree->pager, page, false);
+
+    struct VdbPage* data_page = vdbpager_pin_page(tree->pager, tree->fd, p.block_idx);
+    for (int i = 0; i < rec->count; i++) {
+        vdbtree_serialize_to_data_block_if_varlen(tree, &rec->data[i]);
+    }
+    vdbrecord_serialize(vdbnode_datacell(data_page->buf, p.idxcell_idx), rec);
+    vdbpager_unpin_page(tree->pager, data_page, true);
+}
 
-    vdbpager_unpin_page(page, false);
+//reads the key straight from the leaf cell, so a record in a data block isn't touched
+struct VdbValue vdbtree_leaf_read_record_key(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx) {
+    assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+
+    struct VdbValue v;
+    vdbtree_deserialize_value(tree, &v, vdbtree_leaf_key_ptr(tree, vdbnode_datacell(page->buf, rec_idx)));
+
+    vdbpager_unpin_page(tree->pager, page, false);
     return v;
 }
 
+//frees whatever storage a text value uses outside of the value itself
 void vdbtree_free_datablock_string(struct VdbTree* tree, struct VdbValue* v) {
-    struct VdbPage* data_page = vdbpager_pin_page(tree->pager, tree->f, v->as.Str.block_idx);
+    if (v->as.Str.len <= VDB_TEXT_INLINE_MAX) {
+        return;
+    }
+
+    if (vdbtree_text_overflows(tree, v->as.Str.len)) {
+        vdbtree_overflow_free(tree, v->as.Str.block_idx);
+    } else {
+        vdbtree_free_datablock_cell(tree, v->as.Str.block_idx, v->as.Str.idxcell_idx);
+    }
+}
+
+//frees the record, its strings and the leaf's copy of the key
+void vdbtree_leaf_delete_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx) {
+    assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+
+    uint8_t* buf = vdbnode_datacell(page->buf, rec_idx);
+
+    if (tree->clustered) {
+        uint32_t off = 0;
+        for (uint32_t i = 0; i < tree->schema->count; i++) {
+            struct VdbValue v;
+            off += vdbvalue_deserialize(&v, buf + off);
+            if (v.type == VDBT_TYPE_TEXT) {
+                vdbtree_free_datablock_string(tree, &v);
+            }
+        }
 
-    vdbnode_free_cell_and_defrag_datacells_only(data_page->buf, v->as.Str.idxcell_idx);
+        vdbnode_free_cell_and_defrag_node(page->buf, rec_idx);
+        vdbpager_unpin_page(tree->pager, page, true);
+        return;
+    }
 
-    vdbpager_unpin_page(data_page, true);
+    struct VdbRecPtr p;
+    p.block_idx = *((uint32_t*)buf);
+    p.idxcell_idx = *((uint32_t*)(buf + sizeof(uint32_t)));
+
+    struct VdbRecord* rec = vdbtree_read_record_from_datablock(tree, &p);
+    for (int i = 0; i < rec->count; i++) {
+        struct VdbValue v = rec->data[i];
+        if (v.type == VDBT_TYPE_TEXT) {
+            vdbtree_free_datablock_string(tree, &v);
+        }
+    }
+    vdbrecord_free(rec);
+
+    vdbtree_free_serialized_value(tree, buf + sizeof(uint32_t) * 2);
+    vdbtree_free_datablock_cell(tree, p.block_idx, p.idxcell_idx);
+    vdbnode_free_cell_and_defrag_node(page->buf, rec_idx);
+
+    vdbpager_unpin_page(tree->pager, page, true);
+}
+
+//replaces separator ptr_idx of internal node idx with a copy of the largest key in leaf
+static void vdbtree_intern_write_separator(struct VdbTree* tree, uint32_t idx, uint32_t ptr_idx, uint32_t leaf) {
+    struct VdbPage* leaf_page = vdbpager_pin_page_readonly(tree->pager, tree->fd, leaf);
+    uint32_t count = *vdbnode_idxcell_count(leaf_page->buf);
+    struct VdbValue sep;
+    vdbtree_deserialize_value(tree, &sep, vdbtree_leaf_key_ptr(tree, vdbnode_datacell(leaf_page->buf, count - 1)));
+    vdbpager_unpin_page(tree->pager, leaf_page, false);
+
+    //serialized keys of one type all have the same size, so the cell is rewritten in place
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    uint8_t* key = (uint8_t*)vdbnode_datacell(page->buf, ptr_idx) + sizeof(uint32_t);
+    assert(vdbnode_datacell_size(page->buf, ptr_idx) == sizeof(uint32_t) + vdbvalue_serialized_size(sep));
+    vdbtree_free_serialized_value(tree, key);
+    vdbtree_serialize_value(tree, key, &sep);
+    vdbpager_unpin_page(tree->pager, page, true);
+
+    vdbvalue_free(sep);
+}
+
+//merges an underfull leaf with a sibling under the same parent, or moves records over from the
+//sibling when they don't fit in one page.  rec_idx is a record position in idx, and follows the
+//record if it moves.  Returns the leaf now holding it
+uint32_t vdbtree_leaf_rebalance(struct VdbTree* tree, uint32_t idx, uint32_t* rec_idx) {
+    if (!vdbtree_node_underfull(tree, idx))
+        return idx;
+
+    uint32_t parent = vdbtree_leaf_read_parent(tree, idx);
+    uint32_t count = vdbtree_intern_read_ptr_count(tree, parent);
+    if (count == 0) {
+        vdbtree_intern_rebalance(tree, parent);
+        return idx;
+    }
+
+    //the sibling to the right, or to the left for the last child
+    uint32_t pos = vdbtree_intern_find_child(tree, parent, idx);
+    uint32_t sep_pos = pos < count ? pos : pos - 1;
+    uint32_t left = vdbtree_intern_read_child(tree, parent, sep_pos);
+    uint32_t right = vdbtree_intern_read_child(tree, parent, sep_pos + 1);
+
+    struct VdbPage* left_page = vdbpager_pin_page(tree->pager, tree->fd, left);
+    struct VdbPage* right_page = vdbpager_pin_page(tree->pager, tree->fd, right);
+    assert(*vdbnode_next(left_page->buf) == right && "siblings must be adjacent leaves");
+
+    uint32_t left_count = *vdbnode_idxcell_count(left_page->buf);
+    uint32_t right_count = *vdbnode_idxcell_count(right_page->buf);
+    uint32_t left_used = vdbnode_used_size(left_page->buf);
+    uint32_t right_used = vdbnode_used_size(right_page->buf);
+
+    if (left_used + right_used <= tree->page_size - VDB_PAGE_HDR_SIZE) {
+        vdbnode_move_cells(right_page->buf, left_page->buf, tree->page_size, 0);
+        *vdbnode_next(left_page->buf) = *vdbnode_next(right_page->buf);
+        vdbpager_unpin_page(tree->pager, right_page, true);
+        vdbpager_unpin_page(tree->pager, left_page, true);
+
+        if (tree->last_leaf == right) {
+            vdbtree_meta_write_last_leaf(tree, left);
+        }
+
+        vdbtree_intern_remove_separator(tree, parent, sep_pos, true);
+        vdbtree_free_page(tree, right);
+        vdbtree_intern_rebalance(tree, parent);
+
+        if (idx == right) {
+            *rec_idx += left_count;
+        }
+        return left;
+    }
+
+    //move cells from the fuller sibling until both are about even
+    uint32_t moved = 0;
+    if (idx == left) {
+        while (moved < right_count) {
+            uint32_t size = vdbnode_datacell_size(right_page->buf, moved) + sizeof(uint32_t) * 3;
+            if (left_used + size > right_used - size)
+                break;
+            left_used += size;
+            right_used -= size;
+            moved++;
+        }
+        vdbnode_move_head_cells(right_page->buf, left_page->buf, tree->page_size, moved);
+    } else {
+        while (moved < left_count - 1) {
+            uint32_t size = vdbnode_datacell_size(left_page->buf, left_count - 1 - moved) + sizeof(uint32_t) * 3;
+            if (right_used + size > left_used - size)
+                break;
+            right_used += size;
+            left_used -= size;
+            moved++;
+        }
+        vdbnode_move_cells_to_front(left_page->buf, right_page->buf, tree->page_size, left_count - moved);
+        *rec_idx += moved;
+    }
+
+    vdbpager_unpin_page(tree->pager, right_page, moved > 0);
+    vdbpager_unpin_page(tree->pager, left_page, moved > 0);
+
+    if (moved > 0) {
+        vdbtree_intern_write_separator(tree, parent, sep_pos, left);
+    }
+
+    return idx;
+}
+
+//values of the first col_count columns of count records in a leaf, without building the records.  Text
+//values still point into the pages, which are unpinned by then, so only the other types can be used
+void vdbtree_leaf_read_values(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx, uint32_t count, uint32_t col_count, struct VdbValue* out) {
+    assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+
+    for (uint32_t r = 0; r < count; r++) {
+        uint8_t* cell = vdbnode_datacell(page->buf, rec_idx + r);
+        struct VdbValue* values = out + r * col_count;
+
+        if (tree->clustered) {
+            uint32_t off = 0;
+            for (uint32_t i = 0; i < col_count; i++) {
+                off += vdbvalue_deserialize(&values[i], cell + off);
+            }
+        } else {
+            uint32_t block_idx = *((uint32_t*)cell);
+            uint32_t idxcell_idx = *((uint32_t*)(cell + sizeof(uint32_t)));
+            struct VdbPage* block = vdbpager_pin_page_readonly(tree->pager, tree->fd, block_idx);
+            uint8_t* buf = vdbnode_datacell(block->buf, idxcell_idx);
+
+            uint32_t off = 0;
+            for (uint32_t i = 0; i < col_count; i++) {
+                off += vdbvalue_deserialize(&values[i], buf + off);
+            }
+
+            vdbpager_unpin_page(tree->pager, block, false);
+        }
+    }
+
+    vdbpager_unpin_page(tree->pager, page, false);
 }
 
 struct VdbRecord* vdbtree_leaf_read_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
 
-    struct VdbRecPtr p = vdbtree_deserialize_recptr(tree, vdbnode_datacell(page->buf, rec_idx));
-    struct VdbRecord* r = vdbtree_read_record_from_datablock(tree, &p);
+    struct VdbRecord* r;
+    if (tree->clustered) {
+        r = vdbrecord_deserialize(vdbnode_datacell(page->buf, rec_idx), tree->schema);
+        for (int i = 0; i < r->count; i++) {
+            vdbtree_deserialize_from_data_block_if_varlen(tree, &r->data[i]);
+        }
+    } else {
+        uint8_t* cell = vdbnode_datacell(page->buf, rec_idx);
+        struct VdbRecPtr p;
+        p.block_idx = *((uint32_t*)cell);
+        p.idxcell_idx = *((uint32_t*)(cell + sizeof(uint32_t)));
+        r = vdbtree_read_record_from_datablock(tree, &p);
+    }
 
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
     return r;
 }
 
-uint32_t vdbtree_leaf_split(struct VdbTree* tree, uint32_t idx, struct VdbValue new_right_key) {
+//splits a full leaf in half and returns the leaf key should be inserted into.  Appends past
+//the end of the rightmost leaf start a new empty leaf instead, so sequential inserts leave full leaves
+uint32_t vdbtree_leaf_split(struct VdbTree* tree, uint32_t idx, struct VdbValue key) {
     assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
 
     uint32_t parent = vdbtree_leaf_read_parent(tree, idx);
+    uint32_t sibling = vdbtree_leaf_init(tree, parent);
 
-    if (!vdbtree_intern_can_fit_ptr(tree, parent, new_right_key)) {
-        parent = vdbtree_intern_split(tree, parent, new_right_key);
-    } else {
-        //copy right pointer into ptr list to make room for new right ptr
-        uint32_t count = vdbtree_leaf_read_record_count(tree, idx);
-        struct VdbValue last_rec_key = vdbtree_leaf_read_record_key(tree, idx, count - 1);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
+    struct VdbPage* sibling_page = vdbpager_pin_page(tree->pager, tree->fd, sibling);
 
-        struct VdbPtr ptr = {idx, last_rec_key};
-        vdbtree_intern_write_new_ptr(tree, parent, ptr);
+    uint32_t count = *vdbnode_idxcell_count(page->buf);
+    assert(count > 0 && "cannot split empty leaf");
+    bool rightmost = *vdbnode_next(page->buf) == 0;
+
+    struct VdbValue last_key;
+    vdbtree_deserialize_value(tree, &last_key, vdbtree_leaf_key_ptr(tree, vdbnode_datacell(page->buf, count - 1)));
+    bool append = rightmost && vdbvalue_compare(key, last_key) > 0;
+    vdbvalue_free(last_key);
+
+    uint32_t mid = append ? count : (count > 1 ? count / 2 : 1);
+    vdbnode_move_cells(page->buf, sibling_page->buf, tree->page_size, mid);
+    *vdbnode_next(sibling_page->buf) = *vdbnode_next(page->buf);
+    *vdbnode_next(page->buf) = sibling;
+
+    //separator is a copy of the largest key left behind
+    struct VdbValue sep;
+    vdbtree_deserialize_value(tree, &sep, vdbtree_leaf_key_ptr(tree, vdbnode_datacell(page->buf, mid - 1)));
+    bool insert_left = vdbvalue_compare(key, sep) <= 0;
+    uint32_t sep_size = vdbvalue_serialized_size(sep);
+    uint8_t sep_buf[sep_size];
+    vdbtree_serialize_value(tree, sep_buf, &sep);
+    vdbvalue_free(sep);
+
+    vdbpager_unpin_page(tree->pager, sibling_page, true);
+    vdbpager_unpin_page(tree->pager, page, true);
+
+    if (rightmost) {
+        vdbtree_meta_write_last_leaf(tree, sibling);
     }
 
-    uint32_t new_leaf = vdbtree_leaf_init(tree, parent);
-    struct VdbPtr new_right = {new_leaf, new_right_key};
-    vdbtree_intern_write_right_ptr(tree, parent, new_right);
+    vdbtree_intern_insert(tree, parent, idx, sep_buf, sep_size, sibling);
+
+    return insert_left ? idx : sibling;
+}
+
+//appends records with keys past the largest key in the tree, sorted ascending.  Leaves are filled
+//to VDB_BULK_FILL_PERCENT before an append split starts the next one, so no descents are needed
+void vdbtree_append_records(struct VdbTree* tree, struct VdbRecord** recs, uint32_t count) {
+    uint32_t key_idx = tree->schema->key_idx;
+    uint32_t fill_size = tree->page_size * VDB_BULK_FILL_PERCENT / 100;
+    uint32_t leaf = tree->last_leaf;
+
+    for (uint32_t i = 0; i < count; i++) {
+        struct VdbValue key = recs[i]->data[key_idx];
+        assert(tree->has_largest_key && vdbvalue_compare(key, tree->largest_key) > 0 && "appended keys must be past the largest key");
+        assert((i == 0 || vdbvalue_compare(key, recs[i - 1]->data[key_idx]) > 0) && "duplicate keys not allowed");
+
+        struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, leaf);
+        uint32_t rec_count = *vdbnode_idxcell_count(page->buf);
+        bool fits = rec_count == 0 || vdbnode_can_fit(page->buf, fill_size, vdbtree_leaf_cell_size(tree, recs[i]));
+        vdbpager_unpin_page(tree->pager, page, false);
+
+        if (!fits) {
+            leaf = vdbtree_leaf_split(tree, leaf, key);
+            rec_count = 0;
+        }
 
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
-    *vdbnode_next(page->buf) = new_leaf;
-    vdbpager_unpin_page(page, true);
+        vdbtree_leaf_insert_record(tree, leaf, rec_count, recs[i]);
+    }
 
-    return new_leaf;
+    if (count > 0) {
+        vdbtree_meta_update_largest_key(tree, recs[count - 1]->data[key_idx]);
+    }
 }
 
 uint32_t vdbtree_leaf_read_next_leaf(struct VdbTree* tree, uint32_t idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_LEAF);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
     uint32_t next_leaf_idx = *vdbnode_next(page->buf);
 
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
 
     return next_leaf_idx;
 }
@@ -406,8 +987,8 @@ uint32_t vdbtree_leaf_read_next_leaf(struct VdbTree* tree, uint32_t idx) {
  */
 
 static uint32_t vdbtree_data_init(struct VdbTree* tree, uint32_t parent_idx) {
-    uint32_t idx = vdbpager_fresh_page(tree->f);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
+    uint32_t idx = vdbtree_alloc_page(tree);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idx);
 
     *vdbnode_type(page->buf) = VDBN_DATA;
     *vdbnode_parent(page->buf) = parent_idx;
@@ -417,7 +998,7 @@ static uint32_t vdbtree_data_init(struct VdbTree* tree, uint32_t parent_idx) {
     *vdbnode_idxcells_freelist(page->buf) = 0;
     *vdbnode_datacells_freelist(page->buf) = 0;
 
-    vdbpager_unpin_page(page, true);
+    vdbpager_unpin_page(tree->pager, page, true);
 
     return idx;
 }
@@ -426,141 +1007,232 @@ static uint32_t vdbtree_data_init(struct VdbTree* tree, uint32_t parent_idx) {
  * VdbTree API
  */
 
-struct VdbTree* vdb_tree_init(const char* name, struct VdbSchema* schema, struct VdbPager* pager, FILE* f) {
+struct VdbTree* vdb_tree_init(const char* name, struct VdbSchema* schema, struct VdbPager* pager, int fd, uint32_t page_size, bool clustered) {
     struct VdbTree* tree = malloc_w(sizeof(struct VdbTree));
     tree->name = strdup_w(name);
     tree->pager = pager;
-    tree->f = f;
+    tree->fd = fd;
+    tree->page_size = page_size;
     tree->schema = vdb_schema_copy(schema);
+    tree->clustered = clustered;
+    tree->has_largest_key = false;
+    tree->indexes = vdbindexlist_init();
+
+    vdbpager_create_file(pager, fd, page_size);
 
     uint32_t meta_idx = vdbtree_meta_init(tree, schema);
-    tree->meta_idx = meta_idx;
     uint32_t root_idx = vdbtree_intern_init(tree, meta_idx);
     vdbtree_meta_write_root(tree, root_idx);
     uint32_t leaf_idx = vdbtree_leaf_init(tree, root_idx);
-    struct VdbPtr right_ptr = {leaf_idx, vdbint(0)};
-    vdbtree_intern_write_right_ptr(tree, root_idx, right_ptr);
+    vdbtree_intern_write_right_ptr(tree, root_idx, leaf_idx);
+    vdbtree_meta_write_last_leaf(tree, leaf_idx); //kept pointing at the rightmost leaf by splits
 
     return tree;
 }
 
-struct VdbTree* vdb_tree_open(const char* name, FILE* f, struct VdbPager* pager) {
+struct VdbTree* vdb_tree_open(const char* name, int fd, struct VdbPager* pager) {
     struct VdbTree* tree = malloc_w(sizeof(struct VdbTree));
-    tree->name = strdup(name);
-    tree->f = f;
+    tree->name = strdup_w(name);
+    tree->fd = fd;
     tree->pager = pager;
-    tree->meta_idx = 0;
+    tree->meta_idx = 1; //page 0 is the file header
 
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, 0);
-    tree->schema = vdbschema_deserialize(vdbmeta_schema_ptr(page->buf));
-    vdbpager_unpin_page(page, false);
+    tree->page_size = vdbpager_open_file(pager, fd);
+    if (tree->page_size == 0) {
+        free_w(tree->name, sizeof(char) * (strlen(tree->name) + 1));
+        free_w(tree, sizeof(struct VdbTree));
+        return NULL;
+    }
+
+    vdbtree_meta_read(tree);
+    tree->indexes = vdbindexlist_init();
+
+    //the largest key isn't persisted - the last key in the rightmost leaf is a tight bound
+    tree->has_largest_key = false;
+    if (tree->last_leaf != 0) {
+        uint32_t count = vdbtree_leaf_read_record_count(tree, tree->last_leaf);
+        if (count > 0) {
+            tree->largest_key = vdbtree_leaf_read_record_key(tree, tree->last_leaf, count - 1);
+            tree->has_largest_key = true;
+        }
+    }
 
     return tree;
 }
 
-void vdb_tree_close(struct VdbTree* tree) {
-    fclose_w(tree->f);
+//drops the tree from the pager and frees it, but leaves its file open
+void vdb_tree_release(struct VdbTree* tree) {
+    vdbindexlist_free(tree->indexes);
+    vdbpager_close_file(tree->pager, tree->fd);
+    vdb_schema_free(tree->schema);
+    if (tree->has_largest_key) {
+        vdbvalue_free(tree->largest_key);
+    }
     free_w(tree->name, sizeof(char) * (strlen(tree->name) + 1));
     free_w(tree, sizeof(struct VdbTree));
-    vdb_schema_free(tree->schema);
+}
+
+void vdb_tree_close(struct VdbTree* tree) {
+    int fd = tree->fd;
+    vdb_tree_release(tree);
+    close_w(fd);
 }
 
 uint32_t vdbtree_traverse_to_first_leaf(struct VdbTree* tree, uint32_t idx) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
 
-    if (vdbtree_intern_read_ptr_count(tree, idx) > 0) {
-        struct VdbPtr p = vdbtree_intern_read_ptr(tree, idx, 0);
-        if (vdbtree_node_type(tree, p.block_idx) == VDBN_LEAF) {
-            return p.block_idx;
+    while (vdbtree_node_type(tree, idx) == VDBN_INTERN) {
+        if (vdbtree_intern_read_ptr_count(tree, idx) > 0) {
+            struct VdbPtr p = vdbtree_intern_read_ptr(tree, idx, 0);
+            vdbvalue_free(p.key);
+            idx = p.block_idx;
         } else {
-            return vdbtree_traverse_to_first_leaf(tree, p.block_idx);
-        }
-    } else {
-        struct VdbPtr p = vdbtree_intern_read_right_ptr(tree, idx);
-
-        if (vdbtree_node_type(tree, p.block_idx) == VDBN_LEAF) {
-            return p.block_idx;
-        } else {
-            return vdbtree_traverse_to_first_leaf(tree, p.block_idx);
+            idx = vdbtree_intern_read_right_ptr(tree, idx);
         }
     }
 
+    return idx;
 }
 
+//descends to the leaf that holds (or would hold) key, binary searching the separators
+//of one internal node per level
 uint32_t vdb_tree_traverse_to(struct VdbTree* tree, uint32_t idx, struct VdbValue key) {
     assert(vdbtree_node_type(tree, idx) == VDBN_INTERN);
 
-    //Check to see if any ptrs have correct key
-    //TODO: switch to binary search
-    for (uint32_t i = 0; i < vdbtree_intern_read_ptr_count(tree, idx); i++) {
-        struct VdbPtr p = vdbtree_intern_read_ptr(tree, idx, i);
-        if (vdbtree_node_type(tree, p.block_idx) == VDBN_LEAF && vdbtree_leaf_read_record_count(tree, p.block_idx) > 0) {
-            struct VdbValue last_rec_key = vdbtree_leaf_read_record_key(tree, p.block_idx, vdbtree_leaf_read_record_count(tree, p.block_idx) - 1);
-            if (vdbvalue_compare(key, last_rec_key) <= 0) {
-                return p.block_idx;
-            }
-        } else if (vdbtree_node_type(tree, p.block_idx) == VDBN_INTERN) {
-            //get largest key for a given internal node, and compare to key
-            struct VdbPtr right = vdbtree_intern_read_right_ptr(tree, p.block_idx);
-            while (vdbtree_node_type(tree, right.block_idx) != VDBN_LEAF) {
-                right = vdbtree_intern_read_right_ptr(tree, right.block_idx);
-            }
-            struct VdbValue last_rec_key = vdbtree_leaf_read_record_key(tree, right.block_idx, vdbtree_leaf_read_record_count(tree, right.block_idx) - 1);
-            if (vdbvalue_compare(key, last_rec_key) <= 0) {
-                return vdb_tree_traverse_to(tree, p.block_idx, key);
+    while (vdbtree_node_type(tree, idx) == VDBN_INTERN) {
+        struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+        uint32_t count = *vdbnode_idxcell_count(page->buf);
+
+        //first separator greater than or equal to key
+        uint32_t left = 0;
+        uint32_t right = count;
+        while (left < right) {
+            uint32_t mid = left + (right - left) / 2;
+            struct VdbValue sep;
+            vdbtree_deserialize_value(tree, &sep, (uint8_t*)vdbnode_datacell(page->buf, mid) + sizeof(uint32_t));
+            int result = vdbvalue_compare(key, sep);
+            vdbvalue_free(sep);
+
+            if (result <= 0) {
+                right = mid;
+            } else {
+                left = mid + 1;
             }
         }
-    }
 
-    //if not found, check right pointer
-    struct VdbPtr p = vdbtree_intern_read_right_ptr(tree, idx);
+        uint32_t child;
+        if (left < count) {
+            child = *((uint32_t*)vdbnode_datacell(page->buf, left));
+        } else {
+            child = *vdbintern_rightptr_block(page->buf);
+        }
 
-    if (vdbtree_node_type(tree, p.block_idx) == VDBN_LEAF) {
-        return p.block_idx;
-    } else {
-        return vdb_tree_traverse_to(tree, p.block_idx, key);
+        vdbpager_unpin_page(tree->pager, page, false);
+        idx = child;
     }
 
+    return idx;
 }
 
 uint32_t vdbtree_get_data_block(struct VdbTree* tree, uint32_t datacell_size) {
-    struct VdbPage* meta_page = vdbpager_pin_page(tree->pager, tree->f, 0);
-    uint32_t data_idx = *vdbmeta_data_block_ptr(meta_page->buf);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, data_idx);
-
-    if (!vdbnode_can_fit(page->buf, datacell_size)) {
-        uint32_t old_data_idx = data_idx;
-        data_idx = vdbtree_data_init(tree, 0);
-        *vdbmeta_data_block_ptr(meta_page->buf) = data_idx;
-        vdbpager_unpin_page(page, false);
-        page = vdbpager_pin_page(tree->pager, tree->f, data_idx);
-        *vdbnode_next(page->buf) = old_data_idx;
-        vdbpager_unpin_page(page, true);
-    } else {
-        vdbpager_unpin_page(page, false);
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, tree->data_block);
+    bool can_fit = vdbnode_can_fit(page->buf, tree->page_size, datacell_size);
+    vdbpager_unpin_page(tree->pager, page, false);
+
+    //data blocks aren't chained - a full block is only reachable through the records in it,
+    //and goes back on the free list once they are all deleted
+    if (!can_fit) {
+        tree->data_block = vdbtree_data_init(tree, 0);
+        vdbtree_meta_write(tree);
+    }
+
+    return tree->data_block;
+}
+
+/*
+ * Text storage
+ *
+ * Strings up to VDB_TEXT_INLINE_MAX bytes are kept in the serialized value.  Longer strings get
+ * a data block cell, and strings too long to share a data block are chained across overflow pages
+ */
+
+static bool vdbtree_text_overflows(struct VdbTree* tree, uint32_t len) {
+    return len > tree->page_size / 4;
+}
+
+static uint32_t vdbtree_overflow_write(struct VdbTree* tree, char* s, uint32_t len) {
+    uint32_t capacity = vdboverflow_capacity(tree->page_size);
+    uint32_t count = (len + capacity - 1) / capacity;
+    uint32_t idxs[count];
+    for (uint32_t i = 0; i < count; i++) {
+        idxs[i] = vdbtree_alloc_page(tree);
     }
 
-    vdbpager_unpin_page(meta_page, true);
+    for (uint32_t i = 0; i < count; i++) {
+        struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, idxs[i]);
+        *vdbnode_type(page->buf) = VDBN_OVERFLOW;
+        *vdbnode_parent(page->buf) = 0;
+        *vdbnode_next(page->buf) = i + 1 < count ? idxs[i + 1] : 0;
+
+        uint32_t off = i * capacity;
+        uint32_t size = len - off < capacity ? len - off : capacity;
+        memcpy(vdboverflow_data(page->buf), s + off, size);
+        vdbpager_unpin_page(tree->pager, page, true);
+    }
 
-    return data_idx;
+    return idxs[0];
+}
+
+static char* vdbtree_overflow_read(struct VdbTree* tree, uint32_t idx, uint32_t len) {
+    uint32_t capacity = vdboverflow_capacity(tree->page_size);
+    char* s = malloc_w(sizeof(char) * len);
+
+    for (uint32_t off = 0; off < len; off += capacity) {
+        struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+        assert(*vdbnode_type(page->buf) == VDBN_OVERFLOW && "string overflow chain is broken");
+        uint32_t size = len - off < capacity ? len - off : capacity;
+        memcpy(s + off, vdboverflow_data(page->buf), size);
+        uint32_t next = *vdbnode_next(page->buf);
+        vdbpager_unpin_page(tree->pager, page, false);
+        idx = next;
+    }
+
+    return s;
+}
+
+static void vdbtree_overflow_free(struct VdbTree* tree, uint32_t idx) {
+    while (idx != 0) {
+        struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+        uint32_t next = *vdbnode_next(page->buf);
+        vdbpager_unpin_page(tree->pager, page, false);
+
+        vdbtree_free_page(tree, idx);
+        idx = next;
+    }
 }
 
 void vdbtree_serialize_to_data_block_if_varlen(struct VdbTree* tree, struct VdbValue* v) {
-    if (v->type != VDBT_TYPE_TEXT) {
+    if (v->type != VDBT_TYPE_TEXT || v->as.Str.len <= VDB_TEXT_INLINE_MAX) {
+        return;
+    }
+
+    if (vdbtree_text_overflows(tree, v->as.Str.len)) {
+        v->as.Str.block_idx = vdbtree_overflow_write(tree, v->as.Str.start, v->as.Str.len);
+        v->as.Str.idxcell_idx = 0;
         return;
     }
 
     uint32_t datacell_size = sizeof(uint32_t) + v->as.Str.len + sizeof(uint8_t);
     uint32_t data_idx = vdbtree_get_data_block(tree, datacell_size);
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, data_idx);
+    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->fd, data_idx);
 
-    uint32_t idxcell_idx = vdbnode_new_idxcell(page->buf, datacell_size);
+    uint32_t idxcell_idx = vdbnode_new_idxcell(page->buf, tree->page_size, datacell_size);
     vdbvalue_serialize_string(vdbnode_datacell(page->buf, idxcell_idx), v);
 
     v->as.Str.block_idx = data_idx;
     v->as.Str.idxcell_idx = idxcell_idx;
 
-    vdbpager_unpin_page(page, true);
+    vdbpager_unpin_page(tree->pager, page, true);
 }
 
 void vdbtree_deserialize_from_data_block_if_varlen(struct VdbTree* tree, struct VdbValue* v) {
@@ -568,11 +1240,24 @@ void vdbtree_deserialize_from_data_block_if_varlen(struct VdbTree* tree, struct
         return;
     }
 
-    struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, v->as.Str.block_idx);
+    //inline strings still point into the page the value was deserialized from
+    if (v->as.Str.len <= VDB_TEXT_INLINE_MAX) {
+        char* s = malloc_w(sizeof(char) * v->as.Str.len);
+        memcpy(s, v->as.Str.start, v->as.Str.len);
+        v->as.Str.start = s;
+        return;
+    }
+
+    if (vdbtree_text_overflows(tree, v->as.Str.len)) {
+        v->as.Str.start = vdbtree_overflow_read(tree, v->as.Str.block_idx, v->as.Str.len);
+        return;
+    }
+
+    struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, v->as.Str.block_idx);
     void* ptr = vdbnode_datacell(page->buf, v->as.Str.idxcell_idx);
     vdbvalue_deserialize_string(v, ptr);
 
-    vdbpager_unpin_page(page, false);
+    vdbpager_unpin_page(tree->pager, page, false);
 }
 
 struct VdbTreeList* vdb_treelist_init() {
@@ -621,6 +1306,19 @@ struct VdbTree* vdb_treelist_remove_tree(struct VdbTreeList* tl, const char* nam
     return t;
 }
 
+//puts tree in place of the tree with the same name, and returns the one it replaced
+struct VdbTree* vdb_treelist_replace_tree(struct VdbTreeList* tl, struct VdbTree* tree) {
+    for (int i = 0; i < tl->count; i++) {
+        struct VdbTree* t = tl->trees[i];
+        if (strcmp(tree->name, t->name) == 0) {
+            tl->trees[i] = tree;
+            return t;
+        }
+    }
+
+    return NULL;
+}
+
 void vdb_treelist_free(struct VdbTreeList* tl) {
     for (int i = 0; i < tl->count; i++) {
         struct VdbTree* t = tl->trees[i];
@@ -642,21 +1340,22 @@ static void vdbtree_print_node(struct VdbTree* tree, uint32_t idx, uint32_t dept
         printf("\n");
         //TODO: make not printing leaves an option later
         /*
-        if (vdbtree_node_type(tree, vdbtree_intern_read_right_ptr(tree, idx).block_idx) == VDBN_LEAF) {
+        if (vdbtree_node_type(tree, vdbtree_intern_read_right_ptr(tree, idx)) == VDBN_LEAF) {
             return;
         }*/
         for (uint32_t i = 0; i < vdbtree_intern_read_ptr_count(tree, idx); i++) {
             vdbtree_print_node(tree, vdbtree_intern_read_ptr(tree, idx, i).block_idx, depth + 1);
         }
-        vdbtree_print_node(tree, vdbtree_intern_read_right_ptr(tree, idx).block_idx, depth + 1);
+        vdbtree_print_node(tree, vdbtree_intern_read_right_ptr(tree, idx), depth + 1);
     } else {
         printf(": ");
         for (uint32_t i = 0; i < vdbtree_leaf_read_record_count(tree, idx); i++) {
 
-            struct VdbPage* page = vdbpager_pin_page(tree->pager, tree->f, idx);
-            struct VdbRecPtr p = vdbtree_deserialize_recptr(tree, vdbnode_datacell(page->buf, i));
-            vdbpager_unpin_page(page, false);
-            printf("%d", p.block_idx);
+            //data block holding the record, or the leaf itself in clustered tables
+            struct VdbPage* page = vdbpager_pin_page_readonly(tree->pager, tree->fd, idx);
+            uint32_t block_idx = tree->clustered ? idx : *((uint32_t*)vdbnode_datacell(page->buf, i));
+            vdbpager_unpin_page(tree->pager, page, false);
+            printf("%d", block_idx);
 
             if (i < vdbtree_leaf_read_record_count(tree, idx) - 1) {
                 printf(", ");
@@ -668,6 +1367,6 @@ static void vdbtree_print_node(struct VdbTree* tree, uint32_t idx, uint32_t dept
 }
 
 void vdbtree_print(struct VdbTree* tree) {
-    uint32_t root = vdbtree_meta_read_root(tree);
+    uint32_t root = tree->root_idx;
     vdbtree_print_node(tree, root, 0);
 }
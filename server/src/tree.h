@@ -8,12 +8,29 @@
 #include "record.h"
 #include "pager.h"
 
+#define VDB_BULK_FILL_PERCENT 90 //leaves filled by appends are split once this full, leaving room for later inserts
+#define VDB_MERGE_FILL_PERCENT 40 //nodes left less full than this by a delete are merged with or refilled from a sibling
+
+struct VdbIndexList;
+
 struct VdbTree {
     char* name;
-    FILE* f;
+    int fd;
     struct VdbPager* pager;
     uint32_t meta_idx;
+    uint32_t page_size;
     struct VdbSchema* schema;
+    bool clustered; //leaves hold whole records instead of pointers into data blocks
+
+    //copy of the meta node fields - reads never touch the meta page, and changes are written through
+    uint32_t root_idx;
+    uint32_t last_leaf;
+    uint32_t data_block;
+    uint32_t freelist;
+    uint32_t pk_counter;
+    bool has_largest_key;
+    struct VdbValue largest_key; //upper bound on keys in the rightmost leaf, not stored on disk
+    struct VdbIndexList* indexes; //secondary indexes kept in step with the records, empty for index trees
 };
 
 struct VdbTreeList {
@@ -25,36 +42,43 @@ struct VdbTreeList {
 struct VdbPage* vdb_tree_pin_page(struct VdbTree* tree, uint32_t idx);
 void vdb_tree_unpin_page(struct VdbTree* tree, struct VdbPage* page);
 
-struct VdbTree* vdb_tree_init(const char* name, struct VdbSchema* schema, struct VdbPager* pager, FILE* f);
-struct VdbTree* vdb_tree_open(const char* name, FILE* f, struct VdbPager* pager);
+struct VdbTree* vdb_tree_init(const char* name, struct VdbSchema* schema, struct VdbPager* pager, int fd, uint32_t page_size, bool clustered);
+struct VdbTree* vdb_tree_open(const char* name, int fd, struct VdbPager* pager);
+void vdb_tree_release(struct VdbTree* tree);
 void vdb_tree_close(struct VdbTree* tree);
 
 uint32_t vdbtree_meta_increment_primary_key_counter(struct VdbTree* tree);
+void vdbtree_meta_update_largest_key(struct VdbTree* tree, struct VdbValue key);
 
 struct VdbTreeList* vdb_treelist_init();
 void vdb_treelist_append_tree(struct VdbTreeList* tl, struct VdbTree* tree);
 struct VdbTree* vdb_treelist_get_tree(struct VdbTreeList* tl, const char* name);
 struct VdbTree* vdb_treelist_remove_tree(struct VdbTreeList* tl, const char* name);
+struct VdbTree* vdb_treelist_replace_tree(struct VdbTreeList* tl, struct VdbTree* tree);
 void vdb_treelist_free(struct VdbTreeList* tl);
 
 bool vdbtree_leaf_can_fit_record(struct VdbTree* tree, uint32_t idx, struct VdbRecord* rec);
+void vdbtree_leaf_insert_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx, struct VdbRecord* rec);
+void vdbtree_leaf_write_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx, struct VdbRecord* rec);
 uint32_t vdbtree_leaf_split(struct VdbTree* tree, uint32_t idx, struct VdbValue new_right_key);
+void vdbtree_append_records(struct VdbTree* tree, struct VdbRecord** recs, uint32_t count);
 uint32_t vdbtree_leaf_read_record_count(struct VdbTree* tree, uint32_t idx);
+void vdbtree_leaf_read_values(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx, uint32_t count, uint32_t col_count, struct VdbValue* out);
 struct VdbRecord* vdbtree_leaf_read_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx);
 uint32_t vdbtree_meta_read_primary_key_counter(struct VdbTree* tree);
 struct VdbValue vdbtree_leaf_read_record_key(struct VdbTree* tree, uint32_t leaf_idx, uint32_t rec_idx);
 void vdbtree_free_datablock_string(struct VdbTree* tree, struct VdbValue* v);
+void vdbtree_leaf_delete_record(struct VdbTree* tree, uint32_t idx, uint32_t rec_idx);
+uint32_t vdbtree_leaf_rebalance(struct VdbTree* tree, uint32_t idx, uint32_t* rec_idx);
 
 uint32_t vdb_tree_traverse_to(struct VdbTree* tree, uint32_t idx, struct VdbValue key);
 uint32_t vdbtree_traverse_to_first_leaf(struct VdbTree* tree, uint32_t idx);
-uint32_t vdbtree_meta_read_root(struct VdbTree* tree);
 uint32_t vdbtree_leaf_read_next_leaf(struct VdbTree* tree, uint32_t idx);
 
 void vdbtree_serialize_value(struct VdbTree* tree, uint8_t* buf, struct VdbValue* v);
 void vdbtree_deserialize_value(struct VdbTree* tree, struct VdbValue* v, uint8_t* buf);
 
 struct VdbRecPtr vdbtree_append_record_to_datablock(struct VdbTree* tree, struct VdbRecord* r);
-void vdbtree_write_record_to_datablock(struct VdbTree* tree, struct VdbRecord* r, uint32_t leaf_idx, uint32_t leaf_idxcell_idx);
 struct VdbRecord* vdbtree_read_record_from_datablock(struct VdbTree* tree, struct VdbRecPtr* p);
 void vdbtree_serialize_recptr(struct VdbTree* tree, uint8_t* buf, struct VdbRecPtr* p);
 struct VdbRecPtr vdbtree_deserialize_recptr(struct VdbTree* tree, uint8_t* buf);
@@ -80,6 +80,54 @@ void vdbbytelist_append_bytes(struct VdbByteList* bl, uint8_t* bytes, int count)
     bl->count += count;
 }
 
+void vdbrwlock_init(struct VdbRWLock* l) {
+    mtx_init(&l->lock, mtx_plain);
+    cnd_init(&l->cond);
+    l->readers = 0;
+    l->writers_waiting = 0;
+    l->writer = false;
+}
+
+void vdbrwlock_destroy(struct VdbRWLock* l) {
+    cnd_destroy(&l->cond);
+    mtx_destroy(&l->lock);
+}
+
+void vdbrwlock_read_lock(struct VdbRWLock* l) {
+    mtx_lock(&l->lock);
+    while (l->writer || l->writers_waiting > 0) {
+        cnd_wait(&l->cond, &l->lock);
+    }
+    l->readers++;
+    mtx_unlock(&l->lock);
+}
+
+void vdbrwlock_read_unlock(struct VdbRWLock* l) {
+    mtx_lock(&l->lock);
+    if (--l->readers == 0) {
+        cnd_broadcast(&l->cond);
+    }
+    mtx_unlock(&l->lock);
+}
+
+void vdbrwlock_write_lock(struct VdbRWLock* l) {
+    mtx_lock(&l->lock);
+    l->writers_waiting++;
+    while (l->writer || l->readers > 0) {
+        cnd_wait(&l->cond, &l->lock);
+    }
+    l->writers_waiting--;
+    l->writer = true;
+    mtx_unlock(&l->lock);
+}
+
+void vdbrwlock_write_unlock(struct VdbRWLock* l) {
+    mtx_lock(&l->lock);
+    l->writer = false;
+    cnd_broadcast(&l->cond);
+    mtx_unlock(&l->lock);
+}
+
 int get_filename(FILE* f, char* buf, ssize_t max_len) {
     get_pathname(f, buf, max_len);
     char* end = strrchr(buf, '/');
@@ -193,6 +241,13 @@ FILE* fopen_w(const char* filename, const char* mode) {
     return f;
 }
 
+FILE* tmpfile_w() {
+    FILE* f;
+    if (!(f = tmpfile()))
+        err_quit("tmpfile failed");
+    return f;
+}
+
 int fclose_w(FILE* f) {
     int res;
     if ((res = fclose(f)) == EOF)
@@ -200,6 +255,75 @@ int fclose_w(FILE* f) {
     return res;
 }
 
+int open_w(const char* pathname, int flags, int mode) {
+    int fd;
+    if ((fd = open(pathname, flags, mode)) == -1)
+        err_quit("open failed");
+    return fd;
+}
+
+int close_w(int fd) {
+    int res;
+    if ((res = close(fd)) == -1)
+        err_quit("close failed");
+    return res;
+}
+
+//positioned reads/writes don't touch the file offset, so threads can share a descriptor
+ssize_t pread_w(int fd, void* buf, size_t count, off_t offset) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t res = pread(fd, (uint8_t*)buf + done, count - done, offset + done);
+        if (res <= 0)
+            err_quit("pread failed");
+        done += res;
+    }
+
+    return done;
+}
+
+ssize_t pwrite_w(int fd, const void* buf, size_t count, off_t offset) {
+    size_t done = 0;
+    while (done < count) {
+        ssize_t res = pwrite(fd, (const uint8_t*)buf + done, count - done, offset + done);
+        if (res <= 0)
+            err_quit("pwrite failed");
+        done += res;
+    }
+
+    return done;
+}
+
+//iov entries are advanced in place on short writes
+ssize_t pwritev_w(int fd, struct iovec* iov, int iovcnt, off_t offset) {
+    size_t done = 0;
+    while (iovcnt > 0) {
+        ssize_t res = pwritev(fd, iov, iovcnt, offset + done);
+        if (res <= 0)
+            err_quit("pwritev failed");
+        done += res;
+
+        while (iovcnt > 0 && (size_t)res >= iov->iov_len) {
+            res -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (uint8_t*)iov->iov_base + res;
+            iov->iov_len -= res;
+        }
+    }
+
+    return done;
+}
+
+off_t fsize_w(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+        err_quit("fstat failed");
+    return st.st_size;
+}
+
 void* calloc_w(size_t count, size_t size) {
     allocated_memory += count * size;
     void* ptr;
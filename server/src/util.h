@@ -5,6 +5,10 @@
 #include <stdio.h>
 #include <dirent.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <threads.h>
+#include <sys/types.h>
+#include <sys/uio.h>
 
 extern uint64_t allocated_memory;
 
@@ -20,6 +24,15 @@ struct VdbByteList {
     int capacity;
 };
 
+//readers-writer lock.  Writers wait for active readers, and new readers queue behind waiting writers
+struct VdbRWLock {
+    mtx_t lock;
+    cnd_t cond;
+    uint32_t readers;
+    uint32_t writers_waiting;
+    bool writer;
+};
+
 struct VdbIntList* vdbintlist_init();
 void vdbintlist_free(struct VdbIntList* il);
 void vdbintlist_append_int(struct VdbIntList* il, int value);
@@ -30,6 +43,13 @@ void vdbbytelist_append_byte(struct VdbByteList* bl, uint8_t byte);
 void vdbbytelist_append_bytes(struct VdbByteList* bl, uint8_t* bytes, int count);
 void vdbbytelist_resize(struct VdbByteList* bl, int size);
 
+void vdbrwlock_init(struct VdbRWLock* l);
+void vdbrwlock_destroy(struct VdbRWLock* l);
+void vdbrwlock_read_lock(struct VdbRWLock* l);
+void vdbrwlock_read_unlock(struct VdbRWLock* l);
+void vdbrwlock_write_lock(struct VdbRWLock* l);
+void vdbrwlock_write_unlock(struct VdbRWLock* l);
+
 //wrappers
 int get_filename(FILE* f, char* buf, ssize_t max_len);
 int get_pathname(FILE* f, char* buf, ssize_t max_len);
@@ -42,7 +62,14 @@ size_t fwrite_w(void* ptr, size_t size, size_t count, FILE* f);
 int fseek_w(FILE* f, long offset, int whence);
 long ftell_w(FILE* f);
 FILE* fopen_w(const char* filename, const char* mode);
+FILE* tmpfile_w();
 int fclose_w(FILE* f);
+int open_w(const char* pathname, int flags, int mode);
+int close_w(int fd);
+ssize_t pread_w(int fd, void* buf, size_t count, off_t offset);
+ssize_t pwrite_w(int fd, const void* buf, size_t count, off_t offset);
+ssize_t pwritev_w(int fd, struct iovec* iov, int iovcnt, off_t offset);
+off_t fsize_w(int fd);
 void* calloc_w(size_t count, size_t size);
 void* malloc_w(size_t size);
 void* realloc_w(void* ptr, size_t new_size, size_t prev_size);
@@ -12,7 +12,7 @@ int vdbvalue_serialized_size(struct VdbValue v) {
 
     switch (v.type) {
         case VDBT_TYPE_TEXT: {
-            size += sizeof(uint32_t) * 2;
+            size += sizeof(uint32_t) + VDB_TEXT_INLINE_MAX;
             break;
         }
         case VDBT_TYPE_INT8: {
@@ -70,11 +70,18 @@ int vdbvalue_serialize(uint8_t* buf, struct VdbValue v) {
 
     switch (v.type) {
         case VDBT_TYPE_TEXT: {
-            assert(v.as.Str.block_idx != 0 && "block idx not set");
-            *((uint32_t*)(buf + off)) = v.as.Str.block_idx;
-            off += sizeof(uint32_t);
-            *((uint32_t*)(buf + off)) = v.as.Str.idxcell_idx;
+            //[len|string] for short strings, otherwise [len|block idx|idxcell idx] - always the same size
+            *((uint32_t*)(buf + off)) = v.as.Str.len;
             off += sizeof(uint32_t);
+            memset(buf + off, 0, VDB_TEXT_INLINE_MAX);
+            if (v.as.Str.len <= VDB_TEXT_INLINE_MAX) {
+                memcpy(buf + off, v.as.Str.start, v.as.Str.len);
+            } else {
+                assert(v.as.Str.block_idx != 0 && "block idx not set");
+                *((uint32_t*)(buf + off)) = v.as.Str.block_idx;
+                *((uint32_t*)(buf + off + sizeof(uint32_t))) = v.as.Str.idxcell_idx;
+            }
+            off += VDB_TEXT_INLINE_MAX;
             break;
         }
         case VDBT_TYPE_INT8: {
@@ -114,6 +121,7 @@ void vdbvalue_deserialize_string(struct VdbValue* v, uint8_t* buf) {
     off += v->as.Str.len;
 }
 
+//short strings are left pointing into buf - vdbtree_deserialize_value makes the copy
 int vdbvalue_deserialize(struct VdbValue* v, uint8_t* buf) {
     int off = 0;
     v->type = (enum VdbTokenType)(*((uint8_t*)(buf + off)));
@@ -121,10 +129,17 @@ int vdbvalue_deserialize(struct VdbValue* v, uint8_t* buf) {
 
     switch (v->type) {
         case VDBT_TYPE_TEXT: {
-            v->as.Str.block_idx = *((uint32_t*)(buf + off));
-            off += sizeof(uint32_t);
-            v->as.Str.idxcell_idx = *((uint32_t*)(buf + off));
+            v->as.Str.len = *((uint32_t*)(buf + off));
             off += sizeof(uint32_t);
+            v->as.Str.block_idx = 0;
+            v->as.Str.idxcell_idx = 0;
+            if (v->as.Str.len <= VDB_TEXT_INLINE_MAX) {
+                v->as.Str.start = (char*)(buf + off);
+            } else {
+                v->as.Str.block_idx = *((uint32_t*)(buf + off));
+                v->as.Str.idxcell_idx = *((uint32_t*)(buf + off + sizeof(uint32_t)));
+            }
+            off += VDB_TEXT_INLINE_MAX;
             break;
         }
         case VDBT_TYPE_INT8: {
@@ -199,8 +214,18 @@ struct VdbValue vdbvalue_copy(struct VdbValue v) {
 int vdbvalue_compare(struct VdbValue v1, struct VdbValue v2) {
     assert(v1.type == v2.type && "value types must be the same to compared");
     switch (v1.type) {
-        case VDBT_TYPE_TEXT:
-            return strncmp(v1.as.Str.start, v2.as.Str.start, v1.as.Str.len > v2.as.Str.len ? v1.as.Str.len : v2.as.Str.len);
+        case VDBT_TYPE_TEXT: {
+            //strings aren't null terminated, so compare the common prefix and then the lengths
+            uint32_t len = v1.as.Str.len < v2.as.Str.len ? v1.as.Str.len : v2.as.Str.len;
+            int result = memcmp(v1.as.Str.start, v2.as.Str.start, len);
+            if (result != 0)
+                return result;
+            if (v1.as.Str.len < v2.as.Str.len)
+                return -1;
+            if (v1.as.Str.len > v2.as.Str.len)
+                return 1;
+            break;
+        }
         case VDBT_TYPE_INT8:
             if (v1.as.Int < v2.as.Int)
                 return -1;
@@ -7,6 +7,8 @@
 #include "token.h"
 #include "util.h"
 
+#define VDB_TEXT_INLINE_MAX 16 //strings up to this length are stored in the serialized value itself
+
 struct VdbString {
     char* start;
     uint32_t len;
@@ -0,0 +1,17 @@
+create database bulk;
+open bulk;
+
+create table runs (id int8 key, name text, odd bool);
+insert into runs (id, name, odd) values (162, "r162", false), (238, "r238", false), (148, "r148", false), (250, "r250", false), (172, "r172", false), (110, "r110", false), (256, "r256", false), (142, "r142", false), (272, "r272", false), (240, "r240", false), (140, "r140", false), (278, "r278", false), (232, "r232", false), (218, "r218", false), (152, "r152", false), (138, "r138", false), (100, "r100", false), (234, "r234", false), (128, "r128", false), (126, "r126", false), (104, "r104", false), (108, "r108", false), (212, "r212", false), (216, "r216", false), (112, "r112", false), (268, "r268", false), (160, "r160", false), (222, "r222", false), (246, "r246", false), (130, "r130", false), (184, "r184", false), (198, "r198", false), (150, "r150", false), (242, "r242", false), (288, "r288", false), (284, "r284", false), (276, "r276", false), (228, "r228", false), (220, "r220", false), (248, "r248", false), (200, "r200", false), (124, "r124", false), (252, "r252", false), (122, "r122", false), (168, "r168", false), (196, "r196", false), (230, "r230", false), (186, "r186", false), (206, "r206", false), (116, "r116", false), (194, "r194", false), (178, "r178", false), (258, "r258", false), (280, "r280", false), (188, "r188", false), (260, "r260", false), (226, "r226", false), (202, "r202", false), (176, "r176", false), (204, "r204", false), (144, "r144", false), (114, "r114", false), (182, "r182", false), (180, "r180", false), (244, "r244", false), (192, "r192", false), (208, "r208", false), (224, "r224", false), (286, "r286", false), (190, "r190", false), (164, "r164", false), (134, "r134", false), (262, "r262", false), (214, "r214", false), (298, "r298", false), (120, "r120", false), (282, "r282", false), (170, "r170", false), (102, "r102", false), (254, "r254", false), (292, "r292", false), (210, "r210", false), (106, "r106", false), (296, "r296", false), (154, "r154", false), (236, "r236", false), (118, "r118", false), (132, "r132", false), (290, "r290", false), (264, "r264", false), (156, "r156", false), (136, "r136", false), (270, "r270", false), (158, "r158", false), (266, "r266", false), (146, "r146", false), (294, "r294", false), (274, "r274", false), (174, "r174", false), (166, "r166", false);
+insert into runs (id, name, odd) values (131, "r131", true), (61, "r61", true), (437, "r437", true), (477, "r477", true), (466, "r466", false), (308, "r308", false), (409, "r409", true), (443, "r443", true), (594, "r594", false), (399, "r399", true), (353, "r353", true), (531, "r531", true), (447, "r447", true), (581, "r581", true), (328, "r328", false), (505, "r505", true), (79, "r79", true), (589, "r589", true), (472, "r472", false), (498, "r498", false), (359, "r359", true), (387, "r387", true), (433, "r433", true), (517, "r517", true), (329, "r329", true), (307, "r307", true), (429, "r429", true), (373, "r373", true), (302, "r302", false), (376, "r376", false), (483, "r483", true), (383, "r383", true), (481, "r481", true), (519, "r519", true), (374, "r374", false), (552, "r552", false), (557, "r557", true), (381, "r381", true), (111, "r111", true), (435, "r435", true), (401, "r401", true), (417, "r417", true), (553, "r553", true), (516, "r516", false), (322, "r322", false), (364, "r364", false), (16, "r16", false), (542, "r542", false), (343, "r343", true), (423, "r423", true), (43, "r43", true), (303, "r303", true), (313, "r313", true), (475, "r475", true), (486, "r486", false), (310, "r310", false), (571, "r571", true), (309, "r309", true), (527, "r527", true), (28, "r28", false), (315, "r315", true), (418, "r418", false), (407, "r407", true), (395, "r395", true), (91, "r91", true), (569, "r569", true), (469, "r469", true), (410, "r410", false), (300, "r300", false), (441, "r441", true), (464, "r464", false), (338, "r338", false), (455, "r455", true), (530, "r530", false), (94, "r94", false), (453, "r453", true), (354, "r354", false), (560, "r560", false), (412, "r412", false), (587, "r587", true), (384, "r384", false), (366, "r366", false), (19, "r19", true), (520, "r520", false), (547, "r547", true), (445, "r445", true), (457, "r457", true), (344, "r344", false), (536, "r536", false), (388, "r388", false), (570, "r570", false), (454, "r454", false), (456, "r456", false), (340, "r340", false), (347, "r347", true), (421, "r421", true), (508, "r508", false), (567, "r567", true), (386, "r386", false), (480, "r480", false), (503, "r503", true), (512, "r512", false), (385, "r385", true), (52, "r52", false), (473, "r473", true), (400, "r400", false), (425, "r425", true), (538, "r538", false), (450, "r450", false), (562, "r562", false), (362, "r362", false), (537, "r537", true), (13, "r13", true), (330, "r330", false), (422, "r422", false), (596, "r596", false), (598, "r598", false), (451, "r451", true), (348, "r348", false), (556, "r556", false), (599, "r599", true), (489, "r489", true), (316, "r316", false), (405, "r405", true), (459, "r459", true), (402, "r402", false), (438, "r438", false), (375, "r375", true), (584, "r584", false), (430, "r430", false), (597, "r597", true), (509, "r509", true), (493, "r493", true), (540, "r540", false), (426, "r426", false), (463, "r463", true), (576, "r576", false), (578, "r578", false), (595, "r595", true), (583, "r583", true), (434, "r434", false), (424, "r424", false), (549, "r549", true), (1, "r1", true), (490, "r490", false), (510, "r510", false), (525, "r525", true), (471, "r471", true), (325, "r325", true), (539, "r539", true), (528, "r528", false), (488, "r488", false), (360, "r360", false), (491, "r491", true), (73, "r73", true), (496, "r496", false), (31, "r31", true), (487, "r487", true), (181, "r181", true), (591, "r591", true), (506, "r506", false), (514, "r514", false), (326, "r326", false), (391, "r391", true), (82, "r82", false), (10, "r10", false), (468, "r468", false), (22, "r22", false), (452, "r452", false), (458, "r458", false), (518, "r518", false), (323, "r323", true), (566, "r566", false), (494, "r494", false), (461, "r461", true), (333, "r333", true), (358, "r358", false), (522, "r522", false), (495, "r495", true), (545, "r545", true), (501, "r501", true), (414, "r414", false), (88, "r88", false), (442, "r442", false), (397, "r397", true), (588, "r588", false), (415, "r415", true), (357, "r357", true), (403, "r403", true), (306, "r306", false), (369, "r369", true), (390, "r390", false), (318, "r318", false), (427, "r427", true), (317, "r317", true), (585, "r585", true), (470, "r470", false), (311, "r311", true), (324, "r324", false), (485, "r485", true), (551, "r551", true), (352, "r352", false), (379, "r379", true), (67, "r67", true), (151, "r151", true), (582, "r582", false), (320, "r320", false), (563, "r563", true), (484, "r484", false), (446, "r446", false), (396, "r396", false), (191, "r191", true), (339, "r339", true), (37, "r37", true), (462, "r462", false), (101, "r101", true), (332, "r332", false), (393, "r393", true), (346, "r346", false), (34, "r34", false), (502, "r502", false), (479, "r479", true), (406, "r406", false), (370, "r370", false), (564, "r564", false), (349, "r349", true), (76, "r76", false), (97, "r97", true), (345, "r345", true), (25, "r25", true), (504, "r504", false), (507, "r507", true), (558, "r558", false), (334, "r334", false), (335, "r335", true), (312, "r312", false), (171, "r171", true), (467, "r467", true), (351, "r351", true), (85, "r85", true), (40, "r40", false), (478, "r478", false), (141, "r141", true), (515, "r515", true), (500, "r500", false), (368, "r368", false), (392, "r392", false), (534, "r534", false), (46, "r46", false), (574, "r574", false), (356, "r356", false), (398, "r398", false), (380, "r380", false), (575, "r575", true), (305, "r305", true), (413, "r413", true), (550, "r550", false), (70, "r70", false), (590, "r590", false), (301, "r301", true), (492, "r492", false), (460, "r460", false), (419, "r419", true), (568, "r568", false), (544, "r544", false), (436, "r436", false), (361, "r361", true), (572, "r572", false), (404, "r404", false), (382, "r382", false), (439, "r439", true), (377, "r377", true), (532, "r532", false), (533, "r533", true), (367, "r367", true), (474, "r474", false), (389, "r389", true), (331, "r331", true), (337, "r337", true), (513, "r513", true), (449, "r449", true), (49, "r49", true), (580, "r580", false), (363, "r363", true), (371, "r371", true), (499, "r499", true), (521, "r521", true), (529, "r529", true), (543, "r543", true), (592, "r592", false), (336, "r336", false), (428, "r428", false), (420, "r420", false), (7, "r7", true), (55, "r55", true), (444, "r444", false), (524, "r524", false), (497, "r497", true), (161, "r161", true), (546, "r546", false), (394, "r394", false), (411, "r411", true), (465, "r465", true), (319, "r319", true), (416, "r416", false), (321, "r321", true), (4, "r4", false), (526, "r526", false), (304, "r304", false), (432, "r432", false), (482, "r482", false), (586, "r586", false), (535, "r535", true), (577, "r577", true), (561, "r561", true), (476, "r476", false), (121, "r121", true), (342, "r342", false), (372, "r372", false), (314, "r314", false), (541, "r541", true), (341, "r341", true), (355, "r355", true), (408, "r408", false), (350, "r350", false), (431, "r431", true), (548, "r548", false), (555, "r555", true), (440, "r440", false), (58, "r58", false), (559, "r559", true), (554, "r554", false), (64, "r64", false), (573, "r573", true), (365, "r365", true), (511, "r511", true), (378, "r378", false), (565, "r565", true), (327, "r327", true), (593, "r593", true), (523, "r523", true), (448, "r448", false), (579, "r579", true);
+select id, name from runs where id < 8;
+select id, name from runs where id > 96 and id < 113;
+select id, name from runs where id > 595;
+select odd, count(id) from runs group by odd;
+copy runs from "missing.csv";
+copy nothing from "missing.csv";
+drop table runs;
+
+close bulk;
+drop database bulk;
+exit;
@@ -0,0 +1,22 @@
+create database sol;
+open sol;
+
+create table bodies (name text, id int8 key, mass float8, ring bool) clustered;
+insert into bodies (name, id, mass, ring) values ("body 261", 261, 1.5, true), ("body 6", 6, 6.5, true), ("body 55", 55, null, false), (null, 49, 10.5, false), ("body 106", 106, 2.5, false), ("body 178", 178, 9.5, false), (null, 28, 2.5, false), (null, 168, 12.5, true), ("body 239", 239, 5.5, false), ("body 125", 125, null, false), ("body 128", 128, 11.5, false), ("body 87", 87, 9.5, true), ("body 88", 88, 10.5, false), ("body 159", 159, 3.5, true), ("body 179", 179, 10.5, false), (null, 259, 12.5, false), (null, 56, 4.5, false), ("body 127", 127, 10.5, false), ("body 38", 38, 12.5, false), ("body 137", 137, 7.5, false), ("body 195", 195, null, true), (null, 112, 8.5, false), (null, 91, 0.5, false), ("body 68", 68, 3.5, false), ("body 176", 176, 7.5, false), (null, 14, 1.5, false), ("body 165", 165, null, true), ("body 139", 139, 9.5, false), ("body 163", 163, 7.5, false), ("body 200", 200, null, false), ("body 135", 135, null, true), (null, 126, 9.5, true), ("body 184", 184, 2.5, false), ("body 89", 89, 11.5, false), ("body 232", 232, 11.5, false), ("body 44", 44, 5.5, false), ("body 51", 51, 12.5, true), ("body 282", 282, 9.5, true), ("body 173", 173, 4.5, false), ("body 121", 121, 4.5, false), ("body 41", 41, 2.5, false), ("body 24", 24, 11.5, true), ("body 186", 186, 4.5, true), ("body 197", 197, 2.5, false), ("body 93", 93, 2.5, true), ("body 274", 274, 1.5, false), ("body 1", 1, 1.5, false), ("body 240", 240, null, true), ("body 82", 82, 4.5, false), ("body 214", 214, 6.5, false);
+insert into bodies (name, id, mass, ring) values ("body 292", 292, 6.5, false), ("body 103", 103, 12.5, false), ("body 157", 157, 1.5, false), ("body 283", 283, 10.5, false), (null, 140, null, false), (null, 70, null, false), ("body 138", 138, 8.5, true), ("body 145", 145, null, false), ("body 122", 122, 5.5, false), ("body 59", 59, 7.5, false), ("body 64", 64, 12.5, false), ("body 90", 90, null, true), ("body 227", 227, 6.5, false), ("body 264", 264, 4.5, true), ("body 218", 218, 10.5, false), ("body 111", 111, 7.5, true), ("body 298", 298, 12.5, false), ("body 81", 81, 3.5, true), ("body 295", 295, null, false), (null, 280, null, false), ("body 190", 190, null, false), ("body 223", 223, 2.5, false), ("body 136", 136, 6.5, false), ("body 108", 108, 4.5, true), ("body 146", 146, 3.5, false), ("body 185", 185, null, false), ("body 206", 206, 11.5, false), ("body 60", 60, null, true), ("body 247", 247, 0.5, false), ("body 241", 241, 7.5, false), ("body 278", 278, 5.5, false), ("body 221", 221, 0.5, false), ("body 244", 244, 10.5, false), ("body 235", 235, null, false), ("body 258", 258, 11.5, true), ("body 226", 226, 5.5, false), ("body 242", 242, 8.5, false), ("body 148", 148, 5.5, false), ("body 11", 11, 11.5, false), ("body 205", 205, null, false), ("body 253", 253, 6.5, false), ("body 67", 67, 2.5, false), ("body 281", 281, 8.5, false), ("body 36", 36, 10.5, true), ("body 207", 207, 12.5, true), ("body 183", 183, 1.5, true), (null, 252, 5.5, true), ("body 31", 31, 5.5, false), ("body 57", 57, 5.5, true), ("body 52", 52, 0.5, false);
+insert into bodies (name, id, mass, ring) values ("body 158", 158, 2.5, false), (null, 287, 1.5, false), ("body 170", 170, null, false), ("body 169", 169, 0.5, false), ("body 134", 134, 4.5, false), (null, 133, 3.5, false), (null, 35, null, false), ("body 132", 132, 2.5, true), ("body 110", 110, null, false), ("body 78", 78, 0.5, true), ("body 109", 109, 5.5, false), ("body 83", 83, 5.5, false), ("body 71", 71, 6.5, false), ("body 129", 129, 12.5, true), ("body 191", 191, 9.5, false), ("body 16", 16, 3.5, false), ("body 8", 8, 8.5, false), ("body 92", 92, 1.5, false), ("body 118", 118, 1.5, false), ("body 220", 220, null, false), ("body 171", 171, 2.5, true), (null, 203, 8.5, false), ("body 160", 160, null, false), ("body 76", 76, 11.5, false), ("body 115", 115, null, false), (null, 105, null, true), ("body 162", 162, 6.5, true), (null, 224, 3.5, false), ("body 211", 211, 3.5, false), ("body 61", 61, 9.5, false), ("body 65", 65, null, false), ("body 254", 254, 7.5, false), ("body 9", 9, 9.5, true), ("body 246", 246, 12.5, true), ("body 26", 26, 0.5, false), ("body 12", 12, 12.5, true), (null, 189, 7.5, true), ("body 20", 20, null, false), ("body 152", 152, 9.5, false), ("body 99", 99, 8.5, true), ("body 269", 269, 9.5, false), ("body 141", 141, 11.5, true), ("body 40", 40, null, false), ("body 198", 198, 3.5, true), ("body 212", 212, 4.5, false), ("body 58", 58, 6.5, false), ("body 219", 219, 11.5, true), ("body 39", 39, 0.5, true), ("body 285", 285, null, true), ("body 166", 166, 10.5, false);
+insert into bodies (name, id, mass, ring) values ("body 213", 213, 5.5, true), ("body 177", 177, 8.5, true), (null, 273, 0.5, true), ("body 267", 267, 7.5, true), ("body 277", 277, 4.5, false), ("body 116", 116, 12.5, false), ("body 290", 290, null, false), ("body 293", 293, 7.5, false), ("body 153", 153, 10.5, true), (null, 217, 9.5, false), ("body 62", 62, 10.5, false), ("body 149", 149, 6.5, false), (null, 182, 0.5, false), ("body 23", 23, 10.5, false), ("body 19", 19, 6.5, false), ("body 288", 288, 2.5, true), ("body 192", 192, 10.5, true), ("body 75", 75, null, true), (null, 84, 6.5, true), ("body 156", 156, 0.5, true), ("body 209", 209, 1.5, false), ("body 66", 66, 1.5, true), ("body 113", 113, 9.5, false), ("body 188", 188, 6.5, false), ("body 37", 37, 11.5, false), ("body 10", 10, null, false), (null, 210, null, true), (null, 147, 4.5, true), ("body 193", 193, 11.5, false), (null, 154, 11.5, false), ("body 268", 268, 8.5, false), ("body 47", 47, 8.5, false), ("body 236", 236, 2.5, false), ("body 5", 5, null, false), (null, 77, 12.5, false), ("body 151", 151, 8.5, false), ("body 222", 222, 1.5, true), ("body 297", 297, 11.5, true), ("body 271", 271, 11.5, false), ("body 215", 215, null, false), ("body 230", 230, null, false), ("body 29", 29, 3.5, false), ("body 291", 291, 5.5, true), ("body 164", 164, 8.5, false), ("body 229", 229, 8.5, false), ("body 33", 33, 7.5, true), ("body 249", 249, 2.5, true), ("body 187", 187, 5.5, false), ("body 201", 201, 6.5, true), ("body 257", 257, 10.5, false);
+insert into bodies (name, id, mass, ring) values ("body 114", 114, 10.5, true), ("body 289", 289, 3.5, false), ("body 143", 143, 0.5, false), ("body 174", 174, 5.5, true), ("body 45", 45, null, true), ("body 124", 124, 7.5, false), ("body 204", 204, 9.5, true), (null, 266, 6.5, false), ("body 272", 272, 12.5, false), ("body 263", 263, 3.5, false), ("body 25", 25, null, false), ("body 180", 180, null, true), (null, 63, 11.5, true), ("body 34", 34, 8.5, false), ("body 276", 276, 3.5, true), ("body 194", 194, 12.5, false), ("body 104", 104, 0.5, false), ("body 3", 3, 3.5, true), ("body 85", 85, null, false), ("body 79", 79, 1.5, false), ("body 22", 22, 9.5, false), ("body 86", 86, 8.5, false), ("body 69", 69, 4.5, true), ("body 172", 172, 3.5, false), ("body 199", 199, 4.5, false), ("body 50", 50, null, false), ("body 256", 256, 9.5, false), ("body 250", 250, null, false), ("body 284", 284, 11.5, false), ("body 107", 107, 3.5, false), ("body 101", 101, 10.5, false), ("body 181", 181, 12.5, false), ("body 96", 96, 5.5, true), ("body 120", 120, null, true), ("body 13", 13, 0.5, false), ("body 233", 233, 12.5, false), ("body 53", 53, 1.5, false), ("body 54", 54, 2.5, true), (null, 0, null, true), (null, 175, null, false), (null, 245, null, false), ("body 4", 4, 4.5, false), ("body 251", 251, 4.5, false), (null, 98, 7.5, false), ("body 74", 74, 9.5, false), ("body 216", 216, 8.5, true), ("body 248", 248, 1.5, false), ("body 102", 102, 11.5, true), ("body 27", 27, 1.5, true), (null, 196, 1.5, false);
+insert into bodies (name, id, mass, ring) values ("body 144", 144, 1.5, true), ("body 17", 17, 4.5, false), ("body 279", 279, 6.5, true), ("body 73", 73, 8.5, false), ("body 131", 131, 1.5, false), ("body 117", 117, 0.5, true), (null, 161, 5.5, false), ("body 130", 130, null, false), (null, 42, 3.5, true), ("body 208", 208, 0.5, false), ("body 142", 142, 12.5, false), ("body 234", 234, 0.5, true), ("body 43", 43, 4.5, false), ("body 2", 2, 2.5, false), ("body 255", 255, null, true), ("body 150", 150, null, true), (null, 119, 2.5, false), ("body 265", 265, null, false), ("body 100", 100, null, false), ("body 225", 225, null, true), ("body 167", 167, 11.5, false), ("body 237", 237, 3.5, true), ("body 15", 15, null, true), ("body 123", 123, 6.5, true), (null, 294, 8.5, true), ("body 18", 18, 5.5, true), ("body 30", 30, null, true), ("body 32", 32, 6.5, false), ("body 270", 270, null, true), (null, 7, 7.5, false), ("body 80", 80, null, false), ("body 296", 296, 10.5, false), ("body 202", 202, 7.5, false), (null, 21, 8.5, true), ("body 275", 275, null, false), ("body 46", 46, 7.5, false), ("body 72", 72, 7.5, true), ("body 155", 155, null, false), ("body 228", 228, 7.5, true), ("body 48", 48, 9.5, true), ("body 95", 95, null, false), ("body 243", 243, 9.5, true), ("body 262", 262, 2.5, false), ("body 94", 94, 3.5, false), ("body 97", 97, 6.5, false), ("body 260", 260, null, false), ("body 299", 299, 0.5, false), (null, 238, 4.5, false), ("body 286", 286, 0.5, false), (null, 231, 10.5, true);
+select * from bodies where id < 8;
+select id, name from bodies where id > 293;
+update bodies set mass = 1.0, name = "renamed" where id < 4;
+select * from bodies where id < 6;
+delete from bodies where ring = true;
+select id, mass from bodies where id > 290;
+describe bodies;
+drop table bodies;
+
+close sol;
+drop database sol;
+exit;
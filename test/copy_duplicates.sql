@@ -0,0 +1,14 @@
+create database bulk;
+open bulk;
+
+create table runs (id int8 key, name text, odd bool);
+insert into runs (id, name, odd) values (1, "r1", true), (2, "r2", false), (3, "r3", true);
+copy runs from "../../test/copy_duplicates_file.csv";
+select id, name from runs;
+copy runs from "../../test/copy_duplicates_table.csv";
+select id, name from runs;
+drop table runs;
+
+close bulk;
+drop database bulk;
+exit;
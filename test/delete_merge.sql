@@ -0,0 +1,23 @@
+create database merge;
+open merge;
+
+create table nums (id int8 key, label text);
+insert into nums (id, label) values (0, "label 0"), (1, "label 1"), (2, "label 2"), (3, "label 3"), (4, "label 4"), (5, "label 5"), (6, "label 6"), (7, "label 7"), (8, "label 8"), (9, "label 9"), (10, "label 10"), (11, "label 11"), (12, "label 12"), (13, "label 13"), (14, "label 14"), (15, "label 15"), (16, "label 16"), (17, "label 17"), (18, "label 18"), (19, "label 19"), (20, "label 20"), (21, "label 21"), (22, "label 22"), (23, "label 23"), (24, "label 24"), (25, "label 25"), (26, "label 26"), (27, "label 27"), (28, "label 28"), (29, "label 29"), (30, "label 30"), (31, "label 31"), (32, "label 32"), (33, "label 33"), (34, "label 34"), (35, "label 35"), (36, "label 36"), (37, "label 37"), (38, "label 38"), (39, "label 39"), (40, "label 40"), (41, "label 41"), (42, "label 42"), (43, "label 43"), (44, "label 44"), (45, "label 45"), (46, "label 46"), (47, "label 47"), (48, "label 48"), (49, "label 49"), (50, "label 50"), (51, "label 51"), (52, "label 52"), (53, "label 53"), (54, "label 54"), (55, "label 55"), (56, "label 56"), (57, "label 57"), (58, "label 58"), (59, "label 59"), (60, "label 60"), (61, "label 61"), (62, "label 62"), (63, "label 63"), (64, "label 64"), (65, "label 65"), (66, "label 66"), (67, "label 67"), (68, "label 68"), (69, "label 69"), (70, "label 70"), (71, "label 71"), (72, "label 72"), (73, "label 73"), (74, "label 74"), (75, "label 75"), (76, "label 76"), (77, "label 77"), (78, "label 78"), (79, "label 79"), (80, "label 80"), (81, "label 81"), (82, "label 82"), (83, "label 83"), (84, "label 84"), (85, "label 85"), (86, "label 86"), (87, "label 87"), (88, "label 88"), (89, "label 89"), (90, "label 90"), (91, "label 91"), (92, "label 92"), (93, "label 93"), (94, "label 94"), (95, "label 95"), (96, "label 96"), (97, "label 97"), (98, "label 98"), (99, "label 99"), (100, "label 100"), (101, "label 101"), (102, "label 102"), (103, "label 103"), (104, "label 104"), (105, "label 105"), (106, "label 106"), (107, "label 107"), (108, "label 108"), (109, "label 109"), (110, "label 110"), (111, "label 111"), (112, "label 112"), (113, "label 113"), (114, "label 114"), (115, "label 115"), (116, "label 116"), (117, "label 117"), (118, "label 118"), (119, "label 119"), (120, "label 120"), (121, "label 121"), (122, "label 122"), (123, "label 123"), (124, "label 124"), (125, "label 125"), (126, "label 126"), (127, "label 127"), (128, "label 128"), (129, "label 129"), (130, "label 130"), (131, "label 131"), (132, "label 132"), (133, "label 133"), (134, "label 134"), (135, "label 135"), (136, "label 136"), (137, "label 137"), (138, "label 138"), (139, "label 139"), (140, "label 140"), (141, "label 141"), (142, "label 142"), (143, "label 143"), (144, "label 144"), (145, "label 145"), (146, "label 146"), (147, "label 147"), (148, "label 148"), (149, "label 149"), (150, "label 150"), (151, "label 151"), (152, "label 152"), (153, "label 153"), (154, "label 154"), (155, "label 155"), (156, "label 156"), (157, "label 157"), (158, "label 158"), (159, "label 159"), (160, "label 160"), (161, "label 161"), (162, "label 162"), (163, "label 163"), (164, "label 164"), (165, "label 165"), (166, "label 166"), (167, "label 167"), (168, "label 168"), (169, "label 169"), (170, "label 170"), (171, "label 171"), (172, "label 172"), (173, "label 173"), (174, "label 174"), (175, "label 175"), (176, "label 176"), (177, "label 177"), (178, "label 178"), (179, "label 179"), (180, "label 180"), (181, "label 181"), (182, "label 182"), (183, "label 183"), (184, "label 184"), (185, "label 185"), (186, "label 186"), (187, "label 187"), (188, "label 188"), (189, "label 189"), (190, "label 190"), (191, "label 191"), (192, "label 192"), (193, "label 193"), (194, "label 194"), (195, "label 195"), (196, "label 196"), (197, "label 197"), (198, "label 198"), (199, "label 199"), (200, "label 200"), (201, "label 201"), (202, "label 202"), (203, "label 203"), (204, "label 204"), (205, "label 205"), (206, "label 206"), (207, "label 207"), (208, "label 208"), (209, "label 209"), (210, "label 210"), (211, "label 211"), (212, "label 212"), (213, "label 213"), (214, "label 214"), (215, "label 215"), (216, "label 216"), (217, "label 217"), (218, "label 218"), (219, "label 219"), (220, "label 220"), (221, "label 221"), (222, "label 222"), (223, "label 223"), (224, "label 224"), (225, "label 225"), (226, "label 226"), (227, "label 227"), (228, "label 228"), (229, "label 229"), (230, "label 230"), (231, "label 231"), (232, "label 232"), (233, "label 233"), (234, "label 234"), (235, "label 235"), (236, "label 236"), (237, "label 237"), (238, "label 238"), (239, "label 239"), (240, "label 240"), (241, "label 241"), (242, "label 242"), (243, "label 243"), (244, "label 244"), (245, "label 245"), (246, "label 246"), (247, "label 247"), (248, "label 248"), (249, "label 249"), (250, "label 250"), (251, "label 251"), (252, "label 252"), (253, "label 253"), (254, "label 254"), (255, "label 255"), (256, "label 256"), (257, "label 257"), (258, "label 258"), (259, "label 259"), (260, "label 260"), (261, "label 261"), (262, "label 262"), (263, "label 263"), (264, "label 264"), (265, "label 265"), (266, "label 266"), (267, "label 267"), (268, "label 268"), (269, "label 269"), (270, "label 270"), (271, "label 271"), (272, "label 272"), (273, "label 273"), (274, "label 274"), (275, "label 275"), (276, "label 276"), (277, "label 277"), (278, "label 278"), (279, "label 279"), (280, "label 280"), (281, "label 281"), (282, "label 282"), (283, "label 283"), (284, "label 284"), (285, "label 285"), (286, "label 286"), (287, "label 287"), (288, "label 288"), (289, "label 289"), (290, "label 290"), (291, "label 291"), (292, "label 292"), (293, "label 293"), (294, "label 294"), (295, "label 295"), (296, "label 296"), (297, "label 297"), (298, "label 298"), (299, "label 299");
+insert into nums (id, label) values (300, "label 300"), (301, "label 301"), (302, "label 302"), (303, "label 303"), (304, "label 304"), (305, "label 305"), (306, "label 306"), (307, "label 307"), (308, "label 308"), (309, "label 309"), (310, "label 310"), (311, "label 311"), (312, "label 312"), (313, "label 313"), (314, "label 314"), (315, "label 315"), (316, "label 316"), (317, "label 317"), (318, "label 318"), (319, "label 319"), (320, "label 320"), (321, "label 321"), (322, "label 322"), (323, "label 323"), (324, "label 324"), (325, "label 325"), (326, "label 326"), (327, "label 327"), (328, "label 328"), (329, "label 329"), (330, "label 330"), (331, "label 331"), (332, "label 332"), (333, "label 333"), (334, "label 334"), (335, "label 335"), (336, "label 336"), (337, "label 337"), (338, "label 338"), (339, "label 339"), (340, "label 340"), (341, "label 341"), (342, "label 342"), (343, "label 343"), (344, "label 344"), (345, "label 345"), (346, "label 346"), (347, "label 347"), (348, "label 348"), (349, "label 349"), (350, "label 350"), (351, "label 351"), (352, "label 352"), (353, "label 353"), (354, "label 354"), (355, "label 355"), (356, "label 356"), (357, "label 357"), (358, "label 358"), (359, "label 359"), (360, "label 360"), (361, "label 361"), (362, "label 362"), (363, "label 363"), (364, "label 364"), (365, "label 365"), (366, "label 366"), (367, "label 367"), (368, "label 368"), (369, "label 369"), (370, "label 370"), (371, "label 371"), (372, "label 372"), (373, "label 373"), (374, "label 374"), (375, "label 375"), (376, "label 376"), (377, "label 377"), (378, "label 378"), (379, "label 379"), (380, "label 380"), (381, "label 381"), (382, "label 382"), (383, "label 383"), (384, "label 384"), (385, "label 385"), (386, "label 386"), (387, "label 387"), (388, "label 388"), (389, "label 389"), (390, "label 390"), (391, "label 391"), (392, "label 392"), (393, "label 393"), (394, "label 394"), (395, "label 395"), (396, "label 396"), (397, "label 397"), (398, "label 398"), (399, "label 399"), (400, "label 400"), (401, "label 401"), (402, "label 402"), (403, "label 403"), (404, "label 404"), (405, "label 405"), (406, "label 406"), (407, "label 407"), (408, "label 408"), (409, "label 409"), (410, "label 410"), (411, "label 411"), (412, "label 412"), (413, "label 413"), (414, "label 414"), (415, "label 415"), (416, "label 416"), (417, "label 417"), (418, "label 418"), (419, "label 419"), (420, "label 420"), (421, "label 421"), (422, "label 422"), (423, "label 423"), (424, "label 424"), (425, "label 425"), (426, "label 426"), (427, "label 427"), (428, "label 428"), (429, "label 429"), (430, "label 430"), (431, "label 431"), (432, "label 432"), (433, "label 433"), (434, "label 434"), (435, "label 435"), (436, "label 436"), (437, "label 437"), (438, "label 438"), (439, "label 439"), (440, "label 440"), (441, "label 441"), (442, "label 442"), (443, "label 443"), (444, "label 444"), (445, "label 445"), (446, "label 446"), (447, "label 447"), (448, "label 448"), (449, "label 449"), (450, "label 450"), (451, "label 451"), (452, "label 452"), (453, "label 453"), (454, "label 454"), (455, "label 455"), (456, "label 456"), (457, "label 457"), (458, "label 458"), (459, "label 459"), (460, "label 460"), (461, "label 461"), (462, "label 462"), (463, "label 463"), (464, "label 464"), (465, "label 465"), (466, "label 466"), (467, "label 467"), (468, "label 468"), (469, "label 469"), (470, "label 470"), (471, "label 471"), (472, "label 472"), (473, "label 473"), (474, "label 474"), (475, "label 475"), (476, "label 476"), (477, "label 477"), (478, "label 478"), (479, "label 479"), (480, "label 480"), (481, "label 481"), (482, "label 482"), (483, "label 483"), (484, "label 484"), (485, "label 485"), (486, "label 486"), (487, "label 487"), (488, "label 488"), (489, "label 489"), (490, "label 490"), (491, "label 491"), (492, "label 492"), (493, "label 493"), (494, "label 494"), (495, "label 495"), (496, "label 496"), (497, "label 497"), (498, "label 498"), (499, "label 499"), (500, "label 500"), (501, "label 501"), (502, "label 502"), (503, "label 503"), (504, "label 504"), (505, "label 505"), (506, "label 506"), (507, "label 507"), (508, "label 508"), (509, "label 509"), (510, "label 510"), (511, "label 511"), (512, "label 512"), (513, "label 513"), (514, "label 514"), (515, "label 515"), (516, "label 516"), (517, "label 517"), (518, "label 518"), (519, "label 519"), (520, "label 520"), (521, "label 521"), (522, "label 522"), (523, "label 523"), (524, "label 524"), (525, "label 525"), (526, "label 526"), (527, "label 527"), (528, "label 528"), (529, "label 529"), (530, "label 530"), (531, "label 531"), (532, "label 532"), (533, "label 533"), (534, "label 534"), (535, "label 535"), (536, "label 536"), (537, "label 537"), (538, "label 538"), (539, "label 539"), (540, "label 540"), (541, "label 541"), (542, "label 542"), (543, "label 543"), (544, "label 544"), (545, "label 545"), (546, "label 546"), (547, "label 547"), (548, "label 548"), (549, "label 549"), (550, "label 550"), (551, "label 551"), (552, "label 552"), (553, "label 553"), (554, "label 554"), (555, "label 555"), (556, "label 556"), (557, "label 557"), (558, "label 558"), (559, "label 559"), (560, "label 560"), (561, "label 561"), (562, "label 562"), (563, "label 563"), (564, "label 564"), (565, "label 565"), (566, "label 566"), (567, "label 567"), (568, "label 568"), (569, "label 569"), (570, "label 570"), (571, "label 571"), (572, "label 572"), (573, "label 573"), (574, "label 574"), (575, "label 575"), (576, "label 576"), (577, "label 577"), (578, "label 578"), (579, "label 579"), (580, "label 580"), (581, "label 581"), (582, "label 582"), (583, "label 583"), (584, "label 584"), (585, "label 585"), (586, "label 586"), (587, "label 587"), (588, "label 588"), (589, "label 589"), (590, "label 590"), (591, "label 591"), (592, "label 592"), (593, "label 593"), (594, "label 594"), (595, "label 595"), (596, "label 596"), (597, "label 597"), (598, "label 598"), (599, "label 599");
+insert into nums (id, label) values (600, "label 600"), (601, "label 601"), (602, "label 602"), (603, "label 603"), (604, "label 604"), (605, "label 605"), (606, "label 606"), (607, "label 607"), (608, "label 608"), (609, "label 609"), (610, "label 610"), (611, "label 611"), (612, "label 612"), (613, "label 613"), (614, "label 614"), (615, "label 615"), (616, "label 616"), (617, "label 617"), (618, "label 618"), (619, "label 619"), (620, "label 620"), (621, "label 621"), (622, "label 622"), (623, "label 623"), (624, "label 624"), (625, "label 625"), (626, "label 626"), (627, "label 627"), (628, "label 628"), (629, "label 629"), (630, "label 630"), (631, "label 631"), (632, "label 632"), (633, "label 633"), (634, "label 634"), (635, "label 635"), (636, "label 636"), (637, "label 637"), (638, "label 638"), (639, "label 639"), (640, "label 640"), (641, "label 641"), (642, "label 642"), (643, "label 643"), (644, "label 644"), (645, "label 645"), (646, "label 646"), (647, "label 647"), (648, "label 648"), (649, "label 649"), (650, "label 650"), (651, "label 651"), (652, "label 652"), (653, "label 653"), (654, "label 654"), (655, "label 655"), (656, "label 656"), (657, "label 657"), (658, "label 658"), (659, "label 659"), (660, "label 660"), (661, "label 661"), (662, "label 662"), (663, "label 663"), (664, "label 664"), (665, "label 665"), (666, "label 666"), (667, "label 667"), (668, "label 668"), (669, "label 669"), (670, "label 670"), (671, "label 671"), (672, "label 672"), (673, "label 673"), (674, "label 674"), (675, "label 675"), (676, "label 676"), (677, "label 677"), (678, "label 678"), (679, "label 679"), (680, "label 680"), (681, "label 681"), (682, "label 682"), (683, "label 683"), (684, "label 684"), (685, "label 685"), (686, "label 686"), (687, "label 687"), (688, "label 688"), (689, "label 689"), (690, "label 690"), (691, "label 691"), (692, "label 692"), (693, "label 693"), (694, "label 694"), (695, "label 695"), (696, "label 696"), (697, "label 697"), (698, "label 698"), (699, "label 699"), (700, "label 700"), (701, "label 701"), (702, "label 702"), (703, "label 703"), (704, "label 704"), (705, "label 705"), (706, "label 706"), (707, "label 707"), (708, "label 708"), (709, "label 709"), (710, "label 710"), (711, "label 711"), (712, "label 712"), (713, "label 713"), (714, "label 714"), (715, "label 715"), (716, "label 716"), (717, "label 717"), (718, "label 718"), (719, "label 719"), (720, "label 720"), (721, "label 721"), (722, "label 722"), (723, "label 723"), (724, "label 724"), (725, "label 725"), (726, "label 726"), (727, "label 727"), (728, "label 728"), (729, "label 729"), (730, "label 730"), (731, "label 731"), (732, "label 732"), (733, "label 733"), (734, "label 734"), (735, "label 735"), (736, "label 736"), (737, "label 737"), (738, "label 738"), (739, "label 739"), (740, "label 740"), (741, "label 741"), (742, "label 742"), (743, "label 743"), (744, "label 744"), (745, "label 745"), (746, "label 746"), (747, "label 747"), (748, "label 748"), (749, "label 749"), (750, "label 750"), (751, "label 751"), (752, "label 752"), (753, "label 753"), (754, "label 754"), (755, "label 755"), (756, "label 756"), (757, "label 757"), (758, "label 758"), (759, "label 759"), (760, "label 760"), (761, "label 761"), (762, "label 762"), (763, "label 763"), (764, "label 764"), (765, "label 765"), (766, "label 766"), (767, "label 767"), (768, "label 768"), (769, "label 769"), (770, "label 770"), (771, "label 771"), (772, "label 772"), (773, "label 773"), (774, "label 774"), (775, "label 775"), (776, "label 776"), (777, "label 777"), (778, "label 778"), (779, "label 779"), (780, "label 780"), (781, "label 781"), (782, "label 782"), (783, "label 783"), (784, "label 784"), (785, "label 785"), (786, "label 786"), (787, "label 787"), (788, "label 788"), (789, "label 789"), (790, "label 790"), (791, "label 791"), (792, "label 792"), (793, "label 793"), (794, "label 794"), (795, "label 795"), (796, "label 796"), (797, "label 797"), (798, "label 798"), (799, "label 799"), (800, "label 800"), (801, "label 801"), (802, "label 802"), (803, "label 803"), (804, "label 804"), (805, "label 805"), (806, "label 806"), (807, "label 807"), (808, "label 808"), (809, "label 809"), (810, "label 810"), (811, "label 811"), (812, "label 812"), (813, "label 813"), (814, "label 814"), (815, "label 815"), (816, "label 816"), (817, "label 817"), (818, "label 818"), (819, "label 819"), (820, "label 820"), (821, "label 821"), (822, "label 822"), (823, "label 823"), (824, "label 824"), (825, "label 825"), (826, "label 826"), (827, "label 827"), (828, "label 828"), (829, "label 829"), (830, "label 830"), (831, "label 831"), (832, "label 832"), (833, "label 833"), (834, "label 834"), (835, "label 835"), (836, "label 836"), (837, "label 837"), (838, "label 838"), (839, "label 839"), (840, "label 840"), (841, "label 841"), (842, "label 842"), (843, "label 843"), (844, "label 844"), (845, "label 845"), (846, "label 846"), (847, "label 847"), (848, "label 848"), (849, "label 849"), (850, "label 850"), (851, "label 851"), (852, "label 852"), (853, "label 853"), (854, "label 854"), (855, "label 855"), (856, "label 856"), (857, "label 857"), (858, "label 858"), (859, "label 859"), (860, "label 860"), (861, "label 861"), (862, "label 862"), (863, "label 863"), (864, "label 864"), (865, "label 865"), (866, "label 866"), (867, "label 867"), (868, "label 868"), (869, "label 869"), (870, "label 870"), (871, "label 871"), (872, "label 872"), (873, "label 873"), (874, "label 874"), (875, "label 875"), (876, "label 876"), (877, "label 877"), (878, "label 878"), (879, "label 879"), (880, "label 880"), (881, "label 881"), (882, "label 882"), (883, "label 883"), (884, "label 884"), (885, "label 885"), (886, "label 886"), (887, "label 887"), (888, "label 888"), (889, "label 889"), (890, "label 890"), (891, "label 891"), (892, "label 892"), (893, "label 893"), (894, "label 894"), (895, "label 895"), (896, "label 896"), (897, "label 897"), (898, "label 898"), (899, "label 899");
+insert into nums (id, label) values (900, "label 900"), (901, "label 901"), (902, "label 902"), (903, "label 903"), (904, "label 904"), (905, "label 905"), (906, "label 906"), (907, "label 907"), (908, "label 908"), (909, "label 909"), (910, "label 910"), (911, "label 911"), (912, "label 912"), (913, "label 913"), (914, "label 914"), (915, "label 915"), (916, "label 916"), (917, "label 917"), (918, "label 918"), (919, "label 919"), (920, "label 920"), (921, "label 921"), (922, "label 922"), (923, "label 923"), (924, "label 924"), (925, "label 925"), (926, "label 926"), (927, "label 927"), (928, "label 928"), (929, "label 929"), (930, "label 930"), (931, "label 931"), (932, "label 932"), (933, "label 933"), (934, "label 934"), (935, "label 935"), (936, "label 936"), (937, "label 937"), (938, "label 938"), (939, "label 939"), (940, "label 940"), (941, "label 941"), (942, "label 942"), (943, "label 943"), (944, "label 944"), (945, "label 945"), (946, "label 946"), (947, "label 947"), (948, "label 948"), (949, "label 949"), (950, "label 950"), (951, "label 951"), (952, "label 952"), (953, "label 953"), (954, "label 954"), (955, "label 955"), (956, "label 956"), (957, "label 957"), (958, "label 958"), (959, "label 959"), (960, "label 960"), (961, "label 961"), (962, "label 962"), (963, "label 963"), (964, "label 964"), (965, "label 965"), (966, "label 966"), (967, "label 967"), (968, "label 968"), (969, "label 969"), (970, "label 970"), (971, "label 971"), (972, "label 972"), (973, "label 973"), (974, "label 974"), (975, "label 975"), (976, "label 976"), (977, "label 977"), (978, "label 978"), (979, "label 979"), (980, "label 980"), (981, "label 981"), (982, "label 982"), (983, "label 983"), (984, "label 984"), (985, "label 985"), (986, "label 986"), (987, "label 987"), (988, "label 988"), (989, "label 989"), (990, "label 990"), (991, "label 991"), (992, "label 992"), (993, "label 993"), (994, "label 994"), (995, "label 995"), (996, "label 996"), (997, "label 997"), (998, "label 998"), (999, "label 999"), (1000, "label 1000"), (1001, "label 1001"), (1002, "label 1002"), (1003, "label 1003"), (1004, "label 1004"), (1005, "label 1005"), (1006, "label 1006"), (1007, "label 1007"), (1008, "label 1008"), (1009, "label 1009"), (1010, "label 1010"), (1011, "label 1011"), (1012, "label 1012"), (1013, "label 1013"), (1014, "label 1014"), (1015, "label 1015"), (1016, "label 1016"), (1017, "label 1017"), (1018, "label 1018"), (1019, "label 1019"), (1020, "label 1020"), (1021, "label 1021"), (1022, "label 1022"), (1023, "label 1023"), (1024, "label 1024"), (1025, "label 1025"), (1026, "label 1026"), (1027, "label 1027"), (1028, "label 1028"), (1029, "label 1029"), (1030, "label 1030"), (1031, "label 1031"), (1032, "label 1032"), (1033, "label 1033"), (1034, "label 1034"), (1035, "label 1035"), (1036, "label 1036"), (1037, "label 1037"), (1038, "label 1038"), (1039, "label 1039"), (1040, "label 1040"), (1041, "label 1041"), (1042, "label 1042"), (1043, "label 1043"), (1044, "label 1044"), (1045, "label 1045"), (1046, "label 1046"), (1047, "label 1047"), (1048, "label 1048"), (1049, "label 1049"), (1050, "label 1050"), (1051, "label 1051"), (1052, "label 1052"), (1053, "label 1053"), (1054, "label 1054"), (1055, "label 1055"), (1056, "label 1056"), (1057, "label 1057"), (1058, "label 1058"), (1059, "label 1059"), (1060, "label 1060"), (1061, "label 1061"), (1062, "label 1062"), (1063, "label 1063"), (1064, "label 1064"), (1065, "label 1065"), (1066, "label 1066"), (1067, "label 1067"), (1068, "label 1068"), (1069, "label 1069"), (1070, "label 1070"), (1071, "label 1071"), (1072, "label 1072"), (1073, "label 1073"), (1074, "label 1074"), (1075, "label 1075"), (1076, "label 1076"), (1077, "label 1077"), (1078, "label 1078"), (1079, "label 1079"), (1080, "label 1080"), (1081, "label 1081"), (1082, "label 1082"), (1083, "label 1083"), (1084, "label 1084"), (1085, "label 1085"), (1086, "label 1086"), (1087, "label 1087"), (1088, "label 1088"), (1089, "label 1089"), (1090, "label 1090"), (1091, "label 1091"), (1092, "label 1092"), (1093, "label 1093"), (1094, "label 1094"), (1095, "label 1095"), (1096, "label 1096"), (1097, "label 1097"), (1098, "label 1098"), (1099, "label 1099"), (1100, "label 1100"), (1101, "label 1101"), (1102, "label 1102"), (1103, "label 1103"), (1104, "label 1104"), (1105, "label 1105"), (1106, "label 1106"), (1107, "label 1107"), (1108, "label 1108"), (1109, "label 1109"), (1110, "label 1110"), (1111, "label 1111"), (1112, "label 1112"), (1113, "label 1113"), (1114, "label 1114"), (1115, "label 1115"), (1116, "label 1116"), (1117, "label 1117"), (1118, "label 1118"), (1119, "label 1119"), (1120, "label 1120"), (1121, "label 1121"), (1122, "label 1122"), (1123, "label 1123"), (1124, "label 1124"), (1125, "label 1125"), (1126, "label 1126"), (1127, "label 1127"), (1128, "label 1128"), (1129, "label 1129"), (1130, "label 1130"), (1131, "label 1131"), (1132, "label 1132"), (1133, "label 1133"), (1134, "label 1134"), (1135, "label 1135"), (1136, "label 1136"), (1137, "label 1137"), (1138, "label 1138"), (1139, "label 1139"), (1140, "label 1140"), (1141, "label 1141"), (1142, "label 1142"), (1143, "label 1143"), (1144, "label 1144"), (1145, "label 1145"), (1146, "label 1146"), (1147, "label 1147"), (1148, "label 1148"), (1149, "label 1149"), (1150, "label 1150"), (1151, "label 1151"), (1152, "label 1152"), (1153, "label 1153"), (1154, "label 1154"), (1155, "label 1155"), (1156, "label 1156"), (1157, "label 1157"), (1158, "label 1158"), (1159, "label 1159"), (1160, "label 1160"), (1161, "label 1161"), (1162, "label 1162"), (1163, "label 1163"), (1164, "label 1164"), (1165, "label 1165"), (1166, "label 1166"), (1167, "label 1167"), (1168, "label 1168"), (1169, "label 1169"), (1170, "label 1170"), (1171, "label 1171"), (1172, "label 1172"), (1173, "label 1173"), (1174, "label 1174"), (1175, "label 1175"), (1176, "label 1176"), (1177, "label 1177"), (1178, "label 1178"), (1179, "label 1179"), (1180, "label 1180"), (1181, "label 1181"), (1182, "label 1182"), (1183, "label 1183"), (1184, "label 1184"), (1185, "label 1185"), (1186, "label 1186"), (1187, "label 1187"), (1188, "label 1188"), (1189, "label 1189"), (1190, "label 1190"), (1191, "label 1191"), (1192, "label 1192"), (1193, "label 1193"), (1194, "label 1194"), (1195, "label 1195"), (1196, "label 1196"), (1197, "label 1197"), (1198, "label 1198"), (1199, "label 1199");
+delete from nums where (id > 0 and id < 10) or (id > 10 and id < 20) or (id > 20 and id < 30) or (id > 30 and id < 40) or (id > 40 and id < 50) or (id > 50 and id < 60) or (id > 60 and id < 70) or (id > 70 and id < 80) or (id > 80 and id < 90) or (id > 90 and id < 100) or (id > 100 and id < 110) or (id > 110 and id < 120) or (id > 120 and id < 130) or (id > 130 and id < 140) or (id > 140 and id < 150) or (id > 150 and id < 160) or (id > 160 and id < 170) or (id > 170 and id < 180) or (id > 180 and id < 190) or (id > 190 and id < 200) or (id > 200 and id < 210) or (id > 210 and id < 220) or (id > 220 and id < 230) or (id > 230 and id < 240) or (id > 240 and id < 250) or (id > 250 and id < 260) or (id > 260 and id < 270) or (id > 270 and id < 280) or (id > 280 and id < 290) or (id > 290 and id < 300);
+delete from nums where (id > 300 and id < 310) or (id > 310 and id < 320) or (id > 320 and id < 330) or (id > 330 and id < 340) or (id > 340 and id < 350) or (id > 350 and id < 360) or (id > 360 and id < 370) or (id > 370 and id < 380) or (id > 380 and id < 390) or (id > 390 and id < 400) or (id > 400 and id < 410) or (id > 410 and id < 420) or (id > 420 and id < 430) or (id > 430 and id < 440) or (id > 440 and id < 450) or (id > 450 and id < 460) or (id > 460 and id < 470) or (id > 470 and id < 480) or (id > 480 and id < 490) or (id > 490 and id < 500) or (id > 500 and id < 510) or (id > 510 and id < 520) or (id > 520 and id < 530) or (id > 530 and id < 540) or (id > 540 and id < 550) or (id > 550 and id < 560) or (id > 560 and id < 570) or (id > 570 and id < 580) or (id > 580 and id < 590) or (id > 590 and id < 600);
+delete from nums where (id > 600 and id < 610) or (id > 610 and id < 620) or (id > 620 and id < 630) or (id > 630 and id < 640) or (id > 640 and id < 650) or (id > 650 and id < 660) or (id > 660 and id < 670) or (id > 670 and id < 680) or (id > 680 and id < 690) or (id > 690 and id < 700) or (id > 700 and id < 710) or (id > 710 and id < 720) or (id > 720 and id < 730) or (id > 730 and id < 740) or (id > 740 and id < 750) or (id > 750 and id < 760) or (id > 760 and id < 770) or (id > 770 and id < 780) or (id > 780 and id < 790) or (id > 790 and id < 800) or (id > 800 and id < 810) or (id > 810 and id < 820) or (id > 820 and id < 830) or (id > 830 and id < 840) or (id > 840 and id < 850) or (id > 850 and id < 860) or (id > 860 and id < 870) or (id > 870 and id < 880) or (id > 880 and id < 890) or (id > 890 and id < 900);
+delete from nums where (id > 900 and id < 910) or (id > 910 and id < 920) or (id > 920 and id < 930) or (id > 930 and id < 940) or (id > 940 and id < 950) or (id > 950 and id < 960) or (id > 960 and id < 970) or (id > 970 and id < 980) or (id > 980 and id < 990) or (id > 990 and id < 1000) or (id > 1000 and id < 1010) or (id > 1010 and id < 1020) or (id > 1020 and id < 1030) or (id > 1030 and id < 1040) or (id > 1040 and id < 1050) or (id > 1050 and id < 1060) or (id > 1060 and id < 1070) or (id > 1070 and id < 1080) or (id > 1080 and id < 1090) or (id > 1090 and id < 1100) or (id > 1100 and id < 1110) or (id > 1110 and id < 1120) or (id > 1120 and id < 1130) or (id > 1130 and id < 1140) or (id > 1140 and id < 1150) or (id > 1150 and id < 1160) or (id > 1160 and id < 1170) or (id > 1170 and id < 1180) or (id > 1180 and id < 1190) or (id > 1190 and id < 1200);
+select id, label from nums where id < 60 or id > 1150;
+delete from nums where id > 200 and id < 1000;
+select id from nums where id > 150 and id < 1050;
+insert into nums (id, label) values (505, "again 505"), (510, "again 510"), (515, "again 515"), (520, "again 520"), (525, "again 525"), (530, "again 530"), (535, "again 535"), (540, "again 540"), (545, "again 545"), (550, "again 550"), (555, "again 555"), (560, "again 560"), (565, "again 565"), (570, "again 570"), (575, "again 575"), (580, "again 580"), (585, "again 585"), (590, "again 590"), (595, "again 595"), (600, "again 600"), (605, "again 605"), (610, "again 610"), (615, "again 615"), (620, "again 620"), (625, "again 625"), (630, "again 630"), (635, "again 635"), (640, "again 640"), (645, "again 645"), (650, "again 650"), (655, "again 655"), (660, "again 660"), (665, "again 665"), (670, "again 670"), (675, "again 675"), (680, "again 680"), (685, "again 685"), (690, "again 690"), (695, "again 695");
+select id, label from nums where id > 180 and id < 540;
+select id from nums where id > 1100;
+drop table nums;
+
+close merge;
+drop database merge;
+exit;
@@ -0,0 +1,23 @@
+create database churn;
+open churn;
+
+create table items (id int8 key, name text, qty int8);
+insert into items (id, name, qty) values (0, "item 0", 0), (1, "item 1", 1), (2, "item 2", 2), (3, "item 3", 3), (4, "item 4", 4), (5, "item 5", 5), (6, "item 6", 6), (7, "item 7", 7), (8, "item 8", 8), (9, "item 9", 9), (10, "item 10", 0), (11, "item 11", 1), (12, "item 12", 2), (13, "item 13", 3), (14, "item 14", 4), (15, "item 15", 5), (16, "item 16", 6), (17, "item 17", 7), (18, "item 18", 8), (19, "item 19", 9), (20, "item 20", 0), (21, "item 21", 1), (22, "item 22", 2), (23, "item 23", 3), (24, "item 24", 4), (25, "item 25", 5), (26, "item 26", 6), (27, "item 27", 7), (28, "item 28", 8), (29, "item 29", 9), (30, "item 30", 0), (31, "item 31", 1), (32, "item 32", 2), (33, "item 33", 3), (34, "item 34", 4), (35, "item 35", 5), (36, "item 36", 6), (37, "item 37", 7), (38, "item 38", 8), (39, "item 39", 9), (40, "item 40", 0), (41, "item 41", 1), (42, "item 42", 2), (43, "item 43", 3), (44, "item 44", 4), (45, "item 45", 5), (46, "item 46", 6), (47, "item 47", 7), (48, "item 48", 8), (49, "item 49", 9);
+insert into items (id, name, qty) values (50, "item 50", 0), (51, "item 51", 1), (52, "item 52", 2), (53, "item 53", 3), (54, "item 54", 4), (55, "item 55", 5), (56, "item 56", 6), (57, "item 57", 7), (58, "item 58", 8), (59, "item 59", 9), (60, "item 60", 0), (61, "item 61", 1), (62, "item 62", 2), (63, "item 63", 3), (64, "item 64", 4), (65, "item 65", 5), (66, "item 66", 6), (67, "item 67", 7), (68, "item 68", 8), (69, "item 69", 9), (70, "item 70", 0), (71, "item 71", 1), (72, "item 72", 2), (73, "item 73", 3), (74, "item 74", 4), (75, "item 75", 5), (76, "item 76", 6), (77, "item 77", 7), (78, "item 78", 8), (79, "item 79", 9), (80, "item 80", 0), (81, "item 81", 1), (82, "item 82", 2), (83, "item 83", 3), (84, "item 84", 4), (85, "item 85", 5), (86, "item 86", 6), (87, "item 87", 7), (88, "item 88", 8), (89, "item 89", 9), (90, "item 90", 0), (91, "item 91", 1), (92, "item 92", 2), (93, "item 93", 3), (94, "item 94", 4), (95, "item 95", 5), (96, "item 96", 6), (97, "item 97", 7), (98, "item 98", 8), (99, "item 99", 9);
+insert into items (id, name, qty) values (100, "item 100", 0), (101, "item 101", 1), (102, "item 102", 2), (103, "item 103", 3), (104, "item 104", 4), (105, "item 105", 5), (106, "item 106", 6), (107, "item 107", 7), (108, "item 108", 8), (109, "item 109", 9), (110, "item 110", 0), (111, "item 111", 1), (112, "item 112", 2), (113, "item 113", 3), (114, "item 114", 4), (115, "item 115", 5), (116, "item 116", 6), (117, "item 117", 7), (118, "item 118", 8), (119, "item 119", 9), (120, "item 120", 0), (121, "item 121", 1), (122, "item 122", 2), (123, "item 123", 3), (124, "item 124", 4), (125, "item 125", 5), (126, "item 126", 6), (127, "item 127", 7), (128, "item 128", 8), (129, "item 129", 9), (130, "item 130", 0), (131, "item 131", 1), (132, "item 132", 2), (133, "item 133", 3), (134, "item 134", 4), (135, "item 135", 5), (136, "item 136", 6), (137, "item 137", 7), (138, "item 138", 8), (139, "item 139", 9), (140, "item 140", 0), (141, "item 141", 1), (142, "item 142", 2), (143, "item 143", 3), (144, "item 144", 4), (145, "item 145", 5), (146, "item 146", 6), (147, "item 147", 7), (148, "item 148", 8), (149, "item 149", 9);
+insert into items (id, name, qty) values (150, "item 150", 0), (151, "item 151", 1), (152, "item 152", 2), (153, "item 153", 3), (154, "item 154", 4), (155, "item 155", 5), (156, "item 156", 6), (157, "item 157", 7), (158, "item 158", 8), (159, "item 159", 9), (160, "item 160", 0), (161, "item 161", 1), (162, "item 162", 2), (163, "item 163", 3), (164, "item 164", 4), (165, "item 165", 5), (166, "item 166", 6), (167, "item 167", 7), (168, "item 168", 8), (169, "item 169", 9), (170, "item 170", 0), (171, "item 171", 1), (172, "item 172", 2), (173, "item 173", 3), (174, "item 174", 4), (175, "item 175", 5), (176, "item 176", 6), (177, "item 177", 7), (178, "item 178", 8), (179, "item 179", 9), (180, "item 180", 0), (181, "item 181", 1), (182, "item 182", 2), (183, "item 183", 3), (184, "item 184", 4), (185, "item 185", 5), (186, "item 186", 6), (187, "item 187", 7), (188, "item 188", 8), (189, "item 189", 9), (190, "item 190", 0), (191, "item 191", 1), (192, "item 192", 2), (193, "item 193", 3), (194, "item 194", 4), (195, "item 195", 5), (196, "item 196", 6), (197, "item 197", 7), (198, "item 198", 8), (199, "item 199", 9);
+insert into items (id, name, qty) values (200, "item 200", 0), (201, "item 201", 1), (202, "item 202", 2), (203, "item 203", 3), (204, "item 204", 4), (205, "item 205", 5), (206, "item 206", 6), (207, "item 207", 7), (208, "item 208", 8), (209, "item 209", 9), (210, "item 210", 0), (211, "item 211", 1), (212, "item 212", 2), (213, "item 213", 3), (214, "item 214", 4), (215, "item 215", 5), (216, "item 216", 6), (217, "item 217", 7), (218, "item 218", 8), (219, "item 219", 9), (220, "item 220", 0), (221, "item 221", 1), (222, "item 222", 2), (223, "item 223", 3), (224, "item 224", 4), (225, "item 225", 5), (226, "item 226", 6), (227, "item 227", 7), (228, "item 228", 8), (229, "item 229", 9), (230, "item 230", 0), (231, "item 231", 1), (232, "item 232", 2), (233, "item 233", 3), (234, "item 234", 4), (235, "item 235", 5), (236, "item 236", 6), (237, "item 237", 7), (238, "item 238", 8), (239, "item 239", 9), (240, "item 240", 0), (241, "item 241", 1), (242, "item 242", 2), (243, "item 243", 3), (244, "item 244", 4), (245, "item 245", 5), (246, "item 246", 6), (247, "item 247", 7), (248, "item 248", 8), (249, "item 249", 9);
+insert into items (id, name, qty) values (250, "item 250", 0), (251, "item 251", 1), (252, "item 252", 2), (253, "item 253", 3), (254, "item 254", 4), (255, "item 255", 5), (256, "item 256", 6), (257, "item 257", 7), (258, "item 258", 8), (259, "item 259", 9), (260, "item 260", 0), (261, "item 261", 1), (262, "item 262", 2), (263, "item 263", 3), (264, "item 264", 4), (265, "item 265", 5), (266, "item 266", 6), (267, "item 267", 7), (268, "item 268", 8), (269, "item 269", 9), (270, "item 270", 0), (271, "item 271", 1), (272, "item 272", 2), (273, "item 273", 3), (274, "item 274", 4), (275, "item 275", 5), (276, "item 276", 6), (277, "item 277", 7), (278, "item 278", 8), (279, "item 279", 9), (280, "item 280", 0), (281, "item 281", 1), (282, "item 282", 2), (283, "item 283", 3), (284, "item 284", 4), (285, "item 285", 5), (286, "item 286", 6), (287, "item 287", 7), (288, "item 288", 8), (289, "item 289", 9), (290, "item 290", 0), (291, "item 291", 1), (292, "item 292", 2), (293, "item 293", 3), (294, "item 294", 4), (295, "item 295", 5), (296, "item 296", 6), (297, "item 297", 7), (298, "item 298", 8), (299, "item 299", 9);
+delete from items where id < 200;
+select * from items where id < 205;
+delete from items where qty > 0;
+select * from items where id < 260;
+delete from items;
+select * from items;
+insert into items (id, name, qty) values (1, "bolt", 5), (2, "nut", 7), (3, "washer", 9);
+select * from items;
+drop table items;
+
+close churn;
+drop database churn;
+exit;
@@ -0,0 +1,36 @@
+if exists drop database sol;
+create database sol;
+open sol;
+
+create table moons (
+                        id int8 key,
+                        name text, 
+                        planet text,
+                        radius float8
+                    );
+
+insert into moons (
+                        id,
+                        name, 
+                        planet,
+                        radius
+                    ) 
+
+values
+        (1, "Moon", "Earth", 1737.4),
+        (2, "Phobos", "Mars", 11.3),
+        (3, "Deimos", "Mars", 6.2),
+        (4, "Io", "Jupiter", 1821.6),
+        (5, "Europa", "Jupiter", 1560.8),
+        (6, "Ganymede", "Jupiter", 2634.1),
+        (7, "Callisto", "Jupiter", 2410.3),
+        (8, "Titan", "Saturn", 2574.7),
+        (9, "Rhea", "Saturn", 763.8),
+        (10, "planet", "planet", 0.0);
+
+select distinct planet from moons;
+select distinct planet from moons order by planet desc limit 3;
+select distinct planet from moons group by planet, radius;
+close sol;
+drop database sol;
+exit;
@@ -0,0 +1,10 @@
+if exists drop database sol;
+create database sol;
+open sol;
+create table planets (id int8 key, name text);
+insert into planets (id, name) values (1, "Venus");
+drop database sol;
+select id, name from planets;
+close sol;
+drop database sol;
+exit;
@@ -0,0 +1,37 @@
+if exists drop database sol;
+create database sol;
+open sol;
+
+create table planets (
+                        id int8 key,
+                        name text, 
+                        mass float8, 
+                        moons int8,
+                        ring_system bool
+                    );
+
+insert into planets (
+                        id,
+                        name, 
+                        mass, 
+                        moons,
+                        ring_system
+                    ) 
+
+values
+        (1, "Mercury", 0.33, 0, false),
+        (2, "Venus", 4.87, 0, false),
+        (3, "Earth", null, 1, false),
+        (4, "Mars", 0.64, 2, false),
+        (5, "Jupiter", 1898.0, 95, true),
+        (6, "Saturn", 568.0, 146, true),
+        (7, "Uranus", null, 28, true),
+        (8, "Neptune", 102.0, 16, true);
+
+select ring_system, count(name), sum(moons), min(moons), max(moons), avg(mass) from planets group by ring_system;
+select ring_system, sum(mass), min(mass), max(mass) from planets group by ring_system having max(moons) < 10;
+select moons, count(id) from planets group by moons having count(id) > 1;
+select ring_system, max(moons) - min(moons) from planets group by ring_system order by ring_system desc;
+close sol;
+drop database sol;
+exit;
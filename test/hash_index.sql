@@ -0,0 +1,34 @@
+create database hidx;
+open hidx;
+
+create table orders (id int8 key, customer int8, paid bool, total float8);
+insert into orders (id, customer, paid, total) values (1, 10, true, 5.5), (2, 11, false, 12.0), (3, 10, false, 7.25), (4, 12, true, 0.0), (5, 11, true, -0.0), (6, null, false, 3.0);
+create index orders_customer on orders (customer) hash;
+create index orders_paid_total on orders (paid, total) hash;
+insert into orders (id, customer, paid, total) values (7, 10, true, 1.0), (8, 13, false, 12.0);
+select id, customer from orders where customer = 10;
+select id, customer from orders where 11 = customer;
+select id, customer from orders where customer = 99;
+select id, paid, total from orders where paid = true and total = 0.0;
+select id, paid, total from orders where paid = false and total = 12.0 and customer > 11;
+select id, customer from orders where customer >= 12;
+update orders set customer = 11 where id = 1;
+delete from orders where customer = 13;
+select id, customer from orders where customer = 10;
+select id, customer from orders where customer = 11;
+close hidx;
+open hidx;
+select id, customer from orders where customer = 11;
+select id, paid, total from orders where paid = false and total = 12.0;
+
+create table users (name text key, age int8);
+create index users_age on users (age) hash;
+create index users_age on users (age);
+drop index orders_customer;
+select id, customer from orders where customer = 11;
+drop table orders;
+drop index orders_paid_total;
+
+close hidx;
+drop database hidx;
+exit;
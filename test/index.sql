@@ -0,0 +1,36 @@
+create database idx;
+open idx;
+
+create table people (id int8 key, name text, age int8, score float8);
+insert into people (id, name, age, score) values (1, "alice", 30, 1.5), (2, "bob", 25, -2.0), (3, "carol", 30, 3.25), (4, "dave", null, 0.5), (5, "erin", 41, -7.5), (6, "frank", 25, 2.0), (7, "grace", 19, 0.0), (8, "heidi", 30, 9.0);
+create index people_age on people (age);
+create index people_name_score on people (name, score);
+insert into people (id, name, age, score) values (9, "ivan", 30, -1.0), (10, "judy", 55, 4.75), (11, "alice", 22, -3.0);
+select id, name, age from people where age = 30;
+select id, name, age from people where age > 25 and age <= 41;
+select id, name, age from people where 30 > age;
+select id, name, score from people where name = "alice" and score < 0.0;
+select id, name from people where name = "alice";
+select id, age from people where age = 30 and score > 2.0;
+select id, age from people where age is null;
+update people set age = 31 where id = 3;
+update people set name = "caroline" where id = 3;
+delete from people where age = 25;
+select id, name, age from people where age >= 30;
+select id, name from people where name = "carol";
+select id, name from people where name = "caroline";
+close idx;
+open idx;
+select id, name, age from people where age < 30;
+create index people_age on people (score);
+create index bad on people (height);
+create index bad on missing (age);
+drop index people_age;
+drop index people_age;
+select id, name, age from people where age = 30;
+drop table people;
+drop index people_name_score;
+
+close idx;
+drop database idx;
+exit;
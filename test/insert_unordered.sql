@@ -0,0 +1,29 @@
+create database shuffle;
+open shuffle;
+
+create table items (id int8 key, name text, qty int8);
+insert into items (id, name, qty) values (296, "item 296", 6), (47, "item 47", 7), (82, "item 82", 2), (265, "item 265", 5), (222, "item 222", 2), (169, "item 169", 9), (238, "item 238", 8), (271, "item 271", 1), (5, "item 5", 5), (170, "item 170", 0), (111, "item 111", 1), (281, "item 281", 1), (112, "item 112", 2), (187, "item 187", 7), (9, "item 9", 9), (275, "item 275", 5), (118, "item 118", 8), (145, "item 145", 5), (141, "item 141", 1), (119, "item 119", 9), (160, "item 160", 0), (276, "item 276", 6), (96, "item 96", 6), (131, "item 131", 1), (125, "item 125", 5), (236, "item 236", 6), (27, "item 27", 7), (273, "item 273", 3), (175, "item 175", 5), (267, "item 267", 7), (79, "item 79", 9), (40, "item 40", 0), (167, "item 167", 7), (73, "item 73", 3), (158, "item 158", 8), (106, "item 106", 6), (239, "item 239", 9), (280, "item 280", 0), (205, "item 205", 5), (64, "item 64", 4), (250, "item 250", 0), (65, "item 65", 5), (29, "item 29", 9), (199, "item 199", 9), (224, "item 224", 4), (48, "item 48", 8), (87, "item 87", 7), (226, "item 226", 6), (197, "item 197", 7), (157, "item 157", 7);
+insert into items (id, name, qty) values (46, "item 46", 6), (166, "item 166", 6), (19, "item 19", 9), (99, "item 99", 9), (117, "item 117", 7), (235, "item 235", 5), (207, "item 207", 7), (185, "item 185", 5), (139, "item 139", 9), (219, "item 219", 9), (233, "item 233", 3), (62, "item 62", 2), (85, "item 85", 5), (39, "item 39", 9), (55, "item 55", 5), (292, "item 292", 2), (105, "item 105", 5), (33, "item 33", 3), (249, "item 249", 9), (92, "item 92", 2), (81, "item 81", 1), (98, "item 98", 8), (164, "item 164", 4), (124, "item 124", 4), (58, "item 58", 8), (274, "item 274", 4), (220, "item 220", 0), (25, "item 25", 5), (120, "item 120", 0), (168, "item 168", 8), (287, "item 287", 7), (211, "item 211", 1), (282, "item 282", 2), (162, "item 162", 2), (288, "item 288", 8), (298, "item 298", 8), (198, "item 198", 8), (286, "item 286", 6), (230, "item 230", 0), (134, "item 134", 4), (150, "item 150", 0), (77, "item 77", 7), (76, "item 76", 6), (165, "item 165", 5), (91, "item 91", 1), (289, "item 289", 9), (240, "item 240", 0), (75, "item 75", 5), (123, "item 123", 3), (189, "item 189", 9);
+insert into items (id, name, qty) values (153, "item 153", 3), (90, "item 90", 0), (116, "item 116", 6), (126, "item 126", 6), (178, "item 178", 8), (200, "item 200", 0), (247, "item 247", 7), (89, "item 89", 9), (122, "item 122", 2), (270, "item 270", 0), (208, "item 208", 8), (192, "item 192", 2), (223, "item 223", 3), (140, "item 140", 0), (255, "item 255", 5), (61, "item 61", 1), (18, "item 18", 8), (36, "item 36", 6), (45, "item 45", 5), (181, "item 181", 1), (1, "item 1", 1), (161, "item 161", 1), (154, "item 154", 4), (221, "item 221", 1), (100, "item 100", 0), (159, "item 159", 9), (57, "item 57", 7), (15, "item 15", 5), (135, "item 135", 5), (294, "item 294", 4), (269, "item 269", 9), (30, "item 30", 0), (42, "item 42", 2), (277, "item 277", 7), (214, "item 214", 4), (12, "item 12", 2), (7, "item 7", 7), (66, "item 66", 6), (43, "item 43", 3), (74, "item 74", 4), (35, "item 35", 5), (94, "item 94", 4), (295, "item 295", 5), (130, "item 130", 0), (177, "item 177", 7), (24, "item 24", 4), (59, "item 59", 9), (252, "item 252", 2), (16, "item 16", 6), (186, "item 186", 6);
+insert into items (id, name, qty) values (63, "item 63", 3), (183, "item 183", 3), (227, "item 227", 7), (109, "item 109", 9), (264, "item 264", 4), (293, "item 293", 3), (254, "item 254", 4), (14, "item 14", 4), (132, "item 132", 2), (279, "item 279", 9), (72, "item 72", 2), (78, "item 78", 8), (212, "item 212", 2), (83, "item 83", 3), (209, "item 209", 9), (113, "item 113", 3), (278, "item 278", 8), (54, "item 54", 4), (182, "item 182", 2), (110, "item 110", 0), (245, "item 245", 5), (291, "item 291", 1), (206, "item 206", 6), (97, "item 97", 7), (284, "item 284", 4), (201, "item 201", 1), (225, "item 225", 5), (261, "item 261", 1), (53, "item 53", 3), (115, "item 115", 5), (204, "item 204", 4), (272, "item 272", 2), (248, "item 248", 8), (88, "item 88", 8), (262, "item 262", 2), (176, "item 176", 6), (144, "item 144", 4), (151, "item 151", 1), (133, "item 133", 3), (172, "item 172", 2), (93, "item 93", 3), (202, "item 202", 2), (11, "item 11", 1), (129, "item 129", 9), (156, "item 156", 6), (290, "item 290", 0), (253, "item 253", 3), (103, "item 103", 3), (180, "item 180", 0), (244, "item 244", 4);
+insert into items (id, name, qty) values (8, "item 8", 8), (147, "item 147", 7), (256, "item 256", 6), (68, "item 68", 8), (190, "item 190", 0), (38, "item 38", 8), (213, "item 213", 3), (263, "item 263", 3), (142, "item 142", 2), (69, "item 69", 9), (13, "item 13", 3), (10, "item 10", 0), (184, "item 184", 4), (155, "item 155", 5), (268, "item 268", 8), (37, "item 37", 7), (242, "item 242", 2), (179, "item 179", 9), (23, "item 23", 3), (243, "item 243", 3), (163, "item 163", 3), (49, "item 49", 9), (101, "item 101", 1), (17, "item 17", 7), (266, "item 266", 6), (241, "item 241", 1), (137, "item 137", 7), (127, "item 127", 7), (146, "item 146", 6), (234, "item 234", 4), (128, "item 128", 8), (4, "item 4", 4), (138, "item 138", 8), (34, "item 34", 4), (21, "item 21", 1), (228, "item 228", 8), (260, "item 260", 0), (84, "item 84", 4), (51, "item 51", 1), (218, "item 218", 8), (229, "item 229", 9), (50, "item 50", 0), (148, "item 148", 8), (195, "item 195", 5), (31, "item 31", 1), (0, "item 0", 0), (152, "item 152", 2), (246, "item 246", 6), (258, "item 258", 8), (217, "item 217", 7);
+insert into items (id, name, qty) values (232, "item 232", 2), (188, "item 188", 8), (108, "item 108", 8), (60, "item 60", 0), (6, "item 6", 6), (71, "item 71", 1), (251, "item 251", 1), (193, "item 193", 3), (28, "item 28", 8), (210, "item 210", 0), (2, "item 2", 2), (102, "item 102", 2), (22, "item 22", 2), (174, "item 174", 4), (143, "item 143", 3), (203, "item 203", 3), (107, "item 107", 7), (297, "item 297", 7), (44, "item 44", 4), (215, "item 215", 5), (114, "item 114", 4), (104, "item 104", 4), (149, "item 149", 9), (52, "item 52", 2), (196, "item 196", 6), (32, "item 32", 2), (259, "item 259", 9), (67, "item 67", 7), (56, "item 56", 6), (26, "item 26", 6), (121, "item 121", 1), (285, "item 285", 5), (80, "item 80", 0), (216, "item 216", 6), (231, "item 231", 1), (86, "item 86", 6), (194, "item 194", 4), (20, "item 20", 0), (283, "item 283", 3), (171, "item 171", 1), (41, "item 41", 1), (299, "item 299", 9), (257, "item 257", 7), (173, "item 173", 3), (3, "item 3", 3), (95, "item 95", 5), (70, "item 70", 0), (136, "item 136", 6), (191, "item 191", 1), (237, "item 237", 7);
+select * from items where id < 5;
+select * from items where id > 294;
+select id from items where id > 147 and id < 153;
+drop table items;
+
+create table words (word text key, len int8);
+insert into words (word, len) values ("w208", 4), ("w234", 4), ("w122", 4), ("w288", 4), ("w280", 4), ("w096", 4), ("w068", 4), ("w268", 4), ("w226", 4), ("w246", 4), ("w200", 4), ("w346", 4), ("w036", 4), ("w380", 4), ("w108", 4), ("w184", 4), ("w134", 4), ("w220", 4), ("w292", 4), ("w386", 4), ("w062", 4), ("w008", 4), ("w142", 4), ("w232", 4), ("w202", 4), ("w198", 4), ("w356", 4), ("w214", 4), ("w340", 4), ("w374", 4), ("w032", 4), ("w354", 4), ("w090", 4), ("w256", 4), ("w158", 4), ("w150", 4), ("w192", 4), ("w368", 4), ("w146", 4), ("w078", 4), ("w132", 4), ("w148", 4), ("w252", 4), ("w306", 4), ("w186", 4), ("w382", 4), ("w282", 4), ("w044", 4), ("w124", 4), ("w222", 4);
+insert into words (word, len) values ("w016", 4), ("w260", 4), ("w074", 4), ("w278", 4), ("w332", 4), ("w166", 4), ("w194", 4), ("w050", 4), ("w318", 4), ("w104", 4), ("w064", 4), ("w372", 4), ("w088", 4), ("w328", 4), ("w174", 4), ("w352", 4), ("w216", 4), ("w310", 4), ("w262", 4), ("w276", 4), ("w358", 4), ("w172", 4), ("w258", 4), ("w136", 4), ("w072", 4), ("w000", 4), ("w240", 4), ("w024", 4), ("w300", 4), ("w322", 4), ("w218", 4), ("w058", 4), ("w326", 4), ("w106", 4), ("w290", 4), ("w392", 4), ("w284", 4), ("w336", 4), ("w210", 4), ("w254", 4), ("w388", 4), ("w398", 4), ("w286", 4), ("w274", 4), ("w114", 4), ("w086", 4), ("w248", 4), ("w296", 4), ("w034", 4), ("w168", 4);
+insert into words (word, len) values ("w092", 4), ("w182", 4), ("w360", 4), ("w272", 4), ("w316", 4), ("w138", 4), ("w080", 4), ("w348", 4), ("w022", 4), ("w082", 4), ("w270", 4), ("w334", 4), ("w084", 4), ("w046", 4), ("w364", 4), ("w294", 4), ("w116", 4), ("w144", 4), ("w390", 4), ("w156", 4), ("w298", 4), ("w370", 4), ("w384", 4), ("w378", 4), ("w020", 4), ("w308", 4), ("w110", 4), ("w204", 4), ("w176", 4), ("w250", 4), ("w394", 4), ("w304", 4), ("w126", 4), ("w314", 4), ("w162", 4), ("w014", 4), ("w048", 4), ("w154", 4), ("w350", 4), ("w206", 4), ("w180", 4), ("w094", 4), ("w018", 4), ("w152", 4), ("w366", 4), ("w140", 4), ("w030", 4), ("w362", 4), ("w160", 4), ("w242", 4);
+insert into words (word, len) values ("w312", 4), ("w028", 4), ("w212", 4), ("w338", 4), ("w344", 4), ("w010", 4), ("w128", 4), ("w224", 4), ("w006", 4), ("w100", 4), ("w264", 4), ("w130", 4), ("w002", 4), ("w120", 4), ("w040", 4), ("w324", 4), ("w188", 4), ("w102", 4), ("w266", 4), ("w320", 4), ("w238", 4), ("w012", 4), ("w052", 4), ("w190", 4), ("w396", 4), ("w330", 4), ("w038", 4), ("w060", 4), ("w026", 4), ("w056", 4), ("w376", 4), ("w112", 4), ("w098", 4), ("w066", 4), ("w230", 4), ("w118", 4), ("w342", 4), ("w178", 4), ("w054", 4), ("w070", 4), ("w244", 4), ("w196", 4), ("w076", 4), ("w302", 4), ("w228", 4), ("w236", 4), ("w004", 4), ("w164", 4), ("w042", 4), ("w170", 4);
+insert into words (word, len) values ("w001", 4), ("w199", 4), ("w399", 4);
+select word from words where word < "w008";
+select word from words where word > "w196" and word < "w204";
+select word from words where word > "w392";
+drop table words;
+
+close shuffle;
+drop database shuffle;
+exit;
@@ -0,0 +1,26 @@
+create database krange;
+open krange;
+
+create table nums (id int8 key, v int8);
+insert into nums (id, v) values (1, 10), (2, 20), (3, 30), (4, 40), (5, 50), (6, 60), (7, 70), (8, 80), (9, 90), (10, 100);
+select id, v from nums where id >= 3 and id < 6;
+select id, v from nums where id > 3 and id <= 6;
+select id, v from nums where 8 < id;
+select id, v from nums where id = 4;
+select id, v from nums where id = 11;
+select id, v from nums where id > 2 and id > 7 and id < 10 and v > 80;
+select id, v from nums where id > 6 and id < 4;
+select id, v from nums where id < 3 or id > 8;
+update nums set v = 0 where id >= 9;
+delete from nums where id > 1 and id <= 3;
+select id, v from nums where id <= 4;
+select id, v from nums where id >= 9;
+
+create table words (word text key, n int8);
+insert into words (word, n) values ("apple", 1), ("banana", 2), ("cherry", 3), ("date", 4);
+select word, n from words where word >= "b" and word < "d";
+select word, n from words where word = "date";
+
+close krange;
+drop database krange;
+exit;
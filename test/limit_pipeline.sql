@@ -0,0 +1,39 @@
+if exists drop database sol;
+create database sol;
+open sol;
+
+create table moons (
+                        id int8 key,
+                        name text, 
+                        planet text,
+                        radius float8
+                    );
+
+insert into moons (
+                        id,
+                        name, 
+                        planet,
+                        radius
+                    ) 
+
+values
+        (9, "Rhea", "Saturn", 763.8),
+        (1, "Moon", "Earth", 1737.4),
+        (3, "Deimos", "Mars", 6.2),
+        (6, "Ganymede", "Jupiter", 2634.1),
+        (2, "Phobos", "Mars", 11.3),
+        (8, "Titan", "Saturn", 2574.7),
+        (4, "Io", "Jupiter", 1821.6),
+        (7, "Callisto", "Jupiter", 2410.3),
+        (5, "Europa", "Jupiter", 1560.8);
+
+create index planet_idx on moons (planet);
+
+select id, name from moons limit 4;
+select id, name from moons where id > 4 limit 3;
+select distinct planet from moons limit 3;
+select id, name from moons where planet = "Jupiter" limit 3;
+select name from moons where radius > 1000.0 limit 0;
+close sol;
+drop database sol;
+exit;
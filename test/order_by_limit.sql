@@ -0,0 +1,17 @@
+create database topn;
+open topn;
+
+create table events (id int8 key, kind text, at int8);
+insert into events (id, kind, at) values (1, "login", 50), (2, "click", 10), (3, "login", 40), (4, "logout", 90), (5, "click", 70), (6, "click", 20), (7, "login", 80), (8, "logout", 30), (9, "click", 60), (10, "login", 0);
+select id, kind, at from events order by at desc limit 3;
+select id, kind, at from events order by at limit 4;
+select id, kind, at from events where kind = "click" order by at desc limit 2;
+select id, kind from events order by kind limit 5;
+select id, kind from events order by kind desc limit 3;
+select id, at from events order by at limit 0;
+select id, at from events order by at desc limit 20;
+select id, at from events where id > 4 limit 2;
+
+close topn;
+drop database topn;
+exit;
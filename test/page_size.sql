@@ -0,0 +1,14 @@
+create database sol page_size 0;
+create database sol page_size 4294971392;
+create database sol page_size 3000;
+create database sol page_size 16384;
+open sol;
+
+create table planets (id int8 key, name text, mass int8, atmosphere bool);
+insert into planets (id, name, mass, atmosphere) values (1, "Neptune", 20, false), (2, "Mars", 10, true), (3, "Venus", 10, false);
+select * from planets;
+drop table planets;
+
+close sol;
+drop database sol;
+exit;
@@ -0,0 +1,25 @@
+create database vac;
+open vac;
+
+create table items (id int8 key, name text, qty int8);
+insert into items (id, name, qty) values (0, "item 0", 0), (1, "item 1", 1), (2, "item 2", 2), (3, "item 3", 3), (4, "item 4", 4), (5, "item 5", 5), (6, "item 6", 6), (7, "item 7", 0), (8, "item 8", 1), (9, "item 9", 2), (10, "item 10", 3), (11, "item 11", 4), (12, "item 12", 5), (13, "item 13", 6), (14, "item 14", 0), (15, "item 15", 1), (16, "item 16", 2), (17, "item 17", 3), (18, "item 18", 4), (19, "item 19", 5), (20, "item 20", 6), (21, "item 21", 0), (22, "item 22", 1), (23, "item 23", 2), (24, "item 24", 3), (25, "item 25", 4), (26, "item 26", 5), (27, "item 27", 6), (28, "item 28", 0), (29, "item 29", 1), (30, "item 30", 2), (31, "item 31", 3), (32, "item 32", 4), (33, "item 33", 5), (34, "item 34", 6), (35, "item 35", 0), (36, "item 36", 1), (37, "item 37", 2), (38, "item 38", 3), (39, "item 39", 4), (40, "item 40", 5), (41, "item 41", 6), (42, "item 42", 0), (43, "item 43", 1), (44, "item 44", 2), (45, "item 45", 3), (46, "item 46", 4), (47, "item 47", 5), (48, "item 48", 6), (49, "item 49", 0), (50, "item 50", 1), (51, "item 51", 2), (52, "item 52", 3), (53, "item 53", 4), (54, "item 54", 5), (55, "item 55", 6), (56, "item 56", 0), (57, "item 57", 1), (58, "item 58", 2), (59, "item 59", 3), (60, "item 60", 4), (61, "item 61", 5), (62, "item 62", 6), (63, "item 63", 0), (64, "item 64", 1), (65, "item 65", 2), (66, "item 66", 3), (67, "item 67", 4), (68, "item 68", 5), (69, "item 69", 6), (70, "item 70", 0), (71, "item 71", 1), (72, "item 72", 2), (73, "item 73", 3), (74, "item 74", 4), (75, "item 75", 5), (76, "item 76", 6), (77, "item 77", 0), (78, "item 78", 1), (79, "item 79", 2), (80, "item 80", 3), (81, "item 81", 4), (82, "item 82", 5), (83, "item 83", 6), (84, "item 84", 0), (85, "item 85", 1), (86, "item 86", 2), (87, "item 87", 3), (88, "item 88", 4), (89, "item 89", 5), (90, "item 90", 6), (91, "item 91", 0), (92, "item 92", 1), (93, "item 93", 2), (94, "item 94", 3), (95, "item 95", 4), (96, "item 96", 5), (97, "item 97", 6), (98, "item 98", 0), (99, "item 99", 1), (100, "item 100", 2), (101, "item 101", 3), (102, "item 102", 4), (103, "item 103", 5), (104, "item 104", 6), (105, "item 105", 0), (106, "item 106", 1), (107, "item 107", 2), (108, "item 108", 3), (109, "item 109", 4), (110, "item 110", 5), (111, "item 111", 6), (112, "item 112", 0), (113, "item 113", 1), (114, "item 114", 2), (115, "item 115", 3), (116, "item 116", 4), (117, "item 117", 5), (118, "item 118", 6), (119, "item 119", 0), (120, "item 120", 1), (121, "item 121", 2), (122, "item 122", 3), (123, "item 123", 4), (124, "item 124", 5), (125, "item 125", 6), (126, "item 126", 0), (127, "item 127", 1), (128, "item 128", 2), (129, "item 129", 3), (130, "item 130", 4), (131, "item 131", 5), (132, "item 132", 6), (133, "item 133", 0), (134, "item 134", 1), (135, "item 135", 2), (136, "item 136", 3), (137, "item 137", 4), (138, "item 138", 5), (139, "item 139", 6), (140, "item 140", 0), (141, "item 141", 1), (142, "item 142", 2), (143, "item 143", 3), (144, "item 144", 4), (145, "item 145", 5), (146, "item 146", 6), (147, "item 147", 0), (148, "item 148", 1), (149, "item 149", 2), (150, "item 150", 3), (151, "item 151", 4), (152, "item 152", 5), (153, "item 153", 6), (154, "item 154", 0), (155, "item 155", 1), (156, "item 156", 2), (157, "item 157", 3), (158, "item 158", 4), (159, "item 159", 5), (160, "item 160", 6), (161, "item 161", 0), (162, "item 162", 1), (163, "item 163", 2), (164, "item 164", 3), (165, "item 165", 4), (166, "item 166", 5), (167, "item 167", 6), (168, "item 168", 0), (169, "item 169", 1), (170, "item 170", 2), (171, "item 171", 3), (172, "item 172", 4), (173, "item 173", 5), (174, "item 174", 6), (175, "item 175", 0), (176, "item 176", 1), (177, "item 177", 2), (178, "item 178", 3), (179, "item 179", 4), (180, "item 180", 5), (181, "item 181", 6), (182, "item 182", 0), (183, "item 183", 1), (184, "item 184", 2), (185, "item 185", 3), (186, "item 186", 4), (187, "item 187", 5), (188, "item 188", 6), (189, "item 189", 0), (190, "item 190", 1), (191, "item 191", 2), (192, "item 192", 3), (193, "item 193", 4), (194, "item 194", 5), (195, "item 195", 6), (196, "item 196", 0), (197, "item 197", 1), (198, "item 198", 2), (199, "item 199", 3), (200, "item 200", 4), (201, "item 201", 5), (202, "item 202", 6), (203, "item 203", 0), (204, "item 204", 1), (205, "item 205", 2), (206, "item 206", 3), (207, "item 207", 4), (208, "item 208", 5), (209, "item 209", 6), (210, "item 210", 0), (211, "item 211", 1), (212, "item 212", 2), (213, "item 213", 3), (214, "item 214", 4), (215, "item 215", 5), (216, "item 216", 6), (217, "item 217", 0), (218, "item 218", 1), (219, "item 219", 2), (220, "item 220", 3), (221, "item 221", 4), (222, "item 222", 5), (223, "item 223", 6), (224, "item 224", 0), (225, "item 225", 1), (226, "item 226", 2), (227, "item 227", 3), (228, "item 228", 4), (229, "item 229", 5), (230, "item 230", 6), (231, "item 231", 0), (232, "item 232", 1), (233, "item 233", 2), (234, "item 234", 3), (235, "item 235", 4), (236, "item 236", 5), (237, "item 237", 6), (238, "item 238", 0), (239, "item 239", 1), (240, "item 240", 2), (241, "item 241", 3), (242, "item 242", 4), (243, "item 243", 5), (244, "item 244", 6), (245, "item 245", 0), (246, "item 246", 1), (247, "item 247", 2), (248, "item 248", 3), (249, "item 249", 4), (250, "item 250", 5), (251, "item 251", 6), (252, "item 252", 0), (253, "item 253", 1), (254, "item 254", 2), (255, "item 255", 3), (256, "item 256", 4), (257, "item 257", 5), (258, "item 258", 6), (259, "item 259", 0), (260, "item 260", 1), (261, "item 261", 2), (262, "item 262", 3), (263, "item 263", 4), (264, "item 264", 5), (265, "item 265", 6), (266, "item 266", 0), (267, "item 267", 1), (268, "item 268", 2), (269, "item 269", 3), (270, "item 270", 4), (271, "item 271", 5), (272, "item 272", 6), (273, "item 273", 0), (274, "item 274", 1), (275, "item 275", 2), (276, "item 276", 3), (277, "item 277", 4), (278, "item 278", 5), (279, "item 279", 6), (280, "item 280", 0), (281, "item 281", 1), (282, "item 282", 2), (283, "item 283", 3), (284, "item 284", 4), (285, "item 285", 5), (286, "item 286", 6), (287, "item 287", 0), (288, "item 288", 1), (289, "item 289", 2), (290, "item 290", 3), (291, "item 291", 4), (292, "item 292", 5), (293, "item 293", 6), (294, "item 294", 0), (295, "item 295", 1), (296, "item 296", 2), (297, "item 297", 3), (298, "item 298", 4), (299, "item 299", 5);
+delete from items where id > 5 and id < 290;
+update items set name = "renamed" where id = 3;
+vacuum items;
+select id, name, qty from items;
+insert into items (id, name, qty) values (100, "item 100", 1), (400, "item 400", 2);
+select id, name from items where id > 50;
+drop table items;
+
+create table points (id int8 key, x float8, label text) clustered;
+insert into points (id, x, label) values (0, 0.5, "point 0"), (1, 1.5, "point 1"), (2, 2.5, "point 2"), (3, 3.5, "point 3"), (4, 4.5, "point 4"), (5, 5.5, "point 5"), (6, 6.5, "point 6"), (7, 7.5, "point 7"), (8, 8.5, "point 8"), (9, 9.5, "point 9"), (10, 10.5, "point 10"), (11, 11.5, "point 11"), (12, 12.5, "point 12"), (13, 13.5, "point 13"), (14, 14.5, "point 14"), (15, 15.5, "point 15"), (16, 16.5, "point 16"), (17, 17.5, "point 17"), (18, 18.5, "point 18"), (19, 19.5, "point 19"), (20, 20.5, "point 20"), (21, 21.5, "point 21"), (22, 22.5, "point 22"), (23, 23.5, "point 23"), (24, 24.5, "point 24"), (25, 25.5, "point 25"), (26, 26.5, "point 26"), (27, 27.5, "point 27"), (28, 28.5, "point 28"), (29, 29.5, "point 29"), (30, 30.5, "point 30"), (31, 31.5, "point 31"), (32, 32.5, "point 32"), (33, 33.5, "point 33"), (34, 34.5, "point 34"), (35, 35.5, "point 35"), (36, 36.5, "point 36"), (37, 37.5, "point 37"), (38, 38.5, "point 38"), (39, 39.5, "point 39"), (40, 40.5, "point 40"), (41, 41.5, "point 41"), (42, 42.5, "point 42"), (43, 43.5, "point 43"), (44, 44.5, "point 44"), (45, 45.5, "point 45"), (46, 46.5, "point 46"), (47, 47.5, "point 47"), (48, 48.5, "point 48"), (49, 49.5, "point 49"), (50, 50.5, "point 50"), (51, 51.5, "point 51"), (52, 52.5, "point 52"), (53, 53.5, "point 53"), (54, 54.5, "point 54"), (55, 55.5, "point 55"), (56, 56.5, "point 56"), (57, 57.5, "point 57"), (58, 58.5, "point 58"), (59, 59.5, "point 59"), (60, 60.5, "point 60"), (61, 61.5, "point 61"), (62, 62.5, "point 62"), (63, 63.5, "point 63"), (64, 64.5, "point 64"), (65, 65.5, "point 65"), (66, 66.5, "point 66"), (67, 67.5, "point 67"), (68, 68.5, "point 68"), (69, 69.5, "point 69"), (70, 70.5, "point 70"), (71, 71.5, "point 71"), (72, 72.5, "point 72"), (73, 73.5, "point 73"), (74, 74.5, "point 74"), (75, 75.5, "point 75"), (76, 76.5, "point 76"), (77, 77.5, "point 77"), (78, 78.5, "point 78"), (79, 79.5, "point 79"), (80, 80.5, "point 80"), (81, 81.5, "point 81"), (82, 82.5, "point 82"), (83, 83.5, "point 83"), (84, 84.5, "point 84"), (85, 85.5, "point 85"), (86, 86.5, "point 86"), (87, 87.5, "point 87"), (88, 88.5, "point 88"), (89, 89.5, "point 89"), (90, 90.5, "point 90"), (91, 91.5, "point 91"), (92, 92.5, "point 92"), (93, 93.5, "point 93"), (94, 94.5, "point 94"), (95, 95.5, "point 95"), (96, 96.5, "point 96"), (97, 97.5, "point 97"), (98, 98.5, "point 98"), (99, 99.5, "point 99"), (100, 100.5, "point 100"), (101, 101.5, "point 101"), (102, 102.5, "point 102"), (103, 103.5, "point 103"), (104, 104.5, "point 104"), (105, 105.5, "point 105"), (106, 106.5, "point 106"), (107, 107.5, "point 107"), (108, 108.5, "point 108"), (109, 109.5, "point 109"), (110, 110.5, "point 110"), (111, 111.5, "point 111"), (112, 112.5, "point 112"), (113, 113.5, "point 113"), (114, 114.5, "point 114"), (115, 115.5, "point 115"), (116, 116.5, "point 116"), (117, 117.5, "point 117"), (118, 118.5, "point 118"), (119, 119.5, "point 119"), (120, 120.5, "point 120"), (121, 121.5, "point 121"), (122, 122.5, "point 122"), (123, 123.5, "point 123"), (124, 124.5, "point 124"), (125, 125.5, "point 125"), (126, 126.5, "point 126"), (127, 127.5, "point 127"), (128, 128.5, "point 128"), (129, 129.5, "point 129"), (130, 130.5, "point 130"), (131, 131.5, "point 131"), (132, 132.5, "point 132"), (133, 133.5, "point 133"), (134, 134.5, "point 134"), (135, 135.5, "point 135"), (136, 136.5, "point 136"), (137, 137.5, "point 137"), (138, 138.5, "point 138"), (139, 139.5, "point 139"), (140, 140.5, "point 140"), (141, 141.5, "point 141"), (142, 142.5, "point 142"), (143, 143.5, "point 143"), (144, 144.5, "point 144"), (145, 145.5, "point 145"), (146, 146.5, "point 146"), (147, 147.5, "point 147"), (148, 148.5, "point 148"), (149, 149.5, "point 149"), (150, 150.5, "point 150"), (151, 151.5, "point 151"), (152, 152.5, "point 152"), (153, 153.5, "point 153"), (154, 154.5, "point 154"), (155, 155.5, "point 155"), (156, 156.5, "point 156"), (157, 157.5, "point 157"), (158, 158.5, "point 158"), (159, 159.5, "point 159"), (160, 160.5, "point 160"), (161, 161.5, "point 161"), (162, 162.5, "point 162"), (163, 163.5, "point 163"), (164, 164.5, "point 164"), (165, 165.5, "point 165"), (166, 166.5, "point 166"), (167, 167.5, "point 167"), (168, 168.5, "point 168"), (169, 169.5, "point 169"), (170, 170.5, "point 170"), (171, 171.5, "point 171"), (172, 172.5, "point 172"), (173, 173.5, "point 173"), (174, 174.5, "point 174"), (175, 175.5, "point 175"), (176, 176.5, "point 176"), (177, 177.5, "point 177"), (178, 178.5, "point 178"), (179, 179.5, "point 179"), (180, 180.5, "point 180"), (181, 181.5, "point 181"), (182, 182.5, "point 182"), (183, 183.5, "point 183"), (184, 184.5, "point 184"), (185, 185.5, "point 185"), (186, 186.5, "point 186"), (187, 187.5, "point 187"), (188, 188.5, "point 188"), (189, 189.5, "point 189"), (190, 190.5, "point 190"), (191, 191.5, "point 191"), (192, 192.5, "point 192"), (193, 193.5, "point 193"), (194, 194.5, "point 194"), (195, 195.5, "point 195"), (196, 196.5, "point 196"), (197, 197.5, "point 197"), (198, 198.5, "point 198"), (199, 199.5, "point 199");
+delete from points where id > 2 and id < 197;
+vacuum points;
+select id, x, label from points;
+drop table points;
+
+vacuum missing;
+
+close vac;
+drop database vac;
+exit;
@@ -0,0 +1,204 @@
+if exists drop database sol;
+create database sol;
+open sol;
+
+create table moons (
+                        id int8 key,
+                        name text, 
+                        radius float8,
+                        tidal bool,
+                        discovered int8
+                    );
+
+insert into moons (
+                        id,
+                        name, 
+                        radius,
+                        tidal,
+                        discovered
+                    ) 
+
+values
+        (9, "Rhea", 763.8, true, 1672),
+        (1, "Moon", 1737.4, true, null),
+        (3, "Deimos", 6.2, false, 1877),
+        (6, "Ganymede", 2634.1, true, 1610),
+        (2, "Phobos", 11.3, false, 1877),
+        (8, "Titan", 2574.7, true, 1655),
+        (4, "Io", 1821.6, true, 1610),
+        (7, "Callisto", null, null, 1610),
+        (5, "Europa", 1560.8, true, 1610);
+
+select id, name from moons where discovered = 1610;
+select id, name from moons where 1700 < discovered;
+select id, name from moons where radius >= 1000.0 and tidal = true;
+select id, name from moons where tidal <> true or discovered is null;
+select id, name from moons where radius is null or radius < 100.0;
+select id, name from moons where discovered > -1 and radius > -1.5 order by name;
+select id, name from moons where tidal = false and discovered = 1877 limit 2;
+
+create table readings (
+                        reading float8,
+                        id int8 key
+                    );
+
+insert into readings (reading, id) values
+        (null, 0), (1.0, 1), (-5.0, 2), (2.0, 3), (-4.0, 4), (99.5, 5), (-3.0, 6), (4.0, 7),
+        (-2.0, 8), (5.0, 9), (null, 10), (6.0, 11), (0.0, 12), (-6.0, 13), (1.0, 14), (-5.0, 15),
+        (2.0, 16), (-4.0, 17), (3.0, 18), (-3.0, 19), (null, 20), (-2.0, 21), (5.0, 22), (-1.0, 23),
+        (6.0, 24), (0.0, 25), (-6.0, 26), (1.0, 27), (-5.0, 28), (2.0, 29), (null, 30), (3.0, 31),
+        (-3.0, 32), (4.0, 33), (-2.0, 34), (5.0, 35), (-1.0, 36), (6.0, 37), (0.0, 38), (-6.0, 39),
+        (null, 40), (-5.0, 41), (2.0, 42), (-4.0, 43), (3.0, 44), (-3.0, 45), (4.0, 46), (-2.0, 47),
+        (5.0, 48), (-1.0, 49), (null, 50), (0.0, 51), (-6.0, 52), (1.0, 53), (-5.0, 54), (2.0, 55),
+        (-4.0, 56), (3.0, 57), (-3.0, 58), (4.0, 59), (null, 60), (5.0, 61), (-1.0, 62), (6.0, 63),
+        (0.0, 64), (-6.0, 65), (1.0, 66), (-5.0, 67), (2.0, 68), (-4.0, 69), (null, 70), (-3.0, 71),
+        (4.0, 72), (-2.0, 73), (5.0, 74), (-1.0, 75), (6.0, 76), (0.0, 77), (-6.0, 78), (1.0, 79),
+        (null, 80), (2.0, 81), (-4.0, 82), (3.0, 83), (-3.0, 84), (4.0, 85), (-2.0, 86), (5.0, 87),
+        (-1.0, 88), (6.0, 89), (null, 90), (-6.0, 91), (1.0, 92), (-5.0, 93), (2.0, 94), (-4.0, 95),
+        (3.0, 96), (-3.0, 97), (4.0, 98), (-2.0, 99), (null, 100), (-1.0, 101), (6.0, 102), (0.0, 103),
+        (-6.0, 104), (1.0, 105), (-5.0, 106), (2.0, 107), (-4.0, 108), (3.0, 109), (null, 110), (4.0, 111),
+        (-2.0, 112), (5.0, 113), (-1.0, 114), (6.0, 115), (0.0, 116), (-6.0, 117), (1.0, 118), (-5.0, 119),
+        (null, 120), (-4.0, 121), (3.0, 122), (-3.0, 123), (4.0, 124), (-2.0, 125), (5.0, 126), (-1.0, 127),
+        (6.0, 128), (0.0, 129), (null, 130), (1.0, 131), (-5.0, 132), (2.0, 133), (-4.0, 134), (3.0, 135),
+        (-3.0, 136), (4.0, 137), (-2.0, 138), (5.0, 139), (null, 140), (6.0, 141), (0.0, 142), (-6.0, 143),
+        (1.0, 144), (-5.0, 145), (2.0, 146), (-4.0, 147), (3.0, 148), (-3.0, 149), (null, 150), (-2.0, 151),
+        (5.0, 152), (-1.0, 153), (6.0, 154), (0.0, 155), (-6.0, 156), (1.0, 157), (-5.0, 158), (2.0, 159),
+        (null, 160), (3.0, 161), (-3.0, 162), (4.0, 163), (-2.0, 164), (5.0, 165), (-1.0, 166), (6.0, 167),
+        (0.0, 168), (-6.0, 169), (null, 170), (-5.0, 171), (2.0, 172), (-4.0, 173), (3.0, 174), (-3.0, 175),
+        (4.0, 176), (-2.0, 177), (5.0, 178), (-1.0, 179), (null, 180), (0.0, 181), (-6.0, 182), (1.0, 183),
+        (-5.0, 184), (2.0, 185), (-4.0, 186), (3.0, 187), (-3.0, 188), (4.0, 189), (null, 190), (5.0, 191),
+        (-1.0, 192), (6.0, 193), (0.0, 194), (-6.0, 195), (1.0, 196), (-5.0, 197), (2.0, 198), (-4.0, 199),
+        (null, 200), (-3.0, 201), (4.0, 202), (-2.0, 203), (5.0, 204), (-1.0, 205), (6.0, 206), (0.0, 207),
+        (-6.0, 208), (1.0, 209), (null, 210), (2.0, 211), (-4.0, 212), (3.0, 213), (-3.0, 214), (4.0, 215),
+        (-2.0, 216), (5.0, 217), (-1.0, 218), (6.0, 219), (null, 220), (-6.0, 221), (1.0, 222), (-5.0, 223),
+        (2.0, 224), (-4.0, 225), (3.0, 226), (-3.0, 227), (4.0, 228), (-2.0, 229), (null, 230), (-1.0, 231),
+        (6.0, 232), (0.0, 233), (-6.0, 234), (1.0, 235), (-5.0, 236), (2.0, 237), (-4.0, 238), (3.0, 239),
+        (null, 240), (4.0, 241), (-2.0, 242), (5.0, 243), (-1.0, 244), (6.0, 245), (0.0, 246), (-6.0, 247),
+        (1.0, 248), (-5.0, 249), (null, 250), (-4.0, 251), (3.0, 252), (-3.0, 253), (4.0, 254), (-2.0, 255),
+        (5.0, 256), (-1.0, 257), (6.0, 258), (0.0, 259), (null, 260), (1.0, 261), (-5.0, 262), (2.0, 263),
+        (-4.0, 264), (3.0, 265), (-3.0, 266), (4.0, 267), (-2.0, 268), (5.0, 269), (null, 270), (6.0, 271),
+        (0.0, 272), (-6.0, 273), (1.0, 274), (-5.0, 275), (2.0, 276), (-4.0, 277), (3.0, 278), (-3.0, 279),
+        (null, 280), (-2.0, 281), (5.0, 282), (-1.0, 283), (6.0, 284), (0.0, 285), (-6.0, 286), (1.0, 287),
+        (-5.0, 288), (2.0, 289), (null, 290), (3.0, 291), (-3.0, 292), (4.0, 293), (-2.0, 294), (5.0, 295),
+        (-1.0, 296), (6.0, 297), (0.0, 298), (-6.0, 299), (null, 300), (-5.0, 301), (2.0, 302), (-4.0, 303),
+        (3.0, 304), (-3.0, 305), (4.0, 306), (-2.0, 307), (5.0, 308), (-1.0, 309), (null, 310), (0.0, 311),
+        (-6.0, 312), (1.0, 313), (-5.0, 314), (2.0, 315), (-4.0, 316), (3.0, 317), (-3.0, 318), (4.0, 319),
+        (null, 320), (5.0, 321), (-1.0, 322), (6.0, 323), (0.0, 324), (-6.0, 325), (1.0, 326), (-5.0, 327),
+        (2.0, 328), (-4.0, 329), (null, 330), (-3.0, 331), (4.0, 332), (-2.0, 333), (5.0, 334), (-1.0, 335),
+        (6.0, 336), (0.0, 337), (-6.0, 338), (1.0, 339), (null, 340), (2.0, 341), (-4.0, 342), (3.0, 343),
+        (-3.0, 344), (4.0, 345), (-2.0, 346), (5.0, 347), (-1.0, 348), (6.0, 349), (null, 350), (-6.0, 351),
+        (1.0, 352), (-5.0, 353), (2.0, 354), (-4.0, 355), (3.0, 356), (-3.0, 357), (4.0, 358), (-2.0, 359),
+        (null, 360), (-1.0, 361), (6.0, 362), (0.0, 363), (-6.0, 364), (1.0, 365), (-5.0, 366), (2.0, 367),
+        (-4.0, 368), (3.0, 369), (null, 370), (4.0, 371), (-2.0, 372), (5.0, 373), (-1.0, 374), (6.0, 375),
+        (0.0, 376), (-6.0, 377), (1.0, 378), (-5.0, 379), (null, 380), (-4.0, 381), (3.0, 382), (-3.0, 383),
+        (4.0, 384), (-2.0, 385), (5.0, 386), (-1.0, 387), (6.0, 388), (0.0, 389), (null, 390), (1.0, 391),
+        (-5.0, 392), (2.0, 393), (-4.0, 394), (3.0, 395), (-3.0, 396), (4.0, 397), (-2.0, 398), (5.0, 399),
+        (null, 400), (6.0, 401), (0.0, 402), (-6.0, 403), (1.0, 404), (-5.0, 405), (2.0, 406), (-4.0, 407),
+        (3.0, 408), (-3.0, 409), (null, 410), (-2.0, 411), (5.0, 412), (-1.0, 413), (6.0, 414), (0.0, 415),
+        (-6.0, 416), (1.0, 417), (-5.0, 418), (2.0, 419), (null, 420), (3.0, 421), (-3.0, 422), (4.0, 423),
+        (-2.0, 424), (5.0, 425), (-1.0, 426), (6.0, 427), (0.0, 428), (-6.0, 429), (null, 430), (-5.0, 431),
+        (2.0, 432), (-4.0, 433), (3.0, 434), (-3.0, 435), (4.0, 436), (-2.0, 437), (5.0, 438), (-1.0, 439),
+        (null, 440), (0.0, 441), (-6.0, 442), (1.0, 443), (-5.0, 444), (2.0, 445), (-4.0, 446), (3.0, 447),
+        (-3.0, 448), (4.0, 449), (null, 450), (5.0, 451), (-1.0, 452), (6.0, 453), (0.0, 454), (-6.0, 455),
+        (1.0, 456), (-5.0, 457), (2.0, 458), (-4.0, 459), (null, 460), (-3.0, 461), (4.0, 462), (-2.0, 463),
+        (5.0, 464), (-1.0, 465), (6.0, 466), (0.0, 467), (-6.0, 468), (1.0, 469), (null, 470), (2.0, 471),
+        (-4.0, 472), (3.0, 473), (-3.0, 474), (4.0, 475), (-2.0, 476), (5.0, 477), (-1.0, 478), (6.0, 479),
+        (null, 480), (-6.0, 481), (1.0, 482), (-5.0, 483), (2.0, 484), (-4.0, 485), (3.0, 486), (-3.0, 487),
+        (4.0, 488), (-2.0, 489), (null, 490), (-1.0, 491), (6.0, 492), (0.0, 493), (-6.0, 494), (1.0, 495),
+        (-5.0, 496), (2.0, 497), (-4.0, 498), (3.0, 499), (null, 500), (4.0, 501), (-2.0, 502), (5.0, 503),
+        (-1.0, 504), (6.0, 505), (0.0, 506), (-6.0, 507), (1.0, 508), (-5.0, 509), (null, 510), (-4.0, 511),
+        (3.0, 512), (-3.0, 513), (4.0, 514), (-2.0, 515), (5.0, 516), (-1.0, 517), (6.0, 518), (0.0, 519),
+        (null, 520), (1.0, 521), (-5.0, 522), (2.0, 523), (-4.0, 524), (3.0, 525), (-3.0, 526), (4.0, 527),
+        (-2.0, 528), (5.0, 529), (null, 530), (6.0, 531), (0.0, 532), (-6.0, 533), (1.0, 534), (-5.0, 535),
+        (2.0, 536), (-4.0, 537), (3.0, 538), (-3.0, 539), (null, 540), (-2.0, 541), (5.0, 542), (-1.0, 543),
+        (6.0, 544), (0.0, 545), (-6.0, 546), (1.0, 547), (-5.0, 548), (2.0, 549), (null, 550), (3.0, 551),
+        (-3.0, 552), (4.0, 553), (-2.0, 554), (5.0, 555), (-1.0, 556), (6.0, 557), (0.0, 558), (-6.0, 559),
+        (null, 560), (-5.0, 561), (2.0, 562), (-4.0, 563), (3.0, 564), (-3.0, 565), (4.0, 566), (-2.0, 567),
+        (5.0, 568), (-1.0, 569), (null, 570), (0.0, 571), (-6.0, 572), (1.0, 573), (-5.0, 574), (2.0, 575),
+        (-4.0, 576), (3.0, 577), (-3.0, 578), (4.0, 579), (null, 580), (5.0, 581), (-1.0, 582), (6.0, 583),
+        (0.0, 584), (-6.0, 585), (1.0, 586), (-5.0, 587), (2.0, 588), (-4.0, 589), (null, 590), (-3.0, 591),
+        (4.0, 592), (-2.0, 593), (5.0, 594), (-1.0, 595), (6.0, 596), (0.0, 597), (-6.0, 598), (1.0, 599),
+        (null, 600), (2.0, 601), (-4.0, 602), (3.0, 603), (-3.0, 604), (4.0, 605), (-2.0, 606), (5.0, 607),
+        (-1.0, 608), (6.0, 609), (null, 610), (-6.0, 611), (1.0, 612), (-5.0, 613), (2.0, 614), (-4.0, 615),
+        (3.0, 616), (-3.0, 617), (4.0, 618), (-2.0, 619), (null, 620), (-1.0, 621), (6.0, 622), (0.0, 623),
+        (-6.0, 624), (1.0, 625), (-5.0, 626), (2.0, 627), (-4.0, 628), (3.0, 629), (null, 630), (4.0, 631),
+        (-2.0, 632), (5.0, 633), (-1.0, 634), (6.0, 635), (0.0, 636), (-6.0, 637), (1.0, 638), (-5.0, 639),
+        (null, 640), (-4.0, 641), (3.0, 642), (-3.0, 643), (4.0, 644), (-2.0, 645), (5.0, 646), (-1.0, 647),
+        (6.0, 648), (0.0, 649), (null, 650), (1.0, 651), (-5.0, 652), (2.0, 653), (-4.0, 654), (3.0, 655),
+        (-3.0, 656), (4.0, 657), (-2.0, 658), (5.0, 659), (null, 660), (6.0, 661), (0.0, 662), (-6.0, 663),
+        (1.0, 664), (-5.0, 665), (2.0, 666), (-4.0, 667), (3.0, 668), (-3.0, 669), (null, 670), (-2.0, 671),
+        (5.0, 672), (-1.0, 673), (6.0, 674), (0.0, 675), (-6.0, 676), (1.0, 677), (-5.0, 678), (2.0, 679),
+        (null, 680), (3.0, 681), (-3.0, 682), (4.0, 683), (-2.0, 684), (5.0, 685), (-1.0, 686), (6.0, 687),
+        (0.0, 688), (-6.0, 689), (null, 690), (-5.0, 691), (2.0, 692), (-4.0, 693), (3.0, 694), (-3.0, 695),
+        (4.0, 696), (-2.0, 697), (5.0, 698), (-1.0, 699), (null, 700), (0.0, 701), (-6.0, 702), (1.0, 703),
+        (-5.0, 704), (2.0, 705), (-4.0, 706), (3.0, 707), (-3.0, 708), (4.0, 709), (null, 710), (5.0, 711),
+        (-1.0, 712), (6.0, 713), (0.0, 714), (-6.0, 715), (1.0, 716), (-5.0, 717), (2.0, 718), (-4.0, 719),
+        (null, 720), (-3.0, 721), (4.0, 722), (-2.0, 723), (5.0, 724), (-1.0, 725), (6.0, 726), (0.0, 727),
+        (-6.0, 728), (1.0, 729), (null, 730), (2.0, 731), (-4.0, 732), (3.0, 733), (-3.0, 734), (4.0, 735),
+        (-2.0, 736), (5.0, 737), (-1.0, 738), (6.0, 739), (null, 740), (-6.0, 741), (1.0, 742), (-5.0, 743),
+        (2.0, 744), (-4.0, 745), (3.0, 746), (-3.0, 747), (4.0, 748), (-2.0, 749), (null, 750), (-1.0, 751),
+        (6.0, 752), (0.0, 753), (-6.0, 754), (1.0, 755), (-5.0, 756), (2.0, 757), (-4.0, 758), (3.0, 759),
+        (null, 760), (4.0, 761), (-2.0, 762), (5.0, 763), (-1.0, 764), (6.0, 765), (0.0, 766), (-6.0, 767),
+        (1.0, 768), (-5.0, 769), (null, 770), (-4.0, 771), (3.0, 772), (-3.0, 773), (4.0, 774), (-2.0, 775),
+        (5.0, 776), (-1.0, 777), (6.0, 778), (0.0, 779), (null, 780), (1.0, 781), (-5.0, 782), (2.0, 783),
+        (-4.0, 784), (3.0, 785), (-3.0, 786), (4.0, 787), (-2.0, 788), (5.0, 789), (null, 790), (6.0, 791),
+        (0.0, 792), (-6.0, 793), (1.0, 794), (-5.0, 795), (2.0, 796), (-4.0, 797), (3.0, 798), (-3.0, 799),
+        (null, 800), (-2.0, 801), (5.0, 802), (-1.0, 803), (6.0, 804), (0.0, 805), (-6.0, 806), (1.0, 807),
+        (-5.0, 808), (2.0, 809), (null, 810), (3.0, 811), (-3.0, 812), (4.0, 813), (-2.0, 814), (5.0, 815),
+        (-1.0, 816), (6.0, 817), (0.0, 818), (-6.0, 819), (null, 820), (-5.0, 821), (2.0, 822), (-4.0, 823),
+        (3.0, 824), (-3.0, 825), (4.0, 826), (-2.0, 827), (5.0, 828), (-1.0, 829), (null, 830), (0.0, 831),
+        (-6.0, 832), (1.0, 833), (-5.0, 834), (2.0, 835), (-4.0, 836), (3.0, 837), (-3.0, 838), (4.0, 839),
+        (null, 840), (5.0, 841), (-1.0, 842), (6.0, 843), (0.0, 844), (-6.0, 845), (1.0, 846), (-5.0, 847),
+        (2.0, 848), (-4.0, 849), (null, 850), (-3.0, 851), (4.0, 852), (-2.0, 853), (5.0, 854), (-1.0, 855),
+        (6.0, 856), (0.0, 857), (-6.0, 858), (1.0, 859), (null, 860), (2.0, 861), (-4.0, 862), (3.0, 863),
+        (-3.0, 864), (4.0, 865), (-2.0, 866), (5.0, 867), (-1.0, 868), (6.0, 869), (null, 870), (-6.0, 871),
+        (1.0, 872), (-5.0, 873), (2.0, 874), (-4.0, 875), (3.0, 876), (-3.0, 877), (4.0, 878), (-2.0, 879),
+        (null, 880), (-1.0, 881), (6.0, 882), (0.0, 883), (-6.0, 884), (1.0, 885), (-5.0, 886), (2.0, 887),
+        (-4.0, 888), (3.0, 889), (null, 890), (4.0, 891), (-2.0, 892), (5.0, 893), (-1.0, 894), (6.0, 895),
+        (0.0, 896), (-6.0, 897), (1.0, 898), (-5.0, 899), (null, 900), (-4.0, 901), (3.0, 902), (-3.0, 903),
+        (4.0, 904), (-2.0, 905), (5.0, 906), (-1.0, 907), (6.0, 908), (0.0, 909), (null, 910), (1.0, 911),
+        (-5.0, 912), (2.0, 913), (-4.0, 914), (3.0, 915), (-3.0, 916), (4.0, 917), (-2.0, 918), (5.0, 919),
+        (null, 920), (6.0, 921), (0.0, 922), (-6.0, 923), (1.0, 924), (-5.0, 925), (2.0, 926), (-4.0, 927),
+        (3.0, 928), (-3.0, 929), (null, 930), (-2.0, 931), (5.0, 932), (-1.0, 933), (6.0, 934), (0.0, 935),
+        (-6.0, 936), (1.0, 937), (-5.0, 938), (2.0, 939), (null, 940), (3.0, 941), (-3.0, 942), (4.0, 943),
+        (-2.0, 944), (5.0, 945), (-1.0, 946), (6.0, 947), (0.0, 948), (-6.0, 949), (null, 950), (-5.0, 951),
+        (2.0, 952), (-4.0, 953), (3.0, 954), (-3.0, 955), (4.0, 956), (-2.0, 957), (5.0, 958), (-1.0, 959),
+        (null, 960), (0.0, 961), (-6.0, 962), (1.0, 963), (-5.0, 964), (2.0, 965), (-4.0, 966), (3.0, 967),
+        (-3.0, 968), (4.0, 969), (null, 970), (5.0, 971), (-1.0, 972), (6.0, 973), (0.0, 974), (-6.0, 975),
+        (1.0, 976), (-5.0, 977), (2.0, 978), (-4.0, 979), (null, 980), (-3.0, 981), (4.0, 982), (-2.0, 983),
+        (5.0, 984), (-1.0, 985), (6.0, 986), (0.0, 987), (-6.0, 988), (1.0, 989), (null, 990), (2.0, 991),
+        (-4.0, 992), (3.0, 993), (-3.0, 994), (4.0, 995), (-2.0, 996), (5.0, 997), (-1.0, 998), (6.0, 999),
+        (null, 1000), (-6.0, 1001), (1.0, 1002), (-5.0, 1003), (2.0, 1004), (-4.0, 1005), (3.0, 1006), (-3.0, 1007),
+        (4.0, 1008), (-2.0, 1009), (null, 1010), (-1.0, 1011), (6.0, 1012), (0.0, 1013), (-6.0, 1014), (1.0, 1015),
+        (-5.0, 1016), (2.0, 1017), (-4.0, 1018), (3.0, 1019), (null, 1020), (4.0, 1021), (-2.0, 1022), (99.5, 1023),
+        (99.5, 1024), (99.5, 1025), (0.0, 1026), (-6.0, 1027), (1.0, 1028), (-5.0, 1029), (null, 1030), (-4.0, 1031),
+        (3.0, 1032), (-3.0, 1033), (4.0, 1034), (-2.0, 1035), (5.0, 1036), (-1.0, 1037), (6.0, 1038), (0.0, 1039),
+        (null, 1040), (1.0, 1041), (-5.0, 1042), (2.0, 1043), (-4.0, 1044), (3.0, 1045), (-3.0, 1046), (4.0, 1047),
+        (-2.0, 1048), (5.0, 1049), (null, 1050), (6.0, 1051), (0.0, 1052), (-6.0, 1053), (1.0, 1054), (-5.0, 1055),
+        (2.0, 1056), (-4.0, 1057), (3.0, 1058), (-3.0, 1059), (null, 1060), (-2.0, 1061), (5.0, 1062), (-1.0, 1063),
+        (6.0, 1064), (0.0, 1065), (-6.0, 1066), (1.0, 1067), (-5.0, 1068), (2.0, 1069), (null, 1070), (3.0, 1071),
+        (-3.0, 1072), (4.0, 1073), (-2.0, 1074), (5.0, 1075), (-1.0, 1076), (6.0, 1077), (0.0, 1078), (-6.0, 1079),
+        (null, 1080), (-5.0, 1081), (2.0, 1082), (-4.0, 1083), (3.0, 1084), (-3.0, 1085), (4.0, 1086), (-2.0, 1087),
+        (5.0, 1088), (-1.0, 1089), (null, 1090), (0.0, 1091), (-6.0, 1092), (1.0, 1093), (-5.0, 1094), (2.0, 1095),
+        (-4.0, 1096), (3.0, 1097), (-3.0, 1098), (4.0, 1099), (null, 1100), (5.0, 1101), (-1.0, 1102), (6.0, 1103),
+        (0.0, 1104), (-6.0, 1105), (1.0, 1106), (-5.0, 1107), (2.0, 1108), (-4.0, 1109), (null, 1110), (-3.0, 1111),
+        (4.0, 1112), (-2.0, 1113), (5.0, 1114), (-1.0, 1115), (6.0, 1116), (0.0, 1117), (-6.0, 1118), (1.0, 1119),
+        (null, 1120), (2.0, 1121), (-4.0, 1122), (3.0, 1123), (-3.0, 1124), (4.0, 1125), (-2.0, 1126), (5.0, 1127),
+        (-1.0, 1128), (6.0, 1129), (null, 1130), (-6.0, 1131), (1.0, 1132), (-5.0, 1133), (2.0, 1134), (-4.0, 1135),
+        (3.0, 1136), (-3.0, 1137), (4.0, 1138), (-2.0, 1139), (null, 1140), (-1.0, 1141), (6.0, 1142), (0.0, 1143),
+        (-6.0, 1144), (1.0, 1145), (-5.0, 1146), (2.0, 1147), (-4.0, 1148), (3.0, 1149), (null, 1150), (4.0, 1151),
+        (-2.0, 1152), (5.0, 1153), (-1.0, 1154), (6.0, 1155), (0.0, 1156), (-6.0, 1157), (1.0, 1158), (-5.0, 1159),
+        (null, 1160), (-4.0, 1161), (3.0, 1162), (-3.0, 1163), (4.0, 1164), (-2.0, 1165), (5.0, 1166), (-1.0, 1167),
+        (6.0, 1168), (0.0, 1169), (null, 1170), (1.0, 1171), (-5.0, 1172), (2.0, 1173), (-4.0, 1174), (3.0, 1175),
+        (-3.0, 1176), (4.0, 1177), (-2.0, 1178), (5.0, 1179), (null, 1180), (6.0, 1181), (0.0, 1182), (-6.0, 1183),
+        (1.0, 1184), (-5.0, 1185), (2.0, 1186), (-4.0, 1187), (3.0, 1188), (-3.0, 1189), (null, 1190), (-2.0, 1191),
+        (5.0, 1192), (-1.0, 1193), (6.0, 1194), (0.0, 1195), (-6.0, 1196), (1.0, 1197), (-5.0, 1198), (99.5, 1199);
+
+select id, reading from readings where reading > 50.0;
+select id from readings where reading is null and id > 980 and id <= 1060;
+select id, reading from readings where id < 1100 and reading <= -6.0 and id > 990;
+select id, reading from readings where reading = 6.0 and id > 1050;
+select id, reading from readings where id >= 1020 and id < 1030 and reading is not null;
+close sol;
+drop database sol;
+exit;